@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Compares decode into std containers against pmr containers backed by a request
+// scoped monotonic arena, for arraytest and maptest schemas.
+// Usage: AllocatorBenchmark [iterations]
+
+#include <rohit/serializer.h>
+#include <iostream>
+#include <string>
+#include "benchmark.h"
+
+// Generated headers declare same namespace, each variant is wrapped in its own namespace
+namespace stdbench {
+#include <array_std.h>
+#include <map_std.h>
+} // namespace stdbench
+
+namespace pmrbench {
+#include <array_pmr.h>
+#include <map_pmr.h>
+} // namespace pmrbench
+
+template <typename PersonIndex>
+void FillPersonIndex(PersonIndex &personindex) {
+    for(uint64_t personIndex { 0 }; personIndex < 512; ++personIndex) {
+        const std::string name { "Person number " + std::to_string(personIndex) + " with a long name" };
+        personindex.byName.emplace(name, personIndex);
+        auto &person = personindex.byId[personIndex];
+        person.name = name;
+        person.ID = personIndex;
+    }
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol, typename StdType, typename PmrType>
+void Compare(const std::string_view name, const StdType &source, const size_t iterations) {
+    rohit::FullStreamAutoAlloc fullstream { 4096 };
+    source.template SerializeOut<SerializerProtocol>(fullstream);
+    std::cout << name << " (" << fullstream.CurrentOffset() << " bytes)" << std::endl;
+
+    Measure("std", iterations, [&fullstream]() {
+        fullstream.Reset();
+        StdType decoded { };
+        decoded.template SerializeIn<SerializerProtocol>(fullstream);
+    });
+    std::cout << std::endl;
+
+    // Arena is released once per request instead of freeing each node
+    std::vector<std::byte> buffer(1024 * 1024);
+    Measure("pmr arena", iterations, [&fullstream, &buffer]() {
+        fullstream.Reset();
+        std::pmr::monotonic_buffer_resource arena { buffer.data(), buffer.size() };
+        PmrType decoded { &arena };
+        decoded.template SerializeIn<SerializerProtocol>(fullstream);
+    });
+    std::cout << std::endl;
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t iterations { argc > 1 ? std::stoul(argv[1]) : 1000 };
+
+    stdbench::arraytest::sessionstore sessionstore { };
+    FillSessionStore(sessionstore);
+    stdbench::maptest::personindex personindex { };
+    FillPersonIndex(personindex);
+    stdbench::maptest::personlist personlist { };
+    personlist.list.insert(personindex.byId.begin(), personindex.byId.end());
+
+    Compare<rohit::serializer::binary_integer, stdbench::arraytest::sessionstore, pmrbench::arraytest::sessionstore>("arraytest::sessionstore binary_integer", sessionstore, iterations);
+    Compare<rohit::serializer::json, stdbench::arraytest::sessionstore, pmrbench::arraytest::sessionstore>("arraytest::sessionstore json", sessionstore, iterations);
+    Compare<rohit::serializer::binary_integer, stdbench::maptest::personlist, pmrbench::maptest::personlist>("maptest::personlist binary_integer", personlist, iterations);
+    Compare<rohit::serializer::json, stdbench::maptest::personlist, pmrbench::maptest::personlist>("maptest::personlist json", personlist, iterations);
+    Compare<rohit::serializer::binary_integer, stdbench::maptest::personindex, pmrbench::maptest::personindex>("maptest::personindex binary_integer", personindex, iterations);
+    Compare<rohit::serializer::json, stdbench::maptest::personindex, pmrbench::maptest::personindex>("maptest::personindex json", personindex, iterations);
+
+    return 0;
+}
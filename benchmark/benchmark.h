@@ -0,0 +1,55 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Session store filled by benchmarks and timing of one operation, shared by benchmarks.
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// Session store of std or pmr variant of arraytest schema with 32 persons in each session
+template <typename SessionStore>
+void FillSessionStore(SessionStore &sessionstore, const uint64_t sessionCount = 16) {
+    sessionstore.name = "Benchmark session store with a long name";
+    for(uint64_t sessionIndex { 0 }; sessionIndex < sessionCount; ++sessionIndex) {
+        auto &session = sessionstore.sessionlist.emplace_back();
+        session.name = "Session number " + std::to_string(sessionIndex) + " with a long name";
+        session.id = sessionIndex;
+        session.persons.listid = sessionIndex;
+        for(uint32_t personIndex { 0 }; personIndex < 32; ++personIndex) {
+            auto &person = session.persons.list.emplace_back();
+            person.name = "Person number " + std::to_string(personIndex) + " with a long name";
+            person.ID = personIndex;
+            session.persons.reverseListMap.emplace(personIndex, personIndex + 1);
+        }
+    }
+}
+
+// Runs function once to warm up, prints average time of iterations without newline and returns it
+template <typename Function>
+int64_t Measure(const std::string_view name, const size_t iterations, Function function) {
+    function();
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t iteration { 0 }; iteration < iterations; ++iteration) function();
+    const auto duration = std::chrono::steady_clock::now() - start;
+    const auto nsPerOp = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / static_cast<int64_t>(iterations);
+    std::cout << "  " << name << ": " << nsPerOp << " ns/op";
+    return nsPerOp;
+}
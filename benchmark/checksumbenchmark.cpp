@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// CRC32C instruction against table, and binary encode and decode of
+// arraytest::sessionstore with and without checksumming stream.
+// Usage: ChecksumBenchmark [iterations]
+
+#include <rohit/checksum.h>
+#include <array_std.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+
+int main(const int argc, const char *argv[]) {
+    const size_t iterations { argc > 1 ? std::stoul(argv[1]) : 1000 };
+    std::cout << "crc32 instruction: " << (rohit::crc32c::HasHardware() ? "yes" : "no") << std::endl;
+
+    std::vector<uint8_t> buffer(1 << 20);
+    for(size_t index { 0 }; index < buffer.size(); ++index) buffer[index] = static_cast<uint8_t>(index * 131);
+    std::cout << "1 MiB CRC32C" << std::endl;
+    volatile uint32_t sink { 0 };
+    Measure("Crc32c", iterations, [&buffer, &sink]() { sink = rohit::Crc32c(buffer.data(), buffer.size()); });
+    std::cout << std::endl;
+    Measure("Crc32cTable", iterations, [&buffer, &sink]() { sink = rohit::Crc32cTable(buffer.data(), buffer.size()); });
+    std::cout << std::endl;
+
+    arraytest::sessionstore sessionstore { };
+    FillSessionStore(sessionstore);
+    rohit::FullStreamAutoAlloc plainStream { 4096 };
+    rohit::ChecksumOutStream checksumStream { 4096 };
+    sessionstore.SerializeOut<rohit::serializer::binary_integer>(checksumStream);
+    checksumStream.AppendChecksum();
+    std::cout << "arraytest::sessionstore binary_integer (" << checksumStream.CurrentOffset() << " bytes)" << std::endl;
+
+    Measure("encode", iterations, [&plainStream, &sessionstore]() {
+        plainStream.Reset();
+        sessionstore.SerializeOut<rohit::serializer::binary_integer>(plainStream);
+    });
+    std::cout << std::endl;
+    Measure("encode then Crc32c", iterations, [&plainStream, &sessionstore, &sink]() {
+        plainStream.Reset();
+        sessionstore.SerializeOut<rohit::serializer::binary_integer>(plainStream);
+        sink = rohit::Crc32c(plainStream.begin(), plainStream.CurrentOffset());
+    });
+    std::cout << std::endl;
+    Measure("encode ChecksumOutStream", iterations, [&checksumStream, &sessionstore]() {
+        checksumStream.Reset();
+        sessionstore.SerializeOut<rohit::serializer::binary_integer>(checksumStream);
+        checksumStream.AppendChecksum();
+    });
+    std::cout << std::endl;
+
+    Measure("decode", iterations, [&checksumStream]() {
+        const auto inStream = rohit::MakeConstantFullStream(checksumStream.begin(), checksumStream.CurrentOffset());
+        arraytest::sessionstore decoded { };
+        decoded.SerializeIn<rohit::serializer::binary_integer>(inStream);
+    });
+    std::cout << std::endl;
+    Measure("decode ChecksumInStream", iterations, [&checksumStream]() {
+        const rohit::ChecksumInStream inStream { checksumStream.begin(), checksumStream.CurrentOffset() };
+        arraytest::sessionstore decoded { };
+        decoded.SerializeIn<rohit::serializer::binary_integer>(inStream);
+        if (!inStream.VerifyChecksum()) std::cout << "checksum mismatch" << std::endl;
+    });
+    std::cout << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Binary encode and decode of arraytest::sessionstore with and without
+// compression stage, and compression ratio.
+// Usage: CompressionBenchmark [iterations] [session count]
+
+#include <rohit/compression.h>
+#include <array_std.h>
+#include <iostream>
+#include <string>
+#include "benchmark.h"
+
+int main(const int argc, const char *argv[]) {
+    const size_t iterations { argc > 1 ? std::stoul(argv[1]) : 100 };
+    const uint64_t sessionCount { argc > 2 ? std::stoul(argv[2]) : 256 };
+
+    arraytest::sessionstore sessionstore { };
+    FillSessionStore(sessionstore, sessionCount);
+    rohit::FullStreamAutoAlloc plainStream { 4096 };
+    sessionstore.SerializeOut<rohit::serializer::binary_integer>(plainStream);
+    rohit::FullStreamAutoAlloc compressedStream { 4096 };
+    {
+        rohit::CompressOutStream compressStream { compressedStream };
+        sessionstore.SerializeOut<rohit::serializer::binary_integer>(compressStream);
+        compressStream.Finish();
+    }
+    std::cout << "arraytest::sessionstore binary_integer (" << plainStream.CurrentOffset() << " bytes, compressed "
+        << compressedStream.CurrentOffset() << " bytes, ratio " << static_cast<double>(plainStream.CurrentOffset()) / static_cast<double>(compressedStream.CurrentOffset())
+        << ")" << std::endl;
+
+    Measure("encode", iterations, [&plainStream, &sessionstore]() {
+        plainStream.Reset();
+        sessionstore.SerializeOut<rohit::serializer::binary_integer>(plainStream);
+    });
+    std::cout << std::endl;
+    Measure("encode CompressOutStream", iterations, [&compressedStream, &sessionstore]() {
+        compressedStream.Reset();
+        rohit::CompressOutStream compressStream { compressedStream };
+        sessionstore.SerializeOut<rohit::serializer::binary_integer>(compressStream);
+        compressStream.Finish();
+    });
+    std::cout << std::endl;
+
+    Measure("decode", iterations, [&plainStream]() {
+        const auto inStream = rohit::MakeConstantFullStream(plainStream.begin(), plainStream.CurrentOffset());
+        arraytest::sessionstore decoded { };
+        decoded.SerializeIn<rohit::serializer::binary_integer>(inStream);
+    });
+    std::cout << std::endl;
+    Measure("decode DecompressInStream", iterations, [&compressedStream]() {
+        const auto source = rohit::MakeConstantFullStream(compressedStream.begin(), compressedStream.CurrentOffset());
+        rohit::DecompressInStream inStream { source };
+        inStream.ReadAll();
+        arraytest::sessionstore decoded { };
+        decoded.SerializeIn<rohit::serializer::binary_integer>(inStream);
+    });
+    std::cout << std::endl;
+
+    return 0;
+}
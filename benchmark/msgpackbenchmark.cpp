@@ -0,0 +1,60 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Encode and decode of arraytest::sessionstore with MessagePack against json
+// and binary protocols, and size of each encoding.
+// Usage: MsgpackBenchmark [iterations] [session count]
+
+#include <rohit/msgpack.h>
+#include <array_std.h>
+#include <iostream>
+#include <string>
+#include "benchmark.h"
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void MeasureProtocol(const std::string_view name, const size_t iterations, const arraytest::sessionstore &sessionstore) {
+    rohit::FullStreamAutoAlloc fullstream { 4096 };
+    sessionstore.SerializeOut<SerializerProtocol>(fullstream);
+    std::cout << name << " (" << fullstream.CurrentOffset() << " bytes)" << std::endl;
+
+    Measure("encode", iterations, [&fullstream, &sessionstore]() {
+        fullstream.Reset();
+        sessionstore.SerializeOut<SerializerProtocol>(fullstream);
+    });
+    std::cout << std::endl;
+    Measure("decode", iterations, [&fullstream]() {
+        const auto inStream = rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset());
+        arraytest::sessionstore decoded { };
+        decoded.SerializeIn<SerializerProtocol>(inStream);
+    });
+    std::cout << std::endl;
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t iterations { argc > 1 ? std::stoul(argv[1]) : 100 };
+    const uint64_t sessionCount { argc > 2 ? std::stoul(argv[2]) : 256 };
+
+    arraytest::sessionstore sessionstore { };
+    FillSessionStore(sessionstore, sessionCount);
+
+    MeasureProtocol<rohit::serializer::msgpack>("msgpack", iterations, sessionstore);
+    MeasureProtocol<rohit::serializer::json>("json", iterations, sessionstore);
+    MeasureProtocol<rohit::serializer::binary_integer>("binary_integer", iterations, sessionstore);
+    MeasureProtocol<rohit::serializer::binary_string>("binary_string", iterations, sessionstore);
+
+    return 0;
+}
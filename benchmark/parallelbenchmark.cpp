@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Sequential SerializeOut against SerializeOutParallelList, and sequential
+// SerializeIn against indexed SerializeInParallelList, of a large
+// arraytest::personlist with increasing thread count.
+// Usage: ParallelBenchmark [iterations] [list size] [chunk size]
+
+#include <rohit/parallel.h>
+#include <array_std.h>
+#include <iostream>
+#include <string>
+#include "benchmark.h"
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void Compare(const std::string_view name, const arraytest::personlist &personlist, const size_t iterations, const size_t chunkSize) {
+    rohit::FullStreamAutoAlloc outstream { 4096 };
+    personlist.SerializeOut<SerializerProtocol>(outstream);
+    std::cout << name << " (" << outstream.CurrentOffset() << " bytes)" << std::endl;
+
+    const auto sequential = Measure("sequential", iterations, [&outstream, &personlist]() {
+        outstream.Reset();
+        personlist.SerializeOut<SerializerProtocol>(outstream);
+    });
+    std::cout << std::endl;
+
+    for(const size_t threadCount: { 1, 2, 4, 8, 16, 32 }) {
+        rohit::ThreadPool pool { threadCount };
+        const auto parallel = Measure(std::to_string(threadCount) + " threads", iterations, [&outstream, &personlist, &pool, chunkSize]() {
+            outstream.Reset();
+            personlist.SerializeOutParallelList<SerializerProtocol>(outstream, pool, chunkSize);
+        });
+        std::cout << " (" << static_cast<double>(sequential) / static_cast<double>(parallel) << "x)" << std::endl;
+    }
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void CompareDecode(const std::string_view name, const arraytest::personlist &personlist, const size_t iterations, const uint32_t interval) {
+    rohit::FullStreamAutoAlloc fullstream { 4096 };
+    rohit::serializer::ListIndex index { interval };
+    personlist.SerializeOutIndexedList<SerializerProtocol>(fullstream, index);
+    const auto inStream = rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset());
+    std::cout << name << " decode (" << index.offsets.size() * sizeof(uint64_t) << " bytes index)" << std::endl;
+
+    const auto sequential = Measure("sequential", iterations, [&inStream]() {
+        inStream.Reset();
+        arraytest::personlist decoded { };
+        decoded.SerializeIn<SerializerProtocol>(inStream);
+    });
+    std::cout << std::endl;
+
+    for(const size_t threadCount: { 1, 2, 4, 8, 16, 32 }) {
+        rohit::ThreadPool pool { threadCount };
+        const auto parallel = Measure(std::to_string(threadCount) + " threads", iterations, [&inStream, &index, &pool]() {
+            inStream.Reset();
+            arraytest::personlist decoded { };
+            decoded.SerializeInParallelList<SerializerProtocol>(inStream, index, pool);
+        });
+        std::cout << " (" << static_cast<double>(sequential) / static_cast<double>(parallel) << "x)" << std::endl;
+    }
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t iterations { argc > 1 ? std::stoul(argv[1]) : 20 };
+    const size_t listSize { argc > 2 ? std::stoul(argv[2]) : 1000000 };
+    const size_t chunkSize { argc > 3 ? std::stoul(argv[3]) : 4096 };
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    arraytest::personlist personlist { };
+    personlist.listid = 1;
+    for(uint64_t index { 0 }; index < listSize; ++index) {
+        personlist.list.push_back({ "Person number " + std::to_string(index) + " with a long name", index });
+    }
+
+    Compare<rohit::serializer::binary_integer>("arraytest::personlist binary_integer", personlist, iterations, chunkSize);
+    Compare<rohit::serializer::json>("arraytest::personlist json", personlist, iterations, chunkSize);
+    CompareDecode<rohit::serializer::binary_integer>("arraytest::personlist binary_integer", personlist, iterations, static_cast<uint32_t>(chunkSize));
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Compares generated code against runtime schema loaded from .def for
+// arraytest::sessionstore, encode and decode.
+// Usage: RuntimeBenchmark [iterations]
+
+#include <rohit/serializerruntime.h>
+#include <array_std.h>
+#include <iostream>
+#include <string>
+#include "benchmark.h"
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void Compare(const std::string_view name, const rohit::serializer::Runtime::Schema &schema, const arraytest::sessionstore &source, const size_t iterations) {
+    const auto classIndex = schema.FindClass("arraytest::sessionstore");
+    rohit::FullStreamAutoAlloc fullstream { 4096 };
+    source.SerializeOut<SerializerProtocol>(fullstream);
+    std::cout << name << " (" << fullstream.CurrentOffset() << " bytes)" << std::endl;
+    const auto value = schema.SerializeIn<SerializerProtocol>(classIndex, rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset()));
+
+    rohit::FullStreamAutoAlloc outstream { 4096 };
+    Measure("generated encode", iterations, [&outstream, &source]() {
+        outstream.Reset();
+        source.SerializeOut<SerializerProtocol>(outstream);
+    });
+    std::cout << std::endl;
+    Measure("runtime encode", iterations, [&outstream, &schema, classIndex, &value]() {
+        outstream.Reset();
+        schema.SerializeOut<SerializerProtocol>(classIndex, value, outstream);
+    });
+    std::cout << std::endl;
+
+    Measure("generated decode", iterations, [&fullstream]() {
+        fullstream.Reset();
+        arraytest::sessionstore decoded { };
+        decoded.SerializeIn<SerializerProtocol>(fullstream);
+    });
+    std::cout << std::endl;
+    Measure("runtime decode", iterations, [&fullstream, &schema, classIndex]() {
+        fullstream.Reset();
+        const auto decoded = schema.SerializeIn<SerializerProtocol>(classIndex, fullstream);
+    });
+    std::cout << std::endl;
+}
+
+int main(const int argc, const char *argv[]) {
+    const size_t iterations { argc > 1 ? std::stoul(argv[1]) : 1000 };
+
+    auto inStream = rohit::MakeStreamFromFile(RUNTIME_SCHEMA_FILE);
+    const rohit::serializer::Runtime::Schema schema { rohit::serializer::Parser::Parse(inStream) };
+
+    arraytest::sessionstore sessionstore { };
+    FillSessionStore(sessionstore);
+
+    Compare<rohit::serializer::binary_integer>("arraytest::sessionstore binary_integer", schema, sessionstore, iterations);
+    Compare<rohit::serializer::json>("arraytest::sessionstore json", schema, sessionstore, iterations);
+
+    return 0;
+}
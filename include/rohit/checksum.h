@@ -0,0 +1,228 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <rohit/stream.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define ROHIT_CRC32C_SSE42 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define ROHIT_CRC32C_ARM 1
+#endif
+
+namespace rohit {
+
+namespace crc32c {
+// Castagnoli polynomial, reflected
+constexpr uint32_t polynomial { 0x82f63b78 };
+
+// Table k gives crc of byte followed by k zero bytes, 8 bytes are folded per step
+constexpr std::array<std::array<uint32_t, 256>, 8> MakeTable() {
+    std::array<std::array<uint32_t, 256>, 8> table { };
+    for(uint32_t index { 0 }; index < 256; ++index) {
+        uint32_t crc { index };
+        for(int bit { 0 }; bit < 8; ++bit) crc = (crc >> 1) ^ (crc & 1 ? polynomial : 0);
+        table[0][index] = crc;
+    }
+    for(uint32_t index { 0 }; index < 256; ++index) {
+        for(size_t slice { 1 }; slice < 8; ++slice) {
+            table[slice][index] = (table[slice - 1][index] >> 8) ^ table[0][table[slice - 1][index] & 0xff];
+        }
+    }
+    return table;
+}
+
+inline constexpr std::array<std::array<uint32_t, 256>, 8> table { MakeTable() };
+
+constexpr uint32_t UpdateTable(uint32_t value, const uint8_t *data, size_t size) {
+    if (!std::is_constant_evaluated()) {
+        while(size >= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            if constexpr (std::endian::native == std::endian::big) word = byteswap(word);
+            const uint64_t mixed { word ^ value };
+            value = table[7][mixed & 0xff] ^ table[6][(mixed >> 8) & 0xff] ^ table[5][(mixed >> 16) & 0xff] ^ table[4][(mixed >> 24) & 0xff]
+                ^ table[3][(mixed >> 32) & 0xff] ^ table[2][(mixed >> 40) & 0xff] ^ table[1][(mixed >> 48) & 0xff] ^ table[0][mixed >> 56];
+            data += 8;
+            size -= 8;
+        }
+    }
+    for(size_t index { 0 }; index < size; ++index) value = (value >> 8) ^ table[0][(value ^ data[index]) & 0xff];
+    return value;
+}
+
+#if ROHIT_CRC32C_SSE42
+// Compiled for SSE4.2 without compiling whole program for it, used only when cpu has it
+__attribute__((target("sse4.2"))) inline uint32_t UpdateHardware(uint32_t value, const uint8_t *data, size_t size) {
+#if defined(__x86_64__)
+    uint64_t value64 { value };
+    while(size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        value64 = _mm_crc32_u64(value64, word);
+        data += 8;
+        size -= 8;
+    }
+    value = static_cast<uint32_t>(value64);
+#endif
+    while(size >= 4) {
+        uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+        value = _mm_crc32_u32(value, word);
+        data += 4;
+        size -= 4;
+    }
+    while(size--) value = _mm_crc32_u8(value, *data++);
+    return value;
+}
+
+inline bool HasHardware() {
+    static const bool hasHardware { __builtin_cpu_supports("sse4.2") != 0 };
+    return hasHardware;
+}
+#elif ROHIT_CRC32C_ARM
+inline uint32_t UpdateHardware(uint32_t value, const uint8_t *data, size_t size) {
+    while(size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        value = __crc32cd(value, word);
+        data += 8;
+        size -= 8;
+    }
+    while(size--) value = __crc32cb(value, *data++);
+    return value;
+}
+
+constexpr bool HasHardware() { return true; }
+#else
+constexpr bool HasHardware() { return false; }
+#endif
+} // namespace crc32c
+
+// CRC32C of data continuing from crc of previous data, crc of empty data is 0.
+// Uses crc32 instruction when cpu has it, otherwise table.
+constexpr uint32_t Crc32c(const uint8_t *data, const size_t size, const uint32_t crc = 0) {
+#if ROHIT_CRC32C_SSE42 || ROHIT_CRC32C_ARM
+    if (!std::is_constant_evaluated() && crc32c::HasHardware()) return ~crc32c::UpdateHardware(~crc, data, size);
+#endif
+    return ~crc32c::UpdateTable(~crc, data, size);
+}
+
+// Table only, for comparison
+constexpr uint32_t Crc32cTable(const uint8_t *data, const size_t size, const uint32_t crc = 0) {
+    return ~crc32c::UpdateTable(~crc, data, size);
+}
+
+// Output stream folding CRC32C of bytes written. Writers may patch bytes written earlier, such as
+// size of list of unknown length, hence only committed bytes are folded. Commit folds bytes written
+// so far while they are still in cache, caller uses it when they will not change, such as after
+// each object. AppendChecksum commits and ends a message with its checksum, next message starts
+// with new checksum.
+class ChecksumOutStream : public FullStreamAutoAlloc {
+    size_t checked { 0 };
+    uint32_t crc { 0 };
+
+public:
+    using FullStreamAutoAlloc::FullStreamAutoAlloc;
+
+    // Bytes up to current position are final and are folded in checksum
+    void Commit() {
+        // Stream was reset
+        if (CurrentOffset() < checked) {
+            checked = 0;
+            crc = 0;
+        }
+        crc = Crc32c(_begin + checked, CurrentOffset() - checked, crc);
+        checked = CurrentOffset();
+    }
+
+    // Checksum of current message, bytes up to current position are committed
+    uint32_t Checksum() {
+        Commit();
+        return crc;
+    }
+
+    // Appends checksum of current message as 4 byte big endian
+    void AppendChecksum() {
+        const uint32_t bigEndian { ChangeEndian<std::endian::native, std::endian::big>(Checksum()) };
+        Append(reinterpret_cast<const uint8_t *>(&bigEndian), sizeof(bigEndian));
+        checked = CurrentOffset();
+        crc = 0;
+    }
+};
+
+// Input stream folding CRC32C of bytes consumed, bytes are folded in blocks as decoder moves
+// forward. VerifyChecksum reads checksum written by ChecksumOutStream::AppendChecksum.
+class ChecksumInStream : public FullStream {
+    static constexpr size_t fold_block { 256 };
+    mutable const uint8_t *checked;
+    mutable uint32_t crc { 0 };
+
+    void Fold() const {
+        if (_curr < checked) return;
+        crc = Crc32c(checked, static_cast<size_t>(_curr - checked), crc);
+        checked = _curr;
+    }
+
+    void FoldBlock() const { if (_curr >= checked + fold_block) Fold(); }
+
+public:
+    ChecksumInStream(const uint8_t *begin, const size_t size) : FullStream { const_cast<uint8_t *>(begin), size }, checked { begin } { }
+    ChecksumInStream(const FullStream &stream) : ChecksumInStream { stream.curr(), stream.RemainingBuffer() } { }
+    ChecksumInStream(const ChecksumInStream &) = delete;
+    ChecksumInStream &operator=(const ChecksumInStream &) = delete;
+
+    #if defined(__GNUC__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Weffc++"
+    #endif
+    inline const Stream &operator++() const override { ++_curr; FoldBlock(); return *this; }
+    inline const uint8_t *operator++(int) const override { uint8_t *temp = _curr; ++_curr; FoldBlock(); return temp; };
+    inline const Stream operator+(size_t len) const override { _curr += len; FoldBlock(); return *this; }
+    inline const Stream &operator+=(size_t len) const override { _curr += len; FoldBlock(); return *this; }
+    #if defined(__GNUC__)
+    #pragma GCC diagnostic pop
+    #endif
+    inline const uint8_t *GetCurrAndIncrease(const size_t len) const override { auto temp = _curr; _curr += len; FoldBlock(); return temp; }
+
+    // Checksum of bytes consumed in current message
+    uint32_t Checksum() const {
+        Fold();
+        return crc;
+    }
+
+    // Reads checksum following message, next message starts with new checksum
+    bool VerifyChecksum() const {
+        const uint32_t expected { Checksum() };
+        if (RemainingBuffer() < sizeof(uint32_t)) return false;
+        uint32_t bigEndian;
+        std::memcpy(&bigEndian, _curr, sizeof(bigEndian));
+        _curr += sizeof(bigEndian);
+        checked = _curr;
+        crc = 0;
+        return ChangeEndian<std::endian::big, std::endian::native>(bigEndian) == expected;
+    }
+};
+
+} // namespace rohit
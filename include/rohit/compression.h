@@ -0,0 +1,374 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Block compressed stream, blocks are independent and at most 64 KB before compression.
+//
+//  stream | "RSLZ" | block ... | end block |
+//  block  | kind (1 byte) | size before compression (4 bytes) | size of payload (4 bytes) | payload |
+//
+// Kind is 0 for end block, 1 for stored and 2 for compressed payload, sizes are big endian.
+// Compressed payload is sequences of token, literals and match as in LZ4:
+//
+//  sequence | token | extra literal length | literals | offset (2 bytes little endian) | extra match length |
+//
+// High nibble of token is literal length, low nibble is match length - 4, 15 is followed by extra
+// length bytes which are added till byte is not 255. Last sequence has only literals.
+
+#pragma once
+#include <rohit/serializer.h>
+#include <rohit/stream.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace rohit {
+
+namespace lz {
+constexpr size_t block_size { 64 * 1024 };
+constexpr size_t min_match { 4 };
+constexpr size_t max_offset { 0xffff };
+constexpr size_t hash_bits { 13 };
+constexpr size_t header_size { 9 };
+
+enum class BlockKind : uint8_t {
+    End = 0,
+    Stored = 1,
+    Compressed = 2
+};
+
+constexpr size_t MaxCompressedSize(const size_t size) { return size + size / 255 + 16; }
+
+inline uint32_t Load32(const uint8_t *data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32_t Hash(const uint32_t sequence) { return (sequence * 2654435761U) >> (32 - hash_bits); }
+
+inline uint8_t *WriteLength(uint8_t *output, size_t length) {
+    while(length >= 255) {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = static_cast<uint8_t>(length);
+    return output;
+}
+
+inline uint8_t *WriteSequence(uint8_t *output, const uint8_t *literals, const size_t literalLength, const size_t offset, const size_t matchLength) {
+    uint8_t &token = *output++;
+    token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+    if (literalLength >= 15) output = WriteLength(output, literalLength - 15);
+    std::memcpy(output, literals, literalLength);
+    output += literalLength;
+    if (!matchLength) return output;
+
+    *output++ = static_cast<uint8_t>(offset & 0xff);
+    *output++ = static_cast<uint8_t>(offset >> 8);
+    const size_t extraMatch { matchLength - min_match };
+    token |= static_cast<uint8_t>(std::min<size_t>(extraMatch, 15));
+    if (extraMatch >= 15) output = WriteLength(output, extraMatch - 15);
+    return output;
+}
+
+// Compresses input of at most block_size, output must have MaxCompressedSize(size) bytes, returns size of output
+inline size_t Compress(const uint8_t *input, const size_t size, uint8_t *output) {
+    std::vector<uint32_t> table(size_t { 1 } << hash_bits, 0);
+    uint8_t *const outputBegin { output };
+    size_t anchor { 0 };
+    size_t position { 0 };
+    while(position + min_match <= size) {
+        const uint32_t sequence { Load32(input + position) };
+        const uint32_t hash { Hash(sequence) };
+        const size_t candidate { table[hash] };
+        table[hash] = static_cast<uint32_t>(position);
+        if (candidate >= position || position - candidate > max_offset || Load32(input + candidate) != sequence) {
+            // Incompressible input is skipped faster
+            position += 1 + ((position - anchor) >> 6);
+            continue;
+        }
+
+        size_t matchLength { min_match };
+        while(position + matchLength < size && input[candidate + matchLength] == input[position + matchLength]) ++matchLength;
+        output = WriteSequence(output, input + anchor, position - anchor, position - candidate, matchLength);
+        position += matchLength;
+        anchor = position;
+    }
+    output = WriteSequence(output, input + anchor, size - anchor, 0, 0);
+    return static_cast<size_t>(output - outputBegin);
+}
+
+// Decompresses input into output of exactly outputSize bytes, false when input is bad
+inline bool Decompress(const uint8_t *input, const size_t inputSize, uint8_t *output, const size_t outputSize) {
+    const uint8_t *const inputEnd { input + inputSize };
+    uint8_t *const outputBegin { output };
+    uint8_t *const outputEnd { output + outputSize };
+    const auto readLength = [&input, inputEnd](size_t &length) {
+        uint8_t extra;
+        do {
+            if (input == inputEnd) return false;
+            extra = *input++;
+            length += extra;
+        } while(extra == 255);
+        return true;
+    };
+
+    while(true) {
+        if (input == inputEnd) return false;
+        const uint8_t token { *input++ };
+        size_t literalLength { static_cast<size_t>(token >> 4) };
+        if (literalLength == 15 && !readLength(literalLength)) return false;
+        if (literalLength > static_cast<size_t>(inputEnd - input) || literalLength > static_cast<size_t>(outputEnd - output)) return false;
+        std::memcpy(output, input, literalLength);
+        input += literalLength;
+        output += literalLength;
+        if (input == inputEnd) return output == outputEnd;
+
+        if (inputEnd - input < 2) return false;
+        const size_t offset { static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8) };
+        input += 2;
+        size_t matchLength { static_cast<size_t>(token & 15) };
+        if (matchLength == 15 && !readLength(matchLength)) return false;
+        matchLength += min_match;
+        if (offset == 0 || offset > static_cast<size_t>(output - outputBegin) || matchLength > static_cast<size_t>(outputEnd - output)) return false;
+
+        const uint8_t *match { output - offset };
+        if (offset >= matchLength) std::memcpy(output, match, matchLength);
+        else for(size_t index { 0 }; index < matchLength; ++index) output[index] = match[index]; // Overlapping repeats pattern
+        output += matchLength;
+    }
+}
+} // namespace lz
+
+// Output stage compressing what is written to it in blocks of lz::block_size which are written to
+// sink, which is rohit::Stream or std::ostream, as soon as block is full. Finish writes last block,
+// destructor calls it when it is not called unless stream is left by exception, error in destructor
+// is ignored hence Finish is called when error matters. Written bytes cannot be patched later,
+// hence it is not rohit::FullStream.
+class CompressOutStream : public Stream {
+    Stream *sink;
+    std::ostream *file;
+    uint8_t *buffer;
+    size_t capacity { lz::block_size };
+    std::vector<uint8_t> compressed { };
+    bool finished { false };
+    const int uncaughtExceptions { std::uncaught_exceptions() };
+
+    void Emit(const uint8_t *data, const size_t size) {
+        if (sink) sink->Append(data, size);
+        else file->write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+    }
+
+    void EmitHeader(const lz::BlockKind kind, const uint32_t size, const uint32_t payloadSize) {
+        uint8_t header[lz::header_size] { static_cast<uint8_t>(kind) };
+        const uint32_t sizeBig { ChangeEndian<std::endian::native, std::endian::big>(size) };
+        const uint32_t payloadBig { ChangeEndian<std::endian::native, std::endian::big>(payloadSize) };
+        std::memcpy(header + 1, &sizeBig, sizeof(sizeBig));
+        std::memcpy(header + 5, &payloadBig, sizeof(payloadBig));
+        Emit(header, sizeof(header));
+    }
+
+    void EmitBlock(const uint8_t *data, const size_t size) {
+        compressed.resize(lz::MaxCompressedSize(size));
+        const size_t compressedSize { lz::Compress(data, size, compressed.data()) };
+        if (compressedSize < size) {
+            EmitHeader(lz::BlockKind::Compressed, static_cast<uint32_t>(size), static_cast<uint32_t>(compressedSize));
+            Emit(compressed.data(), compressedSize);
+        } else {
+            EmitHeader(lz::BlockKind::Stored, static_cast<uint32_t>(size), static_cast<uint32_t>(size));
+            Emit(data, size);
+        }
+    }
+
+    void Flush() {
+        const size_t size { static_cast<size_t>(_curr - buffer) };
+        for(size_t offset { 0 }; offset < size; offset += lz::block_size) {
+            EmitBlock(buffer + offset, std::min(lz::block_size, size - offset));
+        }
+        _curr = buffer;
+    }
+
+    // Write of len bytes is kept in one buffer, buffer larger than block is split at flush
+    void Ensure(const size_t len) {
+        if (_curr + len <= _end) return;
+        if (finished) ROHIT_THROW(std::logic_error { "Compressed stream is finished" });
+        Flush();
+        if (len > capacity) {
+            auto newBuffer = reinterpret_cast<uint8_t *>(realloc(buffer, len));
+            if (newBuffer == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
+            buffer = newBuffer;
+            capacity = len;
+            _curr = buffer;
+            _end = buffer + capacity;
+        }
+    }
+
+public:
+    CompressOutStream(Stream &sink) : Stream { }, sink { &sink }, file { nullptr }, buffer { reinterpret_cast<uint8_t *>(malloc(lz::block_size)) } {
+        if (buffer == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
+        _curr = buffer;
+        _end = buffer + capacity;
+        Emit(reinterpret_cast<const uint8_t *>("RSLZ"), 4);
+    }
+
+    CompressOutStream(std::ostream &file) : Stream { }, sink { nullptr }, file { &file }, buffer { reinterpret_cast<uint8_t *>(malloc(lz::block_size)) } {
+        if (buffer == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
+        _curr = buffer;
+        _end = buffer + capacity;
+        Emit(reinterpret_cast<const uint8_t *>("RSLZ"), 4);
+    }
+
+    CompressOutStream(const CompressOutStream &) = delete;
+    CompressOutStream &operator=(const CompressOutStream &) = delete;
+    ~CompressOutStream() {
+        // Stream is left by exception when more exceptions are in flight than at construction
+        if (!finished && std::uncaught_exceptions() == uncaughtExceptions) {
+#if ROHIT_EXCEPTIONS
+            try {
+                Finish();
+            } catch(...) { }
+#else
+            Finish();
+#endif
+        }
+        free(buffer);
+    }
+
+    void Finish() {
+        if (finished) return;
+        Flush();
+        EmitHeader(lz::BlockKind::End, 0, 0);
+        finished = true;
+    }
+
+    #if defined(__GNUC__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Weffc++"
+    #endif
+    inline Stream &operator++() override { Ensure(1); ++_curr; return *this; }
+    inline uint8_t *operator++(int) override { Ensure(1); uint8_t *temp = _curr; ++_curr; return temp; };
+    inline Stream operator+(size_t len) override { Ensure(len); _curr += len; return *this; }
+    inline Stream &operator+=(size_t len) override { Ensure(len); _curr += len; return *this; }
+    #if defined(__GNUC__)
+    #pragma GCC diagnostic pop
+    #endif
+
+    inline void Reserve(const size_t len) override { Ensure(len); }
+    inline uint8_t *GetCurrAndIncrease(const size_t len) override { Ensure(len); auto temp = _curr; _curr += len; return temp; }
+};
+
+// Input decompressing blocks written by CompressOutStream from rohit::Stream or std::istream.
+// Decoder reads contiguous memory, hence blocks are appended to one buffer. ReadBlock reads one
+// block so that reading source and decompressing can be interleaved, ReadAll reads till end.
+class DecompressInStream : public FullStream {
+    const Stream *source;
+    std::istream *file;
+    size_t capacity { 0 };
+    std::vector<uint8_t> payload { };
+    bool ended { false };
+
+    [[noreturn]] void FailInput([[maybe_unused]] const char *message) const {
+        if (source) ROHIT_THROW(serializer::exception::BadInputData { *source, message });
+        ROHIT_THROW(serializer::exception::BadInputData { *this, message });
+    }
+
+    void ReadSource(uint8_t *data, const size_t size) {
+        if (source) {
+            if (source->RemainingBuffer() < size) FailInput("Compressed stream is truncated");
+            std::memcpy(data, source->curr(), size);
+            *source += size;
+        } else {
+            file->read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(size));
+            if (static_cast<size_t>(file->gcount()) != size) FailInput("Compressed stream is truncated");
+        }
+    }
+
+    void Grow(const size_t size) {
+        const size_t used { static_cast<size_t>(_end - _begin) };
+        if (used + size <= capacity) return;
+        const size_t currOffset { CurrentOffset() };
+        const size_t newCapacity { std::max(used + size, capacity * 2) };
+        auto newBuffer = reinterpret_cast<uint8_t *>(realloc(_begin, newCapacity));
+        if (newBuffer == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
+        _begin = newBuffer;
+        _curr = _begin + currOffset;
+        _end = _begin + used;
+        capacity = newCapacity;
+    }
+
+    void ReadMagic() {
+        uint8_t magic[4];
+        ReadSource(magic, sizeof(magic));
+        if (std::memcmp(magic, "RSLZ", sizeof(magic)) != 0) FailInput("Not a compressed stream");
+    }
+
+public:
+    DecompressInStream(const Stream &source) : FullStream { }, source { &source }, file { nullptr } {
+        _curr = _end = nullptr;
+        ReadMagic();
+    }
+
+    DecompressInStream(std::istream &file) : FullStream { }, source { nullptr }, file { &file } {
+        _curr = _end = nullptr;
+        ReadMagic();
+    }
+
+    DecompressInStream(const DecompressInStream &) = delete;
+    DecompressInStream &operator=(const DecompressInStream &) = delete;
+    ~DecompressInStream() { free(_begin); }
+
+    bool Ended() const { return ended; }
+
+    // Appends next block to stream, false after end block
+    bool ReadBlock() {
+        if (ended) return false;
+        uint8_t header[lz::header_size];
+        ReadSource(header, sizeof(header));
+        const auto kind = static_cast<lz::BlockKind>(header[0]);
+        uint32_t size, payloadSize;
+        std::memcpy(&size, header + 1, sizeof(size));
+        std::memcpy(&payloadSize, header + 5, sizeof(payloadSize));
+        size = ChangeEndian<std::endian::big, std::endian::native>(size);
+        payloadSize = ChangeEndian<std::endian::big, std::endian::native>(payloadSize);
+
+        if (kind == lz::BlockKind::End) {
+            ended = true;
+            return false;
+        }
+        if (size > lz::block_size || payloadSize > lz::MaxCompressedSize(lz::block_size)) FailInput("Bad compressed block size");
+        Grow(size);
+        if (kind == lz::BlockKind::Stored) {
+            if (payloadSize != size) FailInput("Bad stored block size");
+            ReadSource(_end, size);
+        } else if (kind == lz::BlockKind::Compressed) {
+            payload.resize(payloadSize);
+            ReadSource(payload.data(), payloadSize);
+            if (!lz::Decompress(payload.data(), payloadSize, _end, size)) FailInput("Bad compressed block");
+        } else FailInput("Bad compressed block kind");
+        _end += size;
+        return true;
+    }
+
+    void ReadAll() { while(ReadBlock()); }
+};
+
+} // namespace rohit
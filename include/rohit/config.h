@@ -0,0 +1,29 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <cstdlib>
+
+// Exception free builds (-fno-exceptions) abort where an exception would be thrown.
+// Decoding bad input in such builds must use TrySerializeIn, it reports error without throwing.
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#define ROHIT_EXCEPTIONS 1
+#define ROHIT_THROW(...) throw __VA_ARGS__
+#else
+#define ROHIT_EXCEPTIONS 0
+#define ROHIT_THROW(...) std::abort()
+#endif
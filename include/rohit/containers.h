@@ -0,0 +1,335 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <rohit/config.h>
+#include <vector>
+#include <utility>
+#include <tuple>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+#include <array>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace rohit {
+
+// Map stored as a sorted vector of key value pair. Lookups are binary search,
+// iteration is contiguous and in key order. Appending keys in increasing
+// order through emplace_hint(end(), ...) is O(1), so sorted input loads in O(n).
+// Container allocator is used for entries, std::pmr::vector makes it allocator aware.
+template <typename Key, typename T, typename Compare = std::less<Key>, typename Container = std::vector<std::pair<Key, T>>>
+class flat_map {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using container_type = Container;
+    using allocator_type = typename container_type::allocator_type;
+    using size_type = typename container_type::size_type;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+private:
+    container_type data { };
+    [[no_unique_address]] Compare compare { };
+
+    bool Less(const Key &lhs, const Key &rhs) const { return compare(lhs, rhs); }
+
+    // Position after all keys that are less than key
+    iterator LowerBound(const Key &key) {
+        return std::lower_bound(data.begin(), data.end(), key,
+            [this](const value_type &lhs, const Key &rhs) { return Less(lhs.first, rhs); });
+    }
+
+    const_iterator LowerBound(const Key &key) const {
+        return std::lower_bound(data.begin(), data.end(), key,
+            [this](const value_type &lhs, const Key &rhs) { return Less(lhs.first, rhs); });
+    }
+
+    bool Matches(const_iterator itr, const Key &key) const {
+        return itr != data.end() && !Less(key, itr->first);
+    }
+
+public:
+    flat_map() = default;
+    flat_map(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+    explicit flat_map(const allocator_type &allocator) : data(allocator) { }
+    flat_map(const flat_map &other) = default;
+    flat_map(flat_map &&other) = default;
+    flat_map(const flat_map &other, const allocator_type &allocator) : data(other.data, allocator), compare(other.compare) { }
+    flat_map(flat_map &&other, const allocator_type &allocator) : data(std::move(other.data), allocator), compare(other.compare) { }
+    flat_map &operator=(const flat_map &other) = default;
+    flat_map &operator=(flat_map &&other) = default;
+
+    allocator_type get_allocator() const { return data.get_allocator(); }
+
+    iterator begin() noexcept { return data.begin(); }
+    iterator end() noexcept { return data.end(); }
+    const_iterator begin() const noexcept { return data.begin(); }
+    const_iterator end() const noexcept { return data.end(); }
+    const_iterator cbegin() const noexcept { return data.cbegin(); }
+    const_iterator cend() const noexcept { return data.cend(); }
+
+    bool empty() const noexcept { return data.empty(); }
+    size_type size() const noexcept { return data.size(); }
+    void reserve(size_type count) { data.reserve(count); }
+    void clear() noexcept { data.clear(); }
+
+    iterator lower_bound(const Key &key) { return LowerBound(key); }
+    const_iterator lower_bound(const Key &key) const { return LowerBound(key); }
+
+    iterator find(const Key &key) {
+        auto itr = LowerBound(key);
+        return Matches(itr, key) ? itr : data.end();
+    }
+
+    const_iterator find(const Key &key) const {
+        auto itr = LowerBound(key);
+        return Matches(itr, key) ? itr : data.end();
+    }
+
+    bool contains(const Key &key) const { return find(key) != data.end(); }
+    size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+    T &at(const Key &key) {
+        auto itr = find(key);
+        if (itr == data.end()) ROHIT_THROW(std::out_of_range { "flat_map::at key not found" });
+        return itr->second;
+    }
+
+    const T &at(const Key &key) const {
+        auto itr = find(key);
+        if (itr == data.end()) ROHIT_THROW(std::out_of_range { "flat_map::at key not found" });
+        return itr->second;
+    }
+
+    T &operator[](const Key &key) { return try_emplace(key).first->second; }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K &&key, Args&&... args) {
+        auto itr = LowerBound(key);
+        if (Matches(itr, key)) return { itr, false };
+        itr = data.emplace(itr, std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        return { itr, true };
+    }
+
+    template <typename K, typename V>
+    std::pair<iterator, bool> emplace(K &&key, V &&value) {
+        return try_emplace(std::forward<K>(key), std::forward<V>(value));
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value) { return try_emplace(value.first, value.second); }
+    std::pair<iterator, bool> insert(value_type &&value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+
+    template <typename Iterator>
+    void insert(Iterator first, Iterator last) {
+        for(; first != last; ++first) emplace_hint(end(), first->first, first->second);
+    }
+
+    // Hint is honoured only when it is end() and key is greater than the last key,
+    // any other position falls back to binary search
+    template <typename K, typename V>
+    iterator emplace_hint(const_iterator hint, K &&key, V &&value) {
+        if (hint == data.cend() && (data.empty() || Less(data.back().first, key))) {
+            data.emplace_back(std::forward<K>(key), std::forward<V>(value));
+            return std::prev(data.end());
+        }
+        return try_emplace(std::forward<K>(key), std::forward<V>(value)).first;
+    }
+
+    iterator erase(const_iterator itr) { return data.erase(itr); }
+
+    size_type erase(const Key &key) {
+        auto itr = find(key);
+        if (itr == data.end()) return 0;
+        data.erase(itr);
+        return 1;
+    }
+
+    // Moves out underlying sorted vector, map is empty after this
+    container_type extract() && {
+        container_type container { std::move(data) };
+        data.clear();
+        return container;
+    }
+
+    // Adopts vector as underlying storage, it is sorted only when not already
+    // in order, first of duplicate keys is kept
+    void replace(container_type &&container) {
+        data = std::move(container);
+        const auto less = [this](const value_type &lhs, const value_type &rhs) { return Less(lhs.first, rhs.first); };
+        if (!std::is_sorted(data.begin(), data.end(), less)) std::stable_sort(data.begin(), data.end(), less);
+        data.erase(std::unique(data.begin(), data.end(),
+            [this](const value_type &lhs, const value_type &rhs) { return !Less(lhs.first, rhs.first); }), data.end());
+    }
+
+    bool operator==(const flat_map &rhs) const { return data == rhs.data; }
+}; // class flat_map
+
+// Smallest unsigned type able to hold count upto N
+template <std::size_t N>
+using inline_size_t = std::conditional_t<N <= UINT8_MAX, uint8_t, std::conditional_t<N <= UINT16_MAX, uint16_t, uint32_t>>;
+
+// Vector with fixed capacity N stored inside the object, it never allocates.
+// Slots after size() are always value initialized so that fixed width
+// encoding of unused slots is deterministic.
+template <typename T, std::size_t N>
+class inline_vector {
+public:
+    using value_type = T;
+    using size_type = inline_size_t<N>;
+    using iterator = T *;
+    using const_iterator = const T *;
+    static constexpr std::size_t static_capacity { N };
+
+private:
+    std::array<T, N> buffer { };
+    size_type length { };
+
+    void CheckCapacity(const std::size_t count) const {
+        if (count > N) ROHIT_THROW(std::length_error { "inline_vector capacity exceeded" });
+    }
+
+public:
+    constexpr inline_vector() = default;
+    inline_vector(std::initializer_list<T> list) {
+        CheckCapacity(list.size());
+        std::copy(list.begin(), list.end(), buffer.begin());
+        length = static_cast<size_type>(list.size());
+    }
+
+    iterator begin() noexcept { return buffer.data(); }
+    iterator end() noexcept { return buffer.data() + length; }
+    const_iterator begin() const noexcept { return buffer.data(); }
+    const_iterator end() const noexcept { return buffer.data() + length; }
+
+    T *data() noexcept { return buffer.data(); }
+    const T *data() const noexcept { return buffer.data(); }
+    constexpr std::size_t size() const noexcept { return length; }
+    static constexpr std::size_t capacity() noexcept { return N; }
+    static constexpr std::size_t max_size() noexcept { return N; }
+    constexpr bool empty() const noexcept { return length == 0; }
+    constexpr bool full() const noexcept { return length == N; }
+
+    T &operator[](const std::size_t index) { return buffer[index]; }
+    const T &operator[](const std::size_t index) const { return buffer[index]; }
+    T &at(const std::size_t index) {
+        if (index >= length) ROHIT_THROW(std::out_of_range { "inline_vector::at index out of range" });
+        return buffer[index];
+    }
+    const T &at(const std::size_t index) const {
+        if (index >= length) ROHIT_THROW(std::out_of_range { "inline_vector::at index out of range" });
+        return buffer[index];
+    }
+    T &front() { return buffer[0]; }
+    const T &front() const { return buffer[0]; }
+    T &back() { return buffer[length - 1]; }
+    const T &back() const { return buffer[length - 1]; }
+
+    template <typename... Args>
+    T &emplace_back(Args&&... args) {
+        CheckCapacity(length + 1);
+        buffer[length] = T { std::forward<Args>(args)... };
+        return buffer[length++];
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    void pop_back() { buffer[--length] = T { }; }
+
+    void resize(const std::size_t count) {
+        CheckCapacity(count);
+        for(auto index = count; index < length; ++index) buffer[index] = T { };
+        length = static_cast<size_type>(count);
+    }
+
+    void clear() { resize(0); }
+
+    bool operator==(const inline_vector &rhs) const { return std::equal(begin(), end(), rhs.begin(), rhs.end()); }
+}; // class inline_vector
+
+// String with fixed capacity N stored inside the object, it never allocates.
+// Buffer is kept null terminated and zero filled after size().
+template <std::size_t N>
+class inline_string {
+public:
+    using value_type = char;
+    using size_type = inline_size_t<N>;
+    using iterator = char *;
+    using const_iterator = const char *;
+    static constexpr std::size_t static_capacity { N };
+
+private:
+    std::array<char, N + 1> buffer { };
+    size_type length { };
+
+public:
+    constexpr inline_string() = default;
+    inline_string(const std::string_view value) { assign(value); }
+    inline_string(const char *value) { assign(std::string_view { value }); }
+
+    inline_string &operator=(const std::string_view value) { assign(value); return *this; }
+    inline_string &operator=(const char *value) { assign(std::string_view { value }); return *this; }
+
+    void assign(const std::string_view value) {
+        if (value.size() > N) ROHIT_THROW(std::length_error { "inline_string capacity exceeded" });
+        std::copy(value.begin(), value.end(), buffer.begin());
+        if (value.size() < length) std::fill(buffer.begin() + value.size(), buffer.begin() + length, '\0');
+        length = static_cast<size_type>(value.size());
+    }
+
+    iterator begin() noexcept { return buffer.data(); }
+    iterator end() noexcept { return buffer.data() + length; }
+    const_iterator begin() const noexcept { return buffer.data(); }
+    const_iterator end() const noexcept { return buffer.data() + length; }
+
+    char *data() noexcept { return buffer.data(); }
+    const char *data() const noexcept { return buffer.data(); }
+    const char *c_str() const noexcept { return buffer.data(); }
+    constexpr std::size_t size() const noexcept { return length; }
+    static constexpr std::size_t capacity() noexcept { return N; }
+    constexpr bool empty() const noexcept { return length == 0; }
+    constexpr bool full() const noexcept { return length == N; }
+
+    char &operator[](const std::size_t index) { return buffer[index]; }
+    const char &operator[](const std::size_t index) const { return buffer[index]; }
+
+    void push_back(const char ch) {
+        if (length == N) ROHIT_THROW(std::length_error { "inline_string capacity exceeded" });
+        buffer[length++] = ch;
+    }
+
+    void clear() { assign({ }); }
+
+    std::string_view view() const noexcept { return { buffer.data(), length }; }
+    operator std::string_view() const noexcept { return view(); }
+
+    bool operator==(const inline_string &rhs) const { return view() == rhs.view(); }
+    bool operator==(const std::string_view rhs) const { return view() == rhs; }
+    bool operator==(const char *rhs) const { return view() == std::string_view { rhs }; }
+}; // class inline_string
+
+} // namespace rohit
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <rohit/serializer.h>
+#include <rohit/stream.h>
+
+namespace rohit::serializer {
+
+// Writes consecutive objects of same type as delta from previous one. Each record is bitmap of
+// changed members followed by their values in binary bitmap protocol, changed nested object and
+// list are written whole. First record and record after Reset are delta from default object.
+template <typename T>
+class DeltaWriter {
+    T previous { };
+
+public:
+    void Write(Stream &stream, const T &value) {
+        binary<SerializeType::Out, SerializeKeyType::Bitmap> serializerProtocol { stream };
+        value.SerializeOutDelta(serializerProtocol, previous);
+        previous = value;
+    }
+
+    const T &Previous() const { return previous; }
+
+    // Next record is written from default object, reader must be Reset at same record
+    void Reset() { previous = T { }; }
+};
+
+// Applies records of DeltaWriter to its object, members absent in record keep their value. Changed
+// members are decoded in DecodeMode::Reuse so that lists and nested objects are replaced, not
+// appended to. Object is left partly updated when record is bad, reader and writer must then be Reset.
+template <typename T>
+class DeltaReader {
+    T current { };
+
+public:
+    const T &Read(const Stream &stream) {
+        binaryInBase<SerializeKeyType::Bitmap, DecodeMode::Reuse> serializerProtocol { stream };
+        serializerProtocol.StructSerializeInMembers(&current, AllFields { });
+        return current;
+    }
+
+    const T &Current() const { return current; }
+
+    void Reset() { current = T { }; }
+};
+
+} // namespace rohit::serializer
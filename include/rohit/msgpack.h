@@ -0,0 +1,672 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <rohit/serializer.h>
+#include <rohit/stream.h>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+namespace rohit::serializer {
+
+// Type bytes of MessagePack, fix formats hold size or value in low bits
+namespace msgpack_format {
+constexpr uint8_t positive_fixint_max { 0x7f };
+constexpr uint8_t fixmap { 0x80 };
+constexpr uint8_t fixarray { 0x90 };
+constexpr uint8_t fixstr { 0xa0 };
+constexpr uint8_t nil { 0xc0 };
+constexpr uint8_t never_used { 0xc1 };
+constexpr uint8_t false_value { 0xc2 };
+constexpr uint8_t true_value { 0xc3 };
+constexpr uint8_t bin8 { 0xc4 };
+constexpr uint8_t bin16 { 0xc5 };
+constexpr uint8_t bin32 { 0xc6 };
+constexpr uint8_t ext8 { 0xc7 };
+constexpr uint8_t ext16 { 0xc8 };
+constexpr uint8_t ext32 { 0xc9 };
+constexpr uint8_t float32 { 0xca };
+constexpr uint8_t float64 { 0xcb };
+constexpr uint8_t uint8 { 0xcc };
+constexpr uint8_t uint16 { 0xcd };
+constexpr uint8_t uint32 { 0xce };
+constexpr uint8_t uint64 { 0xcf };
+constexpr uint8_t int8 { 0xd0 };
+constexpr uint8_t int16 { 0xd1 };
+constexpr uint8_t int32 { 0xd2 };
+constexpr uint8_t int64 { 0xd3 };
+constexpr uint8_t fixext1 { 0xd4 };
+constexpr uint8_t fixext16 { 0xd8 };
+constexpr uint8_t str8 { 0xd9 };
+constexpr uint8_t str16 { 0xda };
+constexpr uint8_t str32 { 0xdb };
+constexpr uint8_t array16 { 0xdc };
+constexpr uint8_t array32 { 0xdd };
+constexpr uint8_t map16 { 0xde };
+constexpr uint8_t map32 { 0xdf };
+constexpr uint8_t negative_fixint { 0xe0 };
+} // namespace msgpack_format
+
+template <SerializeType type>
+class msgpack { };
+
+// Object is map of member name to value as in json, union member is keyed by name:type and enum
+// member is written as its name. Map is MessagePack map, list is array, char is string of one
+// character and enum which is not a member is integer. Nil member is read as absent member.
+template <DecodeMode DECODE_MODE = DecodeMode::Default>
+class MsgpackIn : public DecodeState<DECODE_MODE> {
+public:
+    constexpr static SerializeKeyType serialize_key_type = SerializeKeyType::String;
+    template <DecodeMode MODE>
+    using with_decode_mode = MsgpackIn<MODE>;
+
+protected:
+    using DecodeState<DECODE_MODE>::inStream;
+
+public:
+    using DecodeState<DECODE_MODE>::DecodeState;
+    using DecodeState<DECODE_MODE>::Fail;
+    using DecodeState<DECODE_MODE>::Failed;
+
+private:
+    uint8_t ReadType() {
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return msgpack_format::never_used;
+        }
+        return *inStream++;
+    }
+
+    template <typename T>
+    T ReadBigEndian() {
+        if (inStream.RemainingBuffer() < sizeof(T)) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return 0;
+        }
+        T value;
+        std::memcpy(&value, inStream.curr(), sizeof(T));
+        inStream += sizeof(T);
+        return ChangeEndian<std::endian::big, std::endian::native>(value);
+    }
+
+    // Returns 0 on failure in NoThrow mode
+    uint32_t ReadStringSize() {
+        const uint8_t type = ReadType();
+        if (Failed()) return 0;
+        if ((type & 0xe0) == msgpack_format::fixstr) return type & 0x1f;
+        switch(type) {
+            case msgpack_format::str8:
+            case msgpack_format::bin8: return ReadBigEndian<uint8_t>();
+            case msgpack_format::str16:
+            case msgpack_format::bin16: return ReadBigEndian<uint16_t>();
+            case msgpack_format::str32:
+            case msgpack_format::bin32: return ReadBigEndian<uint32_t>();
+            default:
+                Fail(ErrorKind::BadValue, "Expected string");
+                return 0;
+        }
+    }
+
+    uint32_t ReadArraySize() {
+        const uint8_t type = ReadType();
+        if (Failed()) return 0;
+        if ((type & 0xf0) == msgpack_format::fixarray) return type & 0x0f;
+        if (type == msgpack_format::array16) return ReadBigEndian<uint16_t>();
+        if (type == msgpack_format::array32) return ReadBigEndian<uint32_t>();
+        Fail(ErrorKind::BadValue, "Expected array");
+        return 0;
+    }
+
+    uint32_t ReadMapSize() {
+        const uint8_t type = ReadType();
+        if (Failed()) return 0;
+        if ((type & 0xf0) == msgpack_format::fixmap) return type & 0x0f;
+        if (type == msgpack_format::map16) return ReadBigEndian<uint16_t>();
+        if (type == msgpack_format::map32) return ReadBigEndian<uint32_t>();
+        Fail(ErrorKind::BadValue, "Expected map");
+        return 0;
+    }
+
+    // String is not copied, it points into input
+    std::string_view ReadStringView(const size_t capacity = std::numeric_limits<size_t>::max()) {
+        const size_t size = ReadStringSize();
+        if (Failed()) return { };
+        if (size > capacity) {
+            Fail(ErrorKind::CapacityExceeded, "String exceeds inline capacity");
+            return { };
+        }
+        if (inStream.RemainingBuffer() < size) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return { };
+        }
+        const std::string_view value { reinterpret_cast<const char *>(inStream.curr()), size };
+        inStream += size;
+        return value;
+    }
+
+    // Integer of any width is accepted when its value fits in T
+    template <typename T>
+    void SerializeInInteger(T &value) {
+        const uint8_t type = ReadType();
+        if (Failed()) return;
+        uint64_t unsignedValue { 0 };
+        int64_t signedValue { 0 };
+        bool isSigned { false };
+        if (type <= msgpack_format::positive_fixint_max) unsignedValue = type;
+        else if (type >= msgpack_format::negative_fixint) {
+            signedValue = static_cast<int8_t>(type);
+            isSigned = true;
+        } else switch(type) {
+            case msgpack_format::uint8: unsignedValue = ReadBigEndian<uint8_t>(); break;
+            case msgpack_format::uint16: unsignedValue = ReadBigEndian<uint16_t>(); break;
+            case msgpack_format::uint32: unsignedValue = ReadBigEndian<uint32_t>(); break;
+            case msgpack_format::uint64: unsignedValue = ReadBigEndian<uint64_t>(); break;
+            case msgpack_format::int8: signedValue = static_cast<int8_t>(ReadBigEndian<uint8_t>()); isSigned = true; break;
+            case msgpack_format::int16: signedValue = static_cast<int16_t>(ReadBigEndian<uint16_t>()); isSigned = true; break;
+            case msgpack_format::int32: signedValue = static_cast<int32_t>(ReadBigEndian<uint32_t>()); isSigned = true; break;
+            case msgpack_format::int64: signedValue = static_cast<int64_t>(ReadBigEndian<uint64_t>()); isSigned = true; break;
+            default: return Fail(ErrorKind::BadValue, "Expected integer");
+        }
+        if (Failed()) return;
+        if (isSigned ? !std::in_range<T>(signedValue) : !std::in_range<T>(unsignedValue)) return Fail(ErrorKind::BadValue, "Integer out of range");
+        value = isSigned ? static_cast<T>(signedValue) : static_cast<T>(unsignedValue);
+    }
+
+    // Either float width and integer are accepted
+    template <typename T>
+    void SerializeInFloatingPoint(T &value) {
+        if (inStream.full()) return Fail(ErrorKind::UnexpectedEnd);
+        const uint8_t type = *inStream;
+        if (type == msgpack_format::float32) {
+            ++inStream;
+            value = static_cast<T>(std::bit_cast<float>(ReadBigEndian<uint32_t>()));
+        } else if (type == msgpack_format::float64) {
+            ++inStream;
+            value = static_cast<T>(std::bit_cast<double>(ReadBigEndian<uint64_t>()));
+        } else if (type <= msgpack_format::positive_fixint_max || (type >= msgpack_format::uint8 && type <= msgpack_format::uint64)) {
+            uint64_t integer { };
+            SerializeInInteger(integer);
+            value = static_cast<T>(integer);
+        } else {
+            int64_t integer { };
+            SerializeInInteger(integer);
+            value = static_cast<T>(integer);
+        }
+    }
+
+    void SerializeInBool(bool &value) {
+        const uint8_t type = ReadType();
+        if (type == msgpack_format::true_value) value = true;
+        else if (type == msgpack_format::false_value) value = false;
+        else if (!Failed()) Fail(ErrorKind::BadValue, "Expected bool");
+    }
+
+    // Char is string of one character, integer is also accepted
+    void SerializeInChar(char &value) {
+        if (inStream.full()) return Fail(ErrorKind::UnexpectedEnd);
+        const uint8_t type = *inStream;
+        if ((type & 0xe0) == msgpack_format::fixstr || (type >= msgpack_format::str8 && type <= msgpack_format::str32)) {
+            const auto str = ReadStringView();
+            if (Failed()) return;
+            if (str.size() != 1) return Fail(ErrorKind::BadValue, "Expected one character");
+            value = str[0];
+        } else {
+            std::conditional_t<std::is_signed_v<char>, signed char, unsigned char> integer { };
+            SerializeInInteger(integer);
+            value = static_cast<char>(integer);
+        }
+    }
+
+    void SerializeInMap(auto &value) {
+        const size_t size = ReadMapSize();
+        MapDecoder<std::remove_reference_t<decltype(value)>, DECODE_MODE> decoder { value };
+        decoder.Reserve(std::min<size_t>(size, inStream.RemainingBuffer()));
+        for (size_t i = 0; i < size && !Failed(); ++i) {
+            decoder.Read([this](auto &key, auto &mapped) {
+                SerializeIn(key);
+                SerializeIn(mapped);
+            });
+        }
+        decoder.Finish();
+    }
+
+    void ValidateString(const size_t capacity) {
+        const auto value = ReadStringView(capacity);
+        if (!Failed() && !IsValidUtf8(reinterpret_cast<const uint8_t *>(value.data()), reinterpret_cast<const uint8_t *>(value.data() + value.size()))) {
+            Fail(ErrorKind::BadValue, "Invalid UTF-8");
+        }
+    }
+
+    void SkipBytes(const size_t size) {
+        if (Failed()) return;
+        if (inStream.RemainingBuffer() < size) return Fail(ErrorKind::UnexpectedEnd);
+        inStream += size;
+    }
+
+    // Nested arrays and maps are counted instead of recursed, hence deep input cannot exhaust stack
+    void SkipValue() {
+        size_t pending { 1 };
+        while(pending && !Failed()) {
+            --pending;
+            const uint8_t type = ReadType();
+            if (Failed()) return;
+            if (type <= msgpack_format::positive_fixint_max || type >= msgpack_format::negative_fixint) continue;
+            if ((type & 0xf0) == msgpack_format::fixmap) {
+                pending += 2 * (type & 0x0f);
+                continue;
+            }
+            if ((type & 0xf0) == msgpack_format::fixarray) {
+                pending += type & 0x0f;
+                continue;
+            }
+            if ((type & 0xe0) == msgpack_format::fixstr) {
+                SkipBytes(type & 0x1f);
+                continue;
+            }
+            switch(type) {
+                case msgpack_format::nil:
+                case msgpack_format::false_value:
+                case msgpack_format::true_value: break;
+                case msgpack_format::bin8:
+                case msgpack_format::str8: SkipBytes(ReadBigEndian<uint8_t>()); break;
+                case msgpack_format::bin16:
+                case msgpack_format::str16: SkipBytes(ReadBigEndian<uint16_t>()); break;
+                case msgpack_format::bin32:
+                case msgpack_format::str32: SkipBytes(ReadBigEndian<uint32_t>()); break;
+                case msgpack_format::ext8: SkipBytes(static_cast<size_t>(ReadBigEndian<uint8_t>()) + 1); break;
+                case msgpack_format::ext16: SkipBytes(static_cast<size_t>(ReadBigEndian<uint16_t>()) + 1); break;
+                case msgpack_format::ext32: SkipBytes(static_cast<size_t>(ReadBigEndian<uint32_t>()) + 1); break;
+                case msgpack_format::float32: SkipBytes(4); break;
+                case msgpack_format::float64: SkipBytes(8); break;
+                case msgpack_format::uint8:
+                case msgpack_format::int8: SkipBytes(1); break;
+                case msgpack_format::uint16:
+                case msgpack_format::int16: SkipBytes(2); break;
+                case msgpack_format::uint32:
+                case msgpack_format::int32: SkipBytes(4); break;
+                case msgpack_format::uint64:
+                case msgpack_format::int64: SkipBytes(8); break;
+                case msgpack_format::array16: pending += ReadBigEndian<uint16_t>(); break;
+                case msgpack_format::array32: pending += ReadBigEndian<uint32_t>(); break;
+                case msgpack_format::map16: pending += 2 * static_cast<size_t>(ReadBigEndian<uint16_t>()); break;
+                case msgpack_format::map32: pending += 2 * static_cast<size_t>(ReadBigEndian<uint32_t>()); break;
+                default:
+                    if (type >= msgpack_format::fixext1 && type <= msgpack_format::fixext16) {
+                        SkipBytes((static_cast<size_t>(1) << (type - msgpack_format::fixext1)) + 1);
+                    } else Fail(ErrorKind::BadValue, "Bad type");
+                    break;
+            }
+        }
+    }
+
+    // Member with nil value is skipped
+    bool SkipNil() {
+        if (inStream.full() || *inStream != msgpack_format::nil) return false;
+        ++inStream;
+        return true;
+    }
+
+public:
+    template <typename T>
+    void SerializeIn(T &value) {
+        if (Failed()) return;
+        if constexpr (std::is_same_v<bool, T>) {
+            SerializeInBool(value);
+        } else if constexpr (std::is_same_v<char, T>) {
+            SerializeInChar(value);
+        } else if constexpr (std::integral<T>) {
+            SerializeInInteger(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> integer { };
+            SerializeInInteger(integer);
+            value = static_cast<T>(integer);
+        } else if constexpr (std::floating_point<T>) {
+            SerializeInFloatingPoint(value);
+        } else if constexpr (typecheck::string<T>) {
+            const auto str = ReadStringView();
+            if (!Failed()) value.assign(str);
+        } else if constexpr (typecheck::inline_string<T>) {
+            const auto str = ReadStringView(T::static_capacity);
+            if (!Failed()) value.assign(str);
+        } else if constexpr (typecheck::SerializerOutEnabledPtr<T, MsgpackIn>) {
+            value->SerializeIn(*this);
+        } else if constexpr (typecheck::SerializerOutEnabled<T, MsgpackIn>) {
+            value.SerializeIn(*this);
+        } else if constexpr (typecheck::vector<T> || typecheck::inline_vector<T>) {
+            ListDecoder<T, DECODE_MODE> decoder { value };
+            ListSerializeIn(decoder);
+        } else if constexpr (typecheck::map<T>) {
+            SerializeInMap(value);
+        } else Fail(ErrorKind::BadType);
+    }
+
+    // Reads list element by element into decoder, see ListDecoder and ListStream
+    void ListSerializeIn(auto &decoder) {
+        const size_t size = ReadArraySize();
+        for (size_t i = 0; i < size && !Failed(); ++i) {
+            if (decoder.Full()) return Fail(ErrorKind::CapacityExceeded, "Array exceeds inline capacity");
+            decoder.Read([this](auto &element) {
+                SerializeIn(element);
+                return !Failed();
+            });
+        }
+        decoder.Finish();
+    }
+
+    template <typename T>
+    void SkipIn() {
+        if (Failed()) return;
+        SkipValue();
+    }
+
+    // Validation walks input against schema, nothing is allocated
+    template <typename T>
+    void ValidateIn() {
+        if (Failed()) return;
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            T value { };
+            SerializeIn(value);
+        } else if constexpr (typecheck::string<T>) {
+            ValidateString(std::numeric_limits<size_t>::max());
+        } else if constexpr (typecheck::inline_string<T>) {
+            ValidateString(T::static_capacity);
+        } else if constexpr (typecheck::ValidateEnabled<T, MsgpackIn>) {
+            T::ValidateIn(*this);
+        } else if constexpr (typecheck::vector<T> || typecheck::inline_vector<T>) {
+            const size_t size = ReadArraySize();
+            if constexpr (typecheck::inline_vector<T>) {
+                if (size > T::static_capacity) return Fail(ErrorKind::CapacityExceeded, "Array exceeds inline capacity");
+            }
+            for (size_t i = 0; i < size && !Failed(); ++i) ValidateIn<typename T::value_type>();
+        } else if constexpr (typecheck::map<T>) {
+            const size_t size = ReadMapSize();
+            for (size_t i = 0; i < size && !Failed(); ++i) {
+                ValidateIn<typename T::key_type>();
+                ValidateIn<typename T::mapped_type>();
+            }
+        } else Fail(ErrorKind::BadType);
+    }
+
+    // Enum member is written as its name
+    template <typename T>
+    void ValidateEnumName() {
+        const auto name = ReadStringView();
+        T value { };
+        if (!Failed() && !from_string(name, value)) Fail(ErrorKind::BadValue, "Bad Enum Name");
+    }
+
+    template <typename T>
+    void StructValidateIn() {
+        if (Failed() || !this->EnterNested()) return;
+        const size_t size = ReadMapSize();
+        for (size_t i = 0; i < size && !Failed(); ++i) {
+            const auto key = ReadStringView();
+            if (Failed() || SkipNil()) continue;
+            T::ValidateMemberByName(*this, key);
+        }
+        this->LeaveNested();
+    }
+
+    template <typename T>
+    void StructSerializeIn(T *obj) {
+        StructSerializeIn(obj, AllFields { });
+    }
+
+    template <typename T>
+    void StructSerializeIn(T *obj, const auto &selector)
+    {
+        if (Failed()) return;
+        if constexpr (DECODE_MODE == DecodeMode::Reuse) {
+            ResetTrivialMembers(*obj);
+            FieldRecorder<T, std::remove_cvref_t<decltype(selector)>> recorder { selector };
+            StructSerializeInMembers(obj, recorder);
+            ResetAbsentMembers(*obj, recorder);
+        } else StructSerializeInMembers(obj, selector);
+    }
+
+    template <typename T>
+    void StructSerializeInMembers(T *obj, const auto &selector)
+    {
+        const size_t size = ReadMapSize();
+        for (size_t i = 0; i < size && !Failed(); ++i) {
+            const auto key = ReadStringView();
+            if (Failed() || SkipNil()) continue;
+            obj->SerializeInMemberByName(*this, key, selector);
+        }
+    }
+}; // class MsgpackIn
+
+template <>
+class msgpack<SerializeType::In> : public MsgpackIn<> {
+public:
+    using MsgpackIn<>::MsgpackIn;
+};
+
+// Integers are written in smallest format holding value. Member count of object is known only at
+// its end, one byte of map header is reserved and widened if object has more than 15 members,
+// hence output stream of object must be rohit::FullStream.
+template <EncodeMode ENCODE_MODE = EncodeMode::Default>
+class MsgpackOut {
+public:
+    constexpr static SerializeKeyType serialize_key_type = SerializeKeyType::String;
+    constexpr static bool pack_bits = false; // Packed members are written individually
+    constexpr static EncodeMode encode_mode = ENCODE_MODE;
+
+protected:
+    Stream &outStream;
+    FullStream * const fullStream;
+    size_t structOffset { 0 }; // Offset of map header of current object
+    uint32_t structCount { 0 };
+
+public:
+    MsgpackOut(Stream &outStream) : outStream { outStream }, fullStream { dynamic_cast<FullStream *>(&outStream) } { }
+    MsgpackOut(const MsgpackOut &) = delete;
+    MsgpackOut &operator=(const MsgpackOut &) = delete;
+
+    const auto &GetStream() { return outStream; }
+    auto &GetStream() const { return outStream; }
+
+private:
+    template <typename T>
+    void WriteBigEndian(const uint8_t type, const T value) {
+        outStream.Reserve(1 + sizeof(T));
+        *outStream.curr()++ = type;
+        const T bigEndian = ChangeEndian<std::endian::native, std::endian::big>(value);
+        std::memcpy(outStream.curr(), &bigEndian, sizeof(T));
+        outStream.curr() += sizeof(T);
+    }
+
+    void WriteHeader(const size_t size, const uint8_t fixType, const size_t fixLimit, const uint8_t type16, const uint8_t type32) {
+        if (size < fixLimit) outStream.Append(static_cast<uint8_t>(fixType | size));
+        else if (size <= 0xffff) WriteBigEndian(type16, static_cast<uint16_t>(size));
+        else if (size <= 0xffffffff) WriteBigEndian(type32, static_cast<uint32_t>(size));
+        else ROHIT_THROW(exception::BadType { outStream, "Too many entries" });
+    }
+
+    void WriteStringHeader(const size_t size) {
+        if (size >= 32 && size <= 0xff) WriteBigEndian(msgpack_format::str8, static_cast<uint8_t>(size));
+        else WriteHeader(size, msgpack_format::fixstr, 32, msgpack_format::str16, msgpack_format::str32);
+    }
+
+    void WriteArrayHeader(const size_t size) {
+        WriteHeader(size, msgpack_format::fixarray, 16, msgpack_format::array16, msgpack_format::array32);
+    }
+
+    // Header reserved at offset holds fix format, it is widened by moving entries written after it
+    void FinishHeader(const size_t offset, const size_t size, const uint8_t fixType, const uint8_t type16, const uint8_t type32) {
+        if (size < 16) {
+            fullStream->begin()[offset] = static_cast<uint8_t>(fixType | size);
+            return;
+        }
+        const size_t width { size <= 0xffff ? sizeof(uint16_t) : sizeof(uint32_t) };
+        outStream.Reserve(width);
+        uint8_t *header { fullStream->begin() + offset };
+        std::memmove(header + 1 + width, header + 1, fullStream->CurrentOffset() - offset - 1);
+        outStream.curr() += width;
+        if (width == sizeof(uint16_t)) {
+            header[0] = type16;
+            const uint16_t bigEndian = ChangeEndian<std::endian::native, std::endian::big>(static_cast<uint16_t>(size));
+            std::memcpy(header + 1, &bigEndian, sizeof(bigEndian));
+        } else {
+            header[0] = type32;
+            const uint32_t bigEndian = ChangeEndian<std::endian::native, std::endian::big>(static_cast<uint32_t>(size));
+            std::memcpy(header + 1, &bigEndian, sizeof(bigEndian));
+        }
+    }
+
+    size_t ReserveHeader() {
+        if (!fullStream) ROHIT_THROW(exception::BadType { outStream, "MessagePack object needs full stream" });
+        const size_t offset { fullStream->CurrentOffset() };
+        outStream.Append(static_cast<uint8_t>(0));
+        return offset;
+    }
+
+    void SerializeOutUnsigned(const uint64_t value) {
+        if (value <= msgpack_format::positive_fixint_max) outStream.Append(static_cast<uint8_t>(value));
+        else if (value <= std::numeric_limits<uint8_t>::max()) WriteBigEndian(msgpack_format::uint8, static_cast<uint8_t>(value));
+        else if (value <= std::numeric_limits<uint16_t>::max()) WriteBigEndian(msgpack_format::uint16, static_cast<uint16_t>(value));
+        else if (value <= std::numeric_limits<uint32_t>::max()) WriteBigEndian(msgpack_format::uint32, static_cast<uint32_t>(value));
+        else WriteBigEndian(msgpack_format::uint64, value);
+    }
+
+    void SerializeOutSigned(const int64_t value) {
+        if (value >= 0) SerializeOutUnsigned(static_cast<uint64_t>(value));
+        else if (value >= -32) outStream.Append(static_cast<uint8_t>(value));
+        else if (value >= std::numeric_limits<int8_t>::min()) WriteBigEndian(msgpack_format::int8, static_cast<uint8_t>(value));
+        else if (value >= std::numeric_limits<int16_t>::min()) WriteBigEndian(msgpack_format::int16, static_cast<uint16_t>(value));
+        else if (value >= std::numeric_limits<int32_t>::min()) WriteBigEndian(msgpack_format::int32, static_cast<uint32_t>(value));
+        else WriteBigEndian(msgpack_format::int64, static_cast<uint64_t>(value));
+    }
+
+    void SerializeOutString(const std::string_view value) {
+        WriteStringHeader(value.size());
+        outStream.Append(value);
+    }
+
+    // Nested object has its own header and count, those of enclosing object are restored after it
+    void SerializeOutObject(const auto &value) {
+        const size_t offset { structOffset };
+        const uint32_t count { structCount };
+        value.SerializeOut(*this);
+        structOffset = offset;
+        structCount = count;
+    }
+
+public:
+    template <typename T>
+    void SerializeOut(const T &value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            outStream.Append(value ? msgpack_format::true_value : msgpack_format::false_value);
+        } else if constexpr (std::is_same_v<T, char>) {
+            SerializeOutString(std::string_view { &value, 1 });
+        } else if constexpr (std::unsigned_integral<T>) {
+            SerializeOutUnsigned(value);
+        } else if constexpr (std::signed_integral<T>) {
+            SerializeOutSigned(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            if constexpr (std::is_signed_v<std::underlying_type_t<T>>) SerializeOutSigned(static_cast<std::underlying_type_t<T>>(value));
+            else SerializeOutUnsigned(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_same_v<T, float>) {
+            WriteBigEndian(msgpack_format::float32, std::bit_cast<uint32_t>(value));
+        } else if constexpr (std::floating_point<T>) {
+            WriteBigEndian(msgpack_format::float64, std::bit_cast<uint64_t>(static_cast<double>(value)));
+        } else if constexpr (typecheck::string<T> || std::is_same_v<T, std::string_view>) {
+            SerializeOutString(value);
+        } else if constexpr (typecheck::inline_string<T>) {
+            SerializeOutString(value.view());
+        } else if constexpr (typecheck::SerializerOutEnabledPtr<T, msgpack<SerializeType::Out>>) {
+            SerializeOutObject(*value);
+        } else if constexpr (typecheck::SerializerOutEnabled<T, msgpack<SerializeType::Out>>) {
+            SerializeOutObject(value);
+        } else if constexpr (typecheck::vector<T> || typecheck::inline_vector<T>) {
+            WriteArrayHeader(value.size());
+            for (const auto &item : value) SerializeOut(item);
+        } else if constexpr (typecheck::range_list<T>) {
+            SerializeOutRange(value.range);
+        } else if constexpr (typecheck::parallel_list<T>) {
+            WriteArrayHeader(value.list.size());
+            SerializeOutChunks<MsgpackOut>(outStream, value, [](auto &) { });
+        } else if constexpr (typecheck::map<T>) {
+            WriteHeader(value.size(), msgpack_format::fixmap, 16, msgpack_format::map16, msgpack_format::map32);
+            for (const auto &item : value) {
+                SerializeOut(item.first);
+                SerializeOut(item.second);
+            }
+        } else {
+            ROHIT_THROW(exception::UnknownSerializationType { outStream, "Unknown Serialization Type" });
+        }
+    }
+
+    template <typecheck::functions T>
+    void SerializeOut(const T &value) {
+        value(outStream);
+    }
+
+    // Count of unsized range is known only at its end, its header is reserved and widened later
+    void SerializeOutRange(std::ranges::input_range auto &range) {
+        if constexpr (std::ranges::sized_range<decltype(range)>) {
+            WriteArrayHeader(std::ranges::size(range));
+            for (auto &&item : range) SerializeOut(item);
+        } else {
+            const size_t offset { ReserveHeader() };
+            size_t count { 0 };
+            for (auto &&item : range) {
+                SerializeOut(item);
+                ++count;
+            }
+            FinishHeader(offset, count, msgpack_format::fixarray, msgpack_format::array16, msgpack_format::array32);
+        }
+    }
+
+    void StructSerializeOutStart() {
+        structOffset = ReserveHeader();
+        structCount = 0;
+    }
+
+    void StructSerializeOutStart(const auto &value) {
+        StructSerializeOutStart();
+        StructSerializeOut(value);
+    }
+
+    // Member is pair of name and value
+    void StructSerializeOut(const auto &value) {
+        ++structCount;
+        SerializeOut(value.first);
+        SerializeOut(value.second);
+    }
+
+    void StructSerializeOutEnd() {
+        FinishHeader(structOffset, structCount, msgpack_format::fixmap, msgpack_format::map16, msgpack_format::map32);
+    }
+}; // class MsgpackOut
+
+template <>
+class msgpack<SerializeType::Out> : public MsgpackOut<> {
+public:
+    using MsgpackOut<>::MsgpackOut;
+};
+
+template <SerializeType type>
+using msgpack_sparse = std::conditional_t<type == SerializeType::In, msgpack<SerializeType::In>, MsgpackOut<EncodeMode::Sparse>>;
+
+template <SerializeType type>
+using msgpack_reuse = std::conditional_t<type == SerializeType::In, MsgpackIn<DecodeMode::Reuse>, msgpack<SerializeType::Out>>;
+
+} // namespace rohit::serializer
@@ -0,0 +1,162 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <rohit/config.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rohit {
+
+// Fixed size pool, each worker has its own queue and takes work from queue of other
+// workers when its own is empty. Thread calling ParallelFor works on tasks till all are done.
+class ThreadPool {
+    struct Job {
+        const std::function<void(size_t)> &function;
+        std::atomic<size_t> remaining;
+        std::mutex exceptionMutex { };
+        std::exception_ptr exception { };
+
+        Job(const std::function<void(size_t)> &function, const size_t count) : function { function }, remaining { count } { }
+    };
+
+    struct Task {
+        Job *job { nullptr };
+        size_t index { 0 };
+    };
+
+    struct Queue {
+        std::mutex mutex { };
+        std::deque<Task> tasks { };
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues { };
+    std::vector<std::thread> workers { };
+    std::mutex mutex { };
+    std::condition_variable wakeup { };
+    std::condition_variable done { };
+    std::atomic<size_t> pending { 0 };
+    bool stop { false };
+
+    // Own queue is used from back, other queues are stolen from front
+    bool TryTake(const size_t self, Task &task) {
+        for(size_t offset { 0 }; offset < queues.size(); ++offset) {
+            auto &queue = *queues[(self + offset) % queues.size()];
+            std::lock_guard lock { queue.mutex };
+            if (queue.tasks.empty()) continue;
+            if (offset == 0) {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            } else {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            --pending;
+            return true;
+        }
+        return false;
+    }
+
+    void Execute(const Task &task) {
+#if ROHIT_EXCEPTIONS
+        try {
+            task.job->function(task.index);
+        } catch(...) {
+            std::lock_guard lock { task.job->exceptionMutex };
+            if (!task.job->exception) task.job->exception = std::current_exception();
+        }
+#else
+        task.job->function(task.index);
+#endif
+        if (task.job->remaining.fetch_sub(1) == 1) {
+            std::lock_guard lock { mutex };
+            done.notify_all();
+        }
+    }
+
+    void Run(const size_t self) {
+        while(true) {
+            Task task { };
+            if (TryTake(self, task)) {
+                Execute(task);
+                continue;
+            }
+            std::unique_lock lock { mutex };
+            wakeup.wait(lock, [this]() { return stop || pending > 0; });
+            if (stop) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(const size_t threadCount = std::thread::hardware_concurrency()) {
+        const size_t count { threadCount ? threadCount : 1 };
+        for(size_t index { 0 }; index < count; ++index) queues.push_back(std::make_unique<Queue>());
+        for(size_t index { 0 }; index < count; ++index) workers.emplace_back([this, index]() { Run(index); });
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock { mutex };
+            stop = true;
+        }
+        wakeup.notify_all();
+        for(auto &worker: workers) worker.join();
+    }
+
+    size_t Size() const { return workers.size(); }
+
+    // Calls function for each index in [0, count), first exception thrown by function is rethrown
+    void ParallelFor(const size_t count, const std::function<void(size_t)> &function) {
+        if (count == 0) return;
+        Job job { function, count };
+        // Counted before queued so that taking a task never brings pending below zero
+        {
+            std::lock_guard lock { mutex };
+            pending += count;
+        }
+        for(size_t index { 0 }; index < count; ++index) {
+            auto &queue = *queues[index % queues.size()];
+            std::lock_guard lock { queue.mutex };
+            queue.tasks.push_back({ &job, index });
+        }
+        wakeup.notify_all();
+
+        while(job.remaining > 0) {
+            Task task { };
+            if (TryTake(0, task)) {
+                Execute(task);
+                continue;
+            }
+            std::unique_lock lock { mutex };
+            done.wait(lock, [&job]() { return job.remaining == 0; });
+        }
+        if (job.exception) std::rethrow_exception(job.exception);
+    }
+}; // class ThreadPool
+
+} // namespace rohit
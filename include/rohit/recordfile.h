@@ -0,0 +1,265 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+// Record file is records written back to back followed by index of record offsets and
+// optional key table. Integers are big endian as in binary protocol.
+//
+//  header  | "RSRF" | version (1 byte) | flags (1 byte) | 0 (2 bytes) |
+//  record  | size (binary variable size) | record | CRC32C of record (4 bytes, with Checksum flag) |
+//  offsets | offset of each record from begin of file (8 bytes each) |
+//  keys    | key entry sorted by key: key offset in key data (8 bytes) | key size (4 bytes) | 0 (4 bytes) | record index (8 bytes) |
+//  key data| keys back to back |
+//  trailer | record count (8) | offsets offset (8) | key count (8) | keys offset (8) | "RSRI" |
+
+#pragma once
+#include <rohit/checksum.h>
+#include <rohit/serializer.h>
+#include <rohit/stream.h>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rohit::serializer {
+
+namespace recordfile {
+constexpr uint8_t version { 1 };
+constexpr size_t header_size { 8 };
+constexpr size_t key_entry_size { 24 };
+constexpr size_t trailer_size { 36 };
+
+enum class Flags : uint8_t {
+    None = 0,
+    Checksum = 1,
+    Keys = 2
+};
+
+constexpr Flags operator|(const Flags first, const Flags second) { return static_cast<Flags>(static_cast<uint8_t>(first) | static_cast<uint8_t>(second)); }
+constexpr bool HasFlag(const Flags flags, const Flags flag) { return (static_cast<uint8_t>(flags) & static_cast<uint8_t>(flag)) != 0; }
+
+template <std::unsigned_integral T>
+inline void StoreBig(uint8_t *data, const T value) {
+    const T bigEndian = ChangeEndian<std::endian::native, std::endian::big>(value);
+    std::memcpy(data, &bigEndian, sizeof(T));
+}
+
+template <std::unsigned_integral T>
+inline T LoadBig(const uint8_t *data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return ChangeEndian<std::endian::big, std::endian::native>(value);
+}
+} // namespace recordfile
+
+// Writes records to stream or std::ostream, Finish writes index and must be called once after last record
+template <template<SerializeType> class SerializerProtocol>
+class RecordFileWriter {
+    struct KeyEntry {
+        std::string key;
+        uint64_t recordIndex;
+    };
+
+    Stream *stream;
+    std::ostream *file;
+    const recordfile::Flags flags;
+    uint64_t offset { 0 };
+    std::vector<uint64_t> offsets { };
+    std::vector<KeyEntry> keys { };
+    FullStreamAutoAlloc scratch { 256 };
+    bool finished { false };
+
+    void Emit(const uint8_t *data, const size_t size) {
+        if (stream) stream->Append(data, size);
+        else file->write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+        offset += size;
+    }
+
+    template <std::unsigned_integral T>
+    void EmitBig(const T value) {
+        uint8_t data[sizeof(T)];
+        recordfile::StoreBig(data, value);
+        Emit(data, sizeof(T));
+    }
+
+    void WriteHeader() {
+        const uint8_t header[recordfile::header_size] { 'R', 'S', 'R', 'F', recordfile::version, static_cast<uint8_t>(flags), 0, 0 };
+        Emit(header, sizeof(header));
+    }
+
+public:
+    RecordFileWriter(Stream &stream, const recordfile::Flags flags = recordfile::Flags::None)
+            : stream { &stream }, file { nullptr }, flags { flags } { WriteHeader(); }
+    RecordFileWriter(std::ostream &file, const recordfile::Flags flags = recordfile::Flags::None)
+            : stream { nullptr }, file { &file }, flags { flags } { WriteHeader(); }
+    RecordFileWriter(const RecordFileWriter &) = delete;
+    RecordFileWriter &operator=(const RecordFileWriter &) = delete;
+
+    uint64_t Count() const { return offsets.size(); }
+
+    void Write(const auto &value) {
+        if (finished) ROHIT_THROW(std::logic_error { "Record file is finished" });
+        scratch.Reset();
+        value.template SerializeOut<SerializerProtocol>(scratch);
+        const size_t size { scratch.CurrentOffset() };
+        if (size > 0x3fffffff) ROHIT_THROW(std::length_error { "Record too large" });
+
+        offsets.push_back(offset);
+        uint8_t sizeData[4];
+        FullStream sizeStream { sizeData, sizeof(sizeData) };
+        binaryOutBase<SerializeKeyType::None> { sizeStream }.SerializeOutVariable(size);
+        Emit(sizeData, sizeStream.CurrentOffset());
+        Emit(scratch.begin(), size);
+        if (recordfile::HasFlag(flags, recordfile::Flags::Checksum)) EmitBig(Crc32c(scratch.begin(), size));
+    }
+
+    // Record can be found by key, more than one record can have same key
+    void Write(const auto &value, const std::string_view key) {
+        if (!recordfile::HasFlag(flags, recordfile::Flags::Keys)) ROHIT_THROW(std::logic_error { "Record file is without keys" });
+        if (key.size() > 0xffffffff) ROHIT_THROW(std::length_error { "Key too large" });
+        Write(value);
+        keys.push_back({ std::string { key }, offsets.size() - 1 });
+    }
+
+    void Finish() {
+        if (finished) return;
+        finished = true;
+        const uint64_t offsetsOffset { offset };
+        for(const auto recordOffset: offsets) EmitBig(recordOffset);
+
+        const uint64_t keysOffset { offset };
+        std::stable_sort(keys.begin(), keys.end(), [](const KeyEntry &first, const KeyEntry &second) { return first.key < second.key; });
+        uint64_t keyDataOffset { 0 };
+        for(const auto &entry: keys) {
+            EmitBig(keyDataOffset);
+            EmitBig(static_cast<uint32_t>(entry.key.size()));
+            EmitBig(uint32_t { 0 });
+            EmitBig(entry.recordIndex);
+            keyDataOffset += entry.key.size();
+        }
+        for(const auto &entry: keys) Emit(reinterpret_cast<const uint8_t *>(entry.key.data()), entry.key.size());
+
+        EmitBig(static_cast<uint64_t>(offsets.size()));
+        EmitBig(offsetsOffset);
+        EmitBig(static_cast<uint64_t>(keys.size()));
+        EmitBig(keysOffset);
+        const uint8_t magic[] { 'R', 'S', 'R', 'I' };
+        Emit(magic, sizeof(magic));
+    }
+}; // class RecordFileWriter
+
+// Reads record file in place, for example mapped by MakeMappedStreamFromFile. Record is found
+// in O(1) from offset index, key by binary search. Buffer must outlive reader.
+class RecordFile {
+    const FullStream buffer;
+    recordfile::Flags flags { recordfile::Flags::None };
+    uint64_t count { 0 };
+    uint64_t offsetsOffset { 0 };
+    uint64_t keyCount { 0 };
+    uint64_t keysOffset { 0 };
+    uint64_t keyDataOffset { 0 };
+
+    [[noreturn]] void Fail(const size_t position, [[maybe_unused]] const char *message) const {
+        const auto failStream = MakeConstantFullStream(buffer.begin(), buffer.end(), buffer.begin() + position);
+        ROHIT_THROW(exception::BadInputData { failStream, message });
+    }
+
+    const uint8_t *At(const uint64_t position) const { return buffer.begin() + position; }
+
+    std::string_view KeyAt(const uint64_t keyIndex) const {
+        const uint8_t *entry { At(keysOffset + keyIndex * recordfile::key_entry_size) };
+        const auto keyOffset = recordfile::LoadBig<uint64_t>(entry);
+        const auto keySize = recordfile::LoadBig<uint32_t>(entry + 8);
+        const uint64_t keyDataSize { buffer.Capacity() - recordfile::trailer_size - keyDataOffset };
+        if (keyOffset > keyDataSize || keySize > keyDataSize - keyOffset) {
+            Fail(keysOffset + keyIndex * recordfile::key_entry_size, "Key is beyond key data");
+        }
+        return { reinterpret_cast<const char *>(At(keyDataOffset + keyOffset)), keySize };
+    }
+
+public:
+    RecordFile(const FullStream &source) : buffer { MakeConstantFullStream(source.begin(), source.end()) } {
+        const size_t size { buffer.Capacity() };
+        if (size < recordfile::header_size + recordfile::trailer_size
+                || std::string_view { reinterpret_cast<const char *>(At(0)), 4 } != "RSRF"
+                || std::string_view { reinterpret_cast<const char *>(At(size - 4)), 4 } != "RSRI") {
+            Fail(0, "Not a record file");
+        }
+        if (*At(4) != recordfile::version) Fail(4, "Unsupported record file version");
+        flags = static_cast<recordfile::Flags>(*At(5));
+
+        const uint8_t *trailer { At(size - recordfile::trailer_size) };
+        count = recordfile::LoadBig<uint64_t>(trailer);
+        offsetsOffset = recordfile::LoadBig<uint64_t>(trailer + 8);
+        keyCount = recordfile::LoadBig<uint64_t>(trailer + 16);
+        keysOffset = recordfile::LoadBig<uint64_t>(trailer + 24);
+        // Tables must follow each other within file, counts are checked before multiplying
+        const uint64_t tableEnd { size - recordfile::trailer_size };
+        if (offsetsOffset < recordfile::header_size || offsetsOffset > tableEnd || count > (tableEnd - offsetsOffset) / 8
+                || keysOffset != offsetsOffset + count * 8 || keyCount > (tableEnd - keysOffset) / recordfile::key_entry_size) {
+            Fail(size - recordfile::trailer_size, "Bad record file index");
+        }
+        keyDataOffset = keysOffset + keyCount * recordfile::key_entry_size;
+    }
+
+    RecordFile(const RecordFile &) = delete;
+    RecordFile &operator=(const RecordFile &) = delete;
+
+    uint64_t Count() const { return count; }
+    uint64_t KeyCount() const { return keyCount; }
+
+    // Encoded record n, checksum is verified when file has it
+    const FullStream Record(const uint64_t index) const {
+        if (index >= count) ROHIT_THROW(std::out_of_range { "Record index out of range" });
+        const auto recordOffset = recordfile::LoadBig<uint64_t>(At(offsetsOffset + index * 8));
+        if (recordOffset < recordfile::header_size || recordOffset >= offsetsOffset) Fail(offsetsOffset + index * 8, "Record offset is beyond records");
+
+        const auto recordStream = MakeConstantFullStream(At(recordOffset), At(offsetsOffset));
+        binaryInBase<SerializeKeyType::None> serializerProtocol { recordStream };
+        const size_t size = serializerProtocol.SerializeInVariable();
+        const size_t checksumSize { recordfile::HasFlag(flags, recordfile::Flags::Checksum) ? sizeof(uint32_t) : 0 };
+        if (recordStream.RemainingBuffer() < size + checksumSize) Fail(recordOffset, "Record is beyond records");
+        const uint8_t *data { recordStream.curr() };
+        if (checksumSize && Crc32c(data, size) != recordfile::LoadBig<uint32_t>(data + size)) Fail(recordOffset, "Record checksum mismatch");
+        return MakeConstantFullStream(data, size);
+    }
+
+    template <typename T, template<SerializeType> class SerializerProtocol>
+    T Get(const uint64_t index) const {
+        T value { };
+        value.template SerializeIn<SerializerProtocol>(Record(index));
+        return value;
+    }
+
+    // Index of first record with key
+    std::optional<uint64_t> Find(const std::string_view key) const {
+        uint64_t low { 0 }, high { keyCount };
+        while(low < high) {
+            const uint64_t middle { low + (high - low) / 2 };
+            if (KeyAt(middle) < key) low = middle + 1;
+            else high = middle;
+        }
+        if (low == keyCount || KeyAt(low) != key) return std::nullopt;
+        const auto recordIndex = recordfile::LoadBig<uint64_t>(At(keysOffset + low * recordfile::key_entry_size + 16));
+        if (recordIndex >= count) Fail(keysOffset + low * recordfile::key_entry_size, "Key record index out of range");
+        return recordIndex;
+    }
+}; // class RecordFile
+
+} // namespace rohit::serializer
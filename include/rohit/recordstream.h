@@ -0,0 +1,220 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <rohit/serializer.h>
+#include <rohit/stream.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace rohit::serializer {
+
+// Lines has one record per line, for example compact json. LengthPrefixed has size of record
+// in binary variable size encoding before each record.
+enum class RecordFormat {
+    Lines,
+    LengthPrefixed
+};
+
+// Any passes records to function from pool threads as they are decoded, Input passes them
+// from calling thread in order of input.
+enum class RecordOrder {
+    Any,
+    Input
+};
+
+// Returns first '\n', end when there is none. Scans 8 bytes per step, see FindQuoteOrNonAscii.
+inline const uint8_t *FindNewline(const uint8_t *begin, const uint8_t *end) {
+    while(end - begin >= 8) {
+        if (HasZeroByte(LoadWord(begin) ^ BroadcastByte('\n'))) break;
+        begin += 8;
+    }
+    while(begin != end && *begin != '\n') ++begin;
+    return begin;
+}
+
+// Writes one record at a time, each record is encoded in scratch buffer and then appended to stream
+template <template<SerializeType> class SerializerProtocol>
+class RecordWriter {
+    Stream &stream;
+    const RecordFormat format;
+    FullStreamAutoAlloc scratch { 256 };
+
+public:
+    RecordWriter(Stream &stream, const RecordFormat format) : stream { stream }, format { format } { }
+
+    // Record with newline in its output cannot be written as line, json writer does not escape it
+    void Write(const auto &value) {
+        scratch.Reset();
+        value.template SerializeOut<SerializerProtocol>(scratch);
+        const uint8_t *recordEnd { scratch.begin() + scratch.CurrentOffset() };
+        if (format == RecordFormat::Lines) {
+            if (FindNewline(scratch.begin(), recordEnd) != recordEnd) ROHIT_THROW(exception::BadType { stream, "Record has newline" });
+            stream.Append(scratch.begin(), scratch.CurrentOffset());
+            stream.WriteRaw(static_cast<uint8_t>('\n'));
+        } else {
+            if (scratch.CurrentOffset() > 0x3fffffff) ROHIT_THROW(exception::BadType { stream, "Record too large" });
+            binaryOutBase<SerializeKeyType::None> { stream }.SerializeOutVariable(scratch.CurrentOffset());
+            stream.Append(scratch.begin(), scratch.CurrentOffset());
+        }
+    }
+};
+
+// Splits buffer into chunks of whole records of about chunkSize bytes, chunks are decoded in
+// parallel on pool, which must have ParallelFor(count, function), see rohit::ThreadPool.
+// Buffer is not copied, it must outlive reader, see MakeMappedStreamFromFile.
+class RecordReader {
+    struct Chunk {
+        const uint8_t *begin;
+        const uint8_t *end;
+    };
+
+    const uint8_t * const begin;
+    const uint8_t * const end;
+    const RecordFormat format;
+    std::vector<Chunk> chunks { };
+
+    // Line chunk ends after first newline at or past chunkSize, hence it only has whole lines
+    void SplitLines(const size_t chunkSize) {
+        const uint8_t *chunkBegin { begin };
+        while(chunkBegin != end) {
+            const uint8_t *chunkEnd { chunkBegin + std::min<size_t>(chunkSize, end - chunkBegin) };
+            if (chunkEnd != end) {
+                chunkEnd = FindNewline(chunkEnd - 1, end);
+                if (chunkEnd != end) ++chunkEnd;
+            }
+            chunks.push_back({ chunkBegin, chunkEnd });
+            chunkBegin = chunkEnd;
+        }
+    }
+
+    // Record sizes are read once here, records are then decoded in parallel
+    void SplitLengthPrefixed(const size_t chunkSize) {
+        const auto inStream = MakeConstantFullStream(begin, end);
+        binaryInBase<SerializeKeyType::None> serializerProtocol { inStream };
+        const uint8_t *chunkBegin { begin };
+        while(!inStream.full()) {
+            const size_t size = serializerProtocol.SerializeInVariable();
+            if (inStream.RemainingBuffer() < size) ROHIT_THROW(exception::BadInputData { inStream, "Record size is beyond end" });
+            inStream += size;
+            if (static_cast<size_t>(inStream.curr() - chunkBegin) >= chunkSize) {
+                chunks.push_back({ chunkBegin, inStream.curr() });
+                chunkBegin = inStream.curr();
+            }
+        }
+        if (chunkBegin != end) chunks.push_back({ chunkBegin, end });
+    }
+
+    // Calls function with each record of chunk, blank lines are skipped
+    void ForEachRecordOfChunk(const Chunk &chunk, auto &&function) const {
+        if (format == RecordFormat::Lines) {
+            const uint8_t *recordBegin { chunk.begin };
+            while(recordBegin != chunk.end) {
+                const uint8_t *recordEnd { FindNewline(recordBegin, chunk.end) };
+                const uint8_t *contentEnd { recordEnd != recordBegin && recordEnd[-1] == '\r' ? recordEnd - 1 : recordEnd };
+                if (contentEnd != recordBegin) function(MakeConstantFullStream(recordBegin, contentEnd));
+                recordBegin = recordEnd == chunk.end ? recordEnd : recordEnd + 1;
+            }
+        } else {
+            const auto inStream = MakeConstantFullStream(chunk.begin, chunk.end);
+            binaryInBase<SerializeKeyType::None> serializerProtocol { inStream };
+            while(!inStream.full()) {
+                const size_t size = serializerProtocol.SerializeInVariable();
+                function(MakeConstantFullStream(inStream.curr(), size));
+                inStream += size;
+            }
+        }
+    }
+
+    template <typename T, template<SerializeType> class SerializerProtocol>
+    std::vector<T> DecodeChunk(const Chunk &chunk) const {
+        std::vector<T> records { };
+        ForEachRecordOfChunk(chunk, [&records](const Stream &recordStream) {
+            records.emplace_back().template SerializeIn<SerializerProtocol>(recordStream);
+        });
+        return records;
+    }
+
+public:
+    RecordReader(const uint8_t *begin, const uint8_t *end, const RecordFormat format, const size_t chunkSize = 1 << 20)
+            : begin { begin }, end { end }, format { format } {
+        if (format == RecordFormat::Lines) SplitLines(std::max<size_t>(chunkSize, 1));
+        else SplitLengthPrefixed(std::max<size_t>(chunkSize, 1));
+    }
+
+    RecordReader(const FullStream &stream, const RecordFormat format, const size_t chunkSize = 1 << 20)
+            : RecordReader { stream.begin(), stream.end(), format, chunkSize } { }
+
+    RecordReader(const RecordReader &) = default;
+    RecordReader &operator=(const RecordReader &) = delete;
+
+    size_t ChunkCount() const { return chunks.size(); }
+
+    // Records of each chunk in order of input, concatenating them gives all records in order
+    template <typename T, template<SerializeType> class SerializerProtocol>
+    std::vector<std::vector<T>> ReadChunks(auto &pool) const {
+        std::vector<std::vector<T>> records(chunks.size());
+        pool.ParallelFor(chunks.size(), [this, &records](const size_t chunk) {
+            records[chunk] = DecodeChunk<T, SerializerProtocol>(chunks[chunk]);
+        });
+        return records;
+    }
+
+    template <typename T, template<SerializeType> class SerializerProtocol>
+    std::vector<T> Read(auto &pool) const {
+        auto chunkRecords = ReadChunks<T, SerializerProtocol>(pool);
+        size_t count { 0 };
+        for(auto &records: chunkRecords) count += records.size();
+        std::vector<T> allRecords { };
+        allRecords.reserve(count);
+        for(auto &records: chunkRecords) std::move(records.begin(), records.end(), std::back_inserter(allRecords));
+        return allRecords;
+    }
+
+    // Function is called with each record as rvalue. With RecordOrder::Any it is called concurrently
+    // from pool threads. With RecordOrder::Input window of chunks is decoded in parallel and records
+    // are passed in order from calling thread, memory used is bounded by window.
+    template <typename T, template<SerializeType> class SerializerProtocol>
+    void ForEach(auto &pool, auto &&function, const RecordOrder order = RecordOrder::Any, const size_t window = 64) const {
+        if (order == RecordOrder::Any) {
+            pool.ParallelFor(chunks.size(), [this, &function](const size_t chunk) {
+                ForEachRecordOfChunk(chunks[chunk], [&function](const Stream &recordStream) {
+                    T record { };
+                    record.template SerializeIn<SerializerProtocol>(recordStream);
+                    function(std::move(record));
+                });
+            });
+            return;
+        }
+
+        const size_t windowSize { std::max<size_t>(window, 1) };
+        std::vector<std::vector<T>> records(std::min(windowSize, chunks.size()));
+        for(size_t first { 0 }; first < chunks.size(); first += windowSize) {
+            const size_t count { std::min(windowSize, chunks.size() - first) };
+            pool.ParallelFor(count, [this, &records, first](const size_t chunk) {
+                records[chunk] = DecodeChunk<T, SerializerProtocol>(chunks[first + chunk]);
+            });
+            for(size_t chunk { 0 }; chunk < count; ++chunk) {
+                for(auto &record: records[chunk]) function(std::move(record));
+                records[chunk].clear();
+            }
+        }
+    }
+}; // class RecordReader
+
+} // namespace rohit::serializer
@@ -17,6 +17,7 @@
 
 #pragma once
 #include <rohit/stream.h>
+#include <rohit/containers.h>
 #include <concepts>
 #include <type_traits>
 #include <cstdint>
@@ -24,9 +25,21 @@
 #include <functional>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <type_traits>
 #include <stdexcept>
 #include <string_view>
+#include <array>
+#include <initializer_list>
+#include <tuple>
+#include <string>
+#include <memory>
+#include <memory_resource>
+#include <bit>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <ranges>
 
 namespace rohit::serializer {
 namespace exception {
@@ -53,6 +66,15 @@ public:
 };
 } // namespace exception
 
+template <typename Range>
+struct RangeList;
+
+template <typename T, typename Pool>
+struct ParallelList;
+
+template <typename T>
+struct IndexedList;
+
 namespace typecheck {
 template <typename T, typename J>
 concept SerializerInEnabled = requires(T cls, J &serializeProtocol) {
@@ -69,19 +91,92 @@ concept SerializerOutEnabled = requires(T cls, J &serializeProtocol) {
     { cls.template SerializeOut<J>(serializeProtocol) } -> std::same_as<void>;
 };
 
+template <typename T, typename J>
+concept ValidateEnabled = requires(J &serializeProtocol) {
+    { T::ValidateIn(serializeProtocol) } -> std::same_as<void>;
+};
+
+template <typename T, typename J, typename W>
+concept TranscodeEnabled = requires(J &serializeProtocol, W &writer) {
+    { T::TranscodeIn(serializeProtocol, writer) } -> std::same_as<void>;
+};
+
+// Standard and std::pmr collections are accepted, any allocator is allowed
+template <typename T>
+concept string = requires {
+    typename T::allocator_type;
+    requires std::is_same_v<T, std::basic_string<char, std::char_traits<char>, typename T::allocator_type>>;
+};
+
 template <typename T>
 concept vector = requires(T t) {
     typename T::value_type;
-    requires std::is_same_v<T, std::vector<typename T::value_type>>;
+    typename T::allocator_type;
+    requires std::is_same_v<T, std::vector<typename T::value_type, typename T::allocator_type>>;
+};
+
+template <typename T>
+concept flat_map = requires {
+    typename T::key_type;
+    typename T::mapped_type;
+    typename T::container_type;
+    requires std::is_same_v<T, rohit::flat_map<typename T::key_type, typename T::mapped_type, std::less<typename T::key_type>, typename T::container_type>>;
 };
 
 template <typename T>
 concept map = requires(T t) {
     typename T::key_type;
     typename T::mapped_type;
-    requires std::is_same_v<T, std::map<typename T::key_type, typename T::mapped_type>>;
+    typename T::allocator_type;
+    requires std::is_same_v<T, std::map<typename T::key_type, typename T::mapped_type, std::less<typename T::key_type>, typename T::allocator_type>>
+        || std::is_same_v<T, std::unordered_map<typename T::key_type, typename T::mapped_type, std::hash<typename T::key_type>,
+            std::equal_to<typename T::key_type>, typename T::allocator_type>>
+        || flat_map<T>;
+};
+
+template <typename T>
+concept range_list = requires {
+    typename T::range_type;
+    requires std::is_same_v<T, RangeList<typename T::range_type>>;
+};
+
+template <typename T>
+concept indexed_list = requires {
+    typename T::list_type;
+    requires std::is_same_v<T, IndexedList<typename T::list_type>>;
+};
+
+template <typename T>
+concept parallel_list = requires {
+    typename T::list_type;
+    typename T::pool_type;
+    requires std::is_same_v<T, ParallelList<typename T::list_type, typename T::pool_type>>;
+};
+
+template <typename T>
+concept inline_vector = requires {
+    typename T::value_type;
+    T::static_capacity;
+    requires std::is_same_v<T, rohit::inline_vector<typename T::value_type, T::static_capacity>>;
 };
 
+template <typename T>
+concept inline_string = requires {
+    T::static_capacity;
+    requires std::is_same_v<T, rohit::inline_string<T::static_capacity>>;
+};
+
+// Generated class
+template <typename T>
+concept object = requires {
+    { T::serialize_slot_count } -> std::convertible_to<uint32_t>;
+    T::GetDefaultObject();
+};
+
+// Value which is written as its own patch, see Patch
+template <typename T>
+concept patchable = object<T> || vector<T> || map<T>;
+
 template <typename T>
 concept functions = requires(T t) {
     requires std::is_same_v<T, void(Stream &)> || std::is_function_v<T> || std::is_same_v<T, std::function<void(Stream &)>>;
@@ -189,7 +284,8 @@ public:
 enum class SerializeKeyType {
     None,
     Integer,
-    String
+    String,
+    Bitmap // Presence bitmap followed by present members in order
 };
 
 enum class SerializeType {
@@ -197,34 +293,1006 @@ enum class SerializeType {
     Out
 };
 
-template <SerializeType type>
-class json { };
+enum class EncodeMode {
+    Default,
+    Sparse // Members equal to their default are not written
+};
+
+enum class DecodeMode {
+    Default, // Lists and maps are appended to
+    Reuse, // Existing elements, strings and map nodes are overwritten in place, members absent in input are reset
+    NoThrow // As Default, but first error is recorded and decoding stops without throwing
+};
+
+enum class ErrorKind : uint8_t {
+    None,
+    UnexpectedEnd, // Input ended before value
+    UnexpectedCharacter, // Syntax error
+    CapacityExceeded, // Inline string or array is too small for input
+    UnknownKey, // Member identifier, name, index or union type not known
+    BadValue, // Value cannot be converted
+    BadType, // Type is not supported by protocol
+    Stopped // Element function of streaming decode asked to stop
+};
+
+constexpr std::string_view to_string(const ErrorKind kind) {
+    switch(kind) {
+    default:
+    case ErrorKind::None: return "None";
+    case ErrorKind::UnexpectedEnd: return "UnexpectedEnd";
+    case ErrorKind::UnexpectedCharacter: return "UnexpectedCharacter";
+    case ErrorKind::CapacityExceeded: return "CapacityExceeded";
+    case ErrorKind::UnknownKey: return "UnknownKey";
+    case ErrorKind::BadValue: return "BadValue";
+    case ErrorKind::BadType: return "BadType";
+    case ErrorKind::Stopped: return "Stopped";
+    }
+}
+
+// Result of TrySerializeIn, true on success. Human readable text is built only when
+// Diagnostic is called, input stream is left at the failed location for it.
+class DecodeStatus {
+    ErrorKind kind { ErrorKind::None };
+    size_t offset { 0 }; // Offset of failure from start of decoding
+    const char *message { "" };
 
-template<>
-class json<SerializeType::In> {
 public:
-    constexpr static SerializeKeyType serialize_key_type = SerializeKeyType::String;
+    constexpr DecodeStatus() = default;
+    constexpr DecodeStatus(const ErrorKind kind, const size_t offset, const char *message)
+        : kind { kind }, offset { offset }, message { message } { }
+
+    constexpr bool has_value() const { return kind == ErrorKind::None; }
+    constexpr explicit operator bool() const { return has_value(); }
+    constexpr ErrorKind error() const { return kind; }
+    constexpr size_t Offset() const { return offset; }
+    constexpr std::string_view Message() const { return message; }
+
+    std::string Diagnostic(const Stream &stream) const {
+        std::string errorstr { to_string(kind) };
+        if (*message) {
+            errorstr += ": ";
+            errorstr += message;
+        }
+        return rohit::exception::BaseParser::CreateWhatString(stream, errorstr);
+    }
+};
+
+// Validation scans 8 bytes per step, word has high bit set in a byte for non ASCII
+// and zero byte of (word ^ Broadcast(ch)) finds ch.
+constexpr uint64_t BroadcastByte(const uint8_t value) { return 0x0101010101010101ULL * value; }
+
+inline uint64_t LoadWord(const uint8_t *data) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+constexpr bool HasZeroByte(const uint64_t word) { return (word - BroadcastByte(1)) & ~word & BroadcastByte(0x80); }
+
+// Returns first '"' or non ASCII byte, end when there is none. Backslash is not looked for,
+// JSON decoding ends string at first '"' and does not unescape.
+inline const uint8_t *FindQuoteOrNonAscii(const uint8_t *begin, const uint8_t *end) {
+    while(end - begin >= 8) {
+        const auto word = LoadWord(begin);
+        if (HasZeroByte(word ^ BroadcastByte('"')) || (word & BroadcastByte(0x80))) break;
+        begin += 8;
+    }
+    while(begin != end && *begin != '"' && *begin < 0x80) ++begin;
+    return begin;
+}
+
+// Validates one multi byte UTF-8 sequence, returns byte after it or nullptr when invalid
+inline const uint8_t *SkipUtf8Sequence(const uint8_t *begin, const uint8_t *end) {
+    const uint8_t lead = *begin;
+    size_t length { 0 };
+    uint8_t low { 0x80 }, high { 0xbf }; // Range of second byte, rejects overlong and surrogate
+    if (lead >= 0xc2 && lead <= 0xdf) length = 2;
+    else if (lead >= 0xe0 && lead <= 0xef) {
+        length = 3;
+        if (lead == 0xe0) low = 0xa0;
+        else if (lead == 0xed) high = 0x9f;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        if (lead == 0xf0) low = 0x90;
+        else if (lead == 0xf4) high = 0x8f;
+    } else return nullptr;
+    if (static_cast<size_t>(end - begin) < length) return nullptr;
+    if (begin[1] < low || begin[1] > high) return nullptr;
+    for(size_t index { 2 }; index < length; ++index) {
+        if ((begin[index] & 0xc0) != 0x80) return nullptr;
+    }
+    return begin + length;
+}
+
+inline bool IsValidUtf8(const uint8_t *begin, const uint8_t *end) {
+    while(begin != end) {
+        while(end - begin >= 8 && !(LoadWord(begin) & BroadcastByte(0x80))) begin += 8;
+        while(begin != end && *begin < 0x80) ++begin;
+        if (begin == end) break;
+        begin = SkipUtf8Sequence(begin, end);
+        if (!begin) return false;
+    }
+    return true;
+}
+
+// Stream and error handling shared by decoding protocols. Default and Reuse throw exception,
+// NoThrow keeps first error, decoding functions return as soon as Failed() is true.
+template <DecodeMode DECODE_MODE>
+class DecodeState {
+public:
+    constexpr static DecodeMode decode_mode = DECODE_MODE;
+    constexpr static uint32_t max_validate_depth { 64 };
 
 protected:
     const Stream &inStream;
+    const uint8_t * const start;
+    ErrorKind errorKind { ErrorKind::None };
+    const uint8_t *errorLocation { nullptr };
+    const char *errorMessage { "" };
+    uint32_t validateDepth { 0 };
+
+    // Validation of nested class, false when nesting is too deep
+    bool EnterNested() {
+        if (validateDepth == max_validate_depth) {
+            Fail(ErrorKind::BadValue, "Nesting too deep");
+            return false;
+        }
+        ++validateDepth;
+        return true;
+    }
+    void LeaveNested() { --validateDepth; }
 
 public:
-    json(const Stream &inStream) : inStream { inStream } { }
+    DecodeState(const Stream &inStream) : inStream { inStream }, start { inStream.curr() } { }
+    DecodeState(const DecodeState &) = delete;
+    DecodeState &operator=(const DecodeState &) = delete;
 
     const auto &GetStream() { return inStream; }
     auto &GetStream() const { return inStream; }
 
+    void Fail(const ErrorKind kind, const char *message = "") {
+        if constexpr (DECODE_MODE == DecodeMode::NoThrow) {
+            if (errorKind != ErrorKind::None) return;
+            errorKind = kind;
+            errorLocation = inStream.curr();
+            errorMessage = message;
+        } else if (kind == ErrorKind::UnknownKey) {
+            ROHIT_THROW(exception::KeyNotFound { inStream, message });
+        } else if (kind == ErrorKind::BadType) {
+            ROHIT_THROW(exception::BadType { inStream, message });
+        } else {
+            ROHIT_THROW(exception::BadInputData { inStream, message });
+        }
+    }
+
+    constexpr bool Failed() const {
+        if constexpr (DECODE_MODE == DecodeMode::NoThrow) return errorKind != ErrorKind::None;
+        else return false;
+    }
+
+    DecodeStatus GetStatus() const {
+        if (!Failed()) return { };
+        return { errorKind, static_cast<size_t>(errorLocation - start), errorMessage };
+    }
+};
+
+// Collections are default only when empty, generated class and types without equality are never default
+template <typename T>
+constexpr bool IsDefault(const T &value, const T &defaultValue) {
+    if constexpr (typecheck::vector<T> || typecheck::map<T> || typecheck::inline_vector<T>) {
+        return value.empty() && defaultValue.empty();
+    } else if constexpr (std::equality_comparable<T> && !typecheck::object<T>) {
+        return value == defaultValue;
+    } else return false;
+}
+
+// List written from a range which is read once, see RangeListSource
+template <typename Range>
+struct RangeList {
+    using range_type = Range;
+    Range &range;
+};
+
+// Range is not read to find if it is empty, hence it is always written
+template <typename Range, typename T>
+constexpr bool IsDefault(const RangeList<Range> &, const T &) { return false; }
+
+// Source of list members for SerializeOut, NoListSource writes members themselves
+struct NoListSource { };
+
+// List member FIELD is written from range instead of member
+template <uint32_t FIELD, typename Range>
+struct RangeListSource {
+    static constexpr uint32_t list_field { FIELD };
+    Range &range;
+};
+
+// List written in chunks encoded in parallel on pool, see SerializeOutChunks
+template <typename T, typename Pool>
+struct ParallelList {
+    using list_type = T;
+    using pool_type = Pool;
+    const T &list;
+    Pool &pool;
+    size_t chunkSize;
+};
+
+template <typename T, typename Pool>
+constexpr bool IsDefault(const ParallelList<T, Pool> &value, const T &defaultValue) { return IsDefault(value.list, defaultValue); }
+
+// List member FIELD is encoded in chunks of chunkSize on pool, pool must have ParallelFor(count, function)
+template <uint32_t FIELD, typename Pool>
+struct ParallelListSource {
+    static constexpr uint32_t list_field { FIELD };
+    Pool &pool;
+    size_t chunkSize;
+};
+
+// Byte offset of every interval-th element of a binary list and of end of list, relative to start
+// of object. It is kept beside encoded object so that chunks of list can be decoded in parallel.
+struct ListIndex {
+    uint32_t interval { 1024 };
+    std::vector<uint64_t> offsets { };
+};
+
+// List written by binary protocol recording ListIndex, see IndexedListSource
+template <typename T>
+struct IndexedList {
+    using list_type = T;
+    const T &list;
+    ListIndex &index;
+    size_t base;
+};
+
+template <typename T>
+constexpr bool IsDefault(const IndexedList<T> &value, const T &defaultValue) { return IsDefault(value.list, defaultValue); }
+
+// List member FIELD records its index, base is offset of object in stream
+template <uint32_t FIELD>
+struct IndexedListSource {
+    static constexpr uint32_t list_field { FIELD };
+    ListIndex &index;
+    size_t base;
+};
+
+template <uint32_t FIELD>
+decltype(auto) ListOut(const auto &source, const auto &value) {
+    using source_type = std::remove_cvref_t<decltype(source)>;
+    if constexpr (requires { source_type::list_field; }) {
+        if constexpr (source_type::list_field != FIELD) return (value);
+        else if constexpr (requires { source.range; }) return RangeList<std::remove_reference_t<decltype(source.range)>> { source.range };
+        else if constexpr (requires { source.index; }) return IndexedList<std::remove_cvref_t<decltype(value)>> { value, source.index, source.base };
+        else return ParallelList<std::remove_cvref_t<decltype(value)>, std::remove_reference_t<decltype(source.pool)>> { value, source.pool, source.chunkSize };
+    } else return (value);
+}
+
+// Each chunk of list is encoded by its own protocol in its own buffer, buffers are appended in order
+// hence output is same as of sequential encoding. Separator is written before each element but first.
+template <typename SerializeOutProtocol>
+void SerializeOutChunks(Stream &stream, const auto &value, auto &&writeSeparator) {
+    const auto &list = value.list;
+    const size_t chunkSize { std::max<size_t>(value.chunkSize, 1) };
+    const size_t chunkCount { (list.size() + chunkSize - 1) / chunkSize };
+    std::vector<std::unique_ptr<FullStreamAutoAlloc>> buffers(chunkCount);
+    value.pool.ParallelFor(chunkCount, [&list, &buffers, &writeSeparator, chunkSize](const size_t chunk) {
+        buffers[chunk] = std::make_unique<FullStreamAutoAlloc>(256);
+        SerializeOutProtocol serializerProtocol { *buffers[chunk] };
+        const size_t begin { chunk * chunkSize };
+        const size_t end { std::min(begin + chunkSize, list.size()) };
+        for(size_t index { begin }; index < end; ++index) {
+            if (index) writeSeparator(serializerProtocol);
+            const typename std::remove_cvref_t<decltype(list)>::value_type &item = list[index];
+            serializerProtocol.SerializeOut(item);
+        }
+    });
+    for(auto &buffer: buffers) stream.Append(buffer->begin(), buffer->CurrentOffset());
+}
+
+// Selector for SerializeIn, member is decoded only when Test returns true, others are skipped
+struct AllFields {
+    static constexpr bool Test(const uint32_t) { return true; }
+};
+
+struct NoFields {
+    static constexpr bool Test(const uint32_t) { return false; }
+};
+
+// Compile time selector, T::f_<member> are field index
+template <uint32_t ...fields>
+struct FieldSet {
+    static constexpr bool Test(const uint32_t field) { return ((field == fields) || ...); }
+};
+
+template <typename T>
+class FieldMask {
+    std::array<uint64_t, (T::field_count + 63) / 64> mask { };
+
+public:
+    constexpr FieldMask(std::initializer_list<uint32_t> fields) {
+        for(auto field: fields) mask[field / 64] |= 1ULL << (field % 64);
+    }
+
+    constexpr bool Test(const uint32_t field) const { return (mask[field / 64] >> (field % 64)) & 1ULL; }
+};
+
+enum class MemberTypeTag : uint8_t {
+    Primitive,
+    Enum,
+    Class,
+    Array,
+    Map,
+    Union
+};
+
+// Compile time description of a generated class member, GetMemberDescriptors() returns tuple of these
+template <typename ClassType, typename MemberType>
+struct MemberDescriptor {
+    using class_type = ClassType;
+    using member_type = MemberType;
+
+    std::string_view name; // C++ member name
+    std::string_view key; // Name used by string key serializer
+    uint32_t id; // Identifier used by integer key serializer
+    uint32_t field; // Field index used by selector
+    MemberTypeTag tag;
+    MemberType ClassType::*pointer;
+
+    constexpr const MemberType &Get(const ClassType &obj) const { return obj.*pointer; }
+    constexpr MemberType &Get(ClassType &obj) const { return obj.*pointer; }
+    constexpr void Set(ClassType &obj, const MemberType &value) const { obj.*pointer = value; }
+    const MemberType &Default() const { return ClassType::GetDefaultObject().*pointer; }
+};
+
+// Member pointer cannot be created for bit-field, value is accessed by copy
+template <typename ClassType, typename MemberType>
+struct BitFieldDescriptor {
+    using class_type = ClassType;
+    using member_type = MemberType;
+
+    std::string_view name;
+    std::string_view key;
+    uint32_t id;
+    uint32_t field;
+    MemberTypeTag tag;
+    MemberType (*getter)(const ClassType &);
+    void (*setter)(ClassType &, const MemberType);
+
+    constexpr MemberType Get(const ClassType &obj) const { return getter(obj); }
+    constexpr void Set(ClassType &obj, const MemberType value) const { setter(obj, value); }
+    MemberType Default() const { return getter(ClassType::GetDefaultObject()); }
+};
+
+// Selector used by reuse decode, it records members found in input and forwards Test
+template <typename T, typename Selector>
+class FieldRecorder {
+    const Selector &selector;
+    mutable std::array<uint64_t, (T::field_count + 63) / 64> seen { };
+
+public:
+    constexpr FieldRecorder(const Selector &selector) : selector { selector } { }
+
+    constexpr bool Test(const uint32_t field) const {
+        seen[field / 64] |= 1ULL << (field % 64);
+        return selector.Test(field);
+    }
+
+    constexpr bool Seen(const uint32_t field) const { return (seen[field / 64] >> (field % 64)) & 1ULL; }
+};
+
+// Trivially copyable members are reset before decode, this covers packed members which are
+// decoded as a single word. Other members are reset after decode only when absent in input,
+// copy assignment keeps their capacity. Union members are left to their type member.
+template <typename T>
+void ResetTrivialMembers(T &obj) {
+    std::apply([&obj](const auto &...descriptor) {
+        ([&obj](const auto &descriptor) {
+            using member_type = typename std::remove_cvref_t<decltype(descriptor)>::member_type;
+            if constexpr (std::is_trivially_copyable_v<member_type> && !std::is_union_v<member_type>) {
+                descriptor.Set(obj, descriptor.Default());
+            }
+        }(descriptor), ...);
+    }, T::GetMemberDescriptors());
+}
+
+template <typename T, typename Selector>
+void ResetAbsentMembers(T &obj, const FieldRecorder<T, Selector> &recorder) {
+    std::apply([&obj, &recorder](const auto &...descriptor) {
+        ([&obj, &recorder](const auto &descriptor) {
+            using member_type = typename std::remove_cvref_t<decltype(descriptor)>::member_type;
+            if constexpr (!std::is_trivially_copyable_v<member_type> && !std::is_union_v<member_type>) {
+                if (!recorder.Seen(descriptor.field)) descriptor.Get(obj) = descriptor.Default();
+            }
+        }(descriptor), ...);
+    }, T::GetMemberDescriptors());
+}
+
+// Decodes list elements one at a time, Reuse decodes into existing elements
+// and shrinks list at Finish so that capacity is retained
+template <typename T, DecodeMode DECODE_MODE>
+class ListDecoder {
+    T &value;
+    size_t count { };
+
+public:
+    ListDecoder(T &value) : value { value } {
+        if constexpr (DECODE_MODE == DecodeMode::Default && typecheck::inline_vector<T>) value.clear();
+    }
+
+    // Only inline list has limit
+    bool Full() const {
+        if constexpr (typecheck::inline_vector<T>) return count == T::static_capacity;
+        else return false;
+    }
+
+    void Read(auto &&readElement) {
+        using value_type = typename T::value_type;
+        if constexpr (!std::is_same_v<value_type, bool>) {
+            // Element is constructed in place, allocator aware list passes its allocator to element
+            if (DECODE_MODE == DecodeMode::Reuse && count < value.size()) readElement(value[count]);
+            else readElement(value.emplace_back());
+        } else {
+            // std::vector<bool> has no element reference
+            value_type element { };
+            readElement(element);
+            if (DECODE_MODE == DecodeMode::Reuse && count < value.size()) value[count] = element;
+            else value.emplace_back(element);
+        }
+        ++count;
+    }
+
+    void Finish() {
+        if constexpr (DECODE_MODE == DecodeMode::Reuse) value.resize(count);
+    }
+};
+
+template <typename T>
+const T &DefaultValue() {
+    static const T value { };
+    return value;
+}
+
+// Decodes list elements one at a time into a scratch element which is passed to function
+// and reset, memory used does not depend on size of list. Function returning false stops
+// decoding with ErrorKind::Stopped, hence protocol must be NoThrow.
+template <typename T, typename Function, typename SerializeInProtocol>
+class ListStream {
+    Function &function;
+    SerializeInProtocol &serializerProtocol;
+    T element { };
+
+public:
+    ListStream(Function &function, SerializeInProtocol &serializerProtocol) : function { function }, serializerProtocol { serializerProtocol } { }
+
+    constexpr bool Full() const { return false; }
+
+    void Read(auto &&readElement) {
+        // Element function gets only completely decoded element
+        if (!readElement(element)) return;
+        if constexpr (std::is_same_v<std::invoke_result_t<Function &, T &&>, bool>) {
+            if (!function(std::move(element))) serializerProtocol.Fail(ErrorKind::Stopped, "Stopped by element function");
+        } else function(std::move(element));
+        // Reset in place, element keeps its allocator
+        element = DefaultValue<T>();
+    }
+
+    constexpr void Finish() { }
+};
+
+// Selector of streaming decode, all members are decoded and list member FIELD is passed
+// element by element to function instead of being stored
+template <uint32_t FIELD, typename T, typename Function>
+class StreamSelector {
+    Function &function;
+
+public:
+    static constexpr uint32_t stream_field { FIELD };
+
+    constexpr StreamSelector(Function &function) : function { function } { }
+
+    static constexpr bool Test(const uint32_t) { return true; }
+
+    template <typename SerializeInProtocol>
+    void StreamIn(SerializeInProtocol &serializerProtocol) const {
+        static_assert(SerializeInProtocol::decode_mode == DecodeMode::NoThrow, "Streaming decode stops by failing, it must not throw");
+        ListStream<T, Function, SerializeInProtocol> decoder { function, serializerProtocol };
+        serializerProtocol.ListSerializeIn(decoder);
+    }
+};
+
+// Selector of indexed decode, all members are decoded and chunks of list member FIELD
+// are decoded in parallel on pool using index written by IndexedListSource
+template <uint32_t FIELD, typename Pool>
+class IndexedSelector {
+    const ListIndex &index;
+    Pool &pool;
+
+public:
+    static constexpr uint32_t index_field { FIELD };
+
+    constexpr IndexedSelector(const ListIndex &index, Pool &pool) : index { index }, pool { pool } { }
+
+    static constexpr bool Test(const uint32_t) { return true; }
+
+    template <typename SerializeInProtocol, typename T>
+    void IndexedIn(SerializeInProtocol &serializerProtocol, T &value) const {
+        static_assert(requires { serializerProtocol.ListSerializeInIndexed(value, index, pool); }, "Indexed decode is supported only by binary protocol");
+        serializerProtocol.ListSerializeInIndexed(value, index, pool);
+    }
+};
+
+// Selector of patch decode, see Patch. Object, list and map members are patched in place,
+// other members are replaced.
+struct PatchFields {
+    static constexpr bool patch { true };
+    static constexpr bool Test(const uint32_t) { return true; }
+};
+
+// Member of patch structure, key is identifier or name as protocol writes member of generated class
+void StructSerializeOutField(auto &serializerProtocol, const uint32_t identifier, const std::string_view name, const auto &value) {
+    constexpr auto keyType = std::remove_cvref_t<decltype(serializerProtocol)>::serialize_key_type;
+    if constexpr (keyType == SerializeKeyType::String) {
+        serializerProtocol.StructSerializeOut(std::make_pair(name, std::cref(value)));
+    } else if constexpr (keyType == SerializeKeyType::Integer) {
+        serializerProtocol.StructSerializeOut(std::make_pair(identifier, std::cref(value)));
+    } else serializerProtocol.StructSerializeOut(value);
+}
+
+// Patch structures have two fields, field in slot n has identifier n + 1, present fields are
+// written by write(slot)
+void StructSerializeOutPatchFields(auto &serializerProtocol, const uint64_t presence, auto &&write) {
+    constexpr auto keyType = std::remove_cvref_t<decltype(serializerProtocol)>::serialize_key_type;
+    static_assert(keyType != SerializeKeyType::None, "Patch needs protocol with keys or bitmap");
+    if constexpr (keyType == SerializeKeyType::Bitmap) {
+        serializerProtocol.StructSerializeOutBitmap(std::array<uint64_t, 1> { presence }, 2);
+    } else serializerProtocol.StructSerializeOutStart();
+    if (presence & 1) write(0);
+    if (presence & 2) write(1);
+    serializerProtocol.StructSerializeOutEnd();
+}
+
+// Decoding of patch structure, Derived::SerializeInField decodes field of slot
+template <typename Derived>
+struct PatchStruct {
+    static constexpr uint32_t serialize_slot_count { 2 };
+
+    void SerializeInMemberByName(auto &serializerProtocol, const std::string_view name, const auto &) {
+        for(uint32_t slot { 0 }; slot < serialize_slot_count; ++slot) {
+            if (name == Derived::field_names[slot]) return static_cast<Derived *>(this)->SerializeInField(serializerProtocol, slot);
+        }
+        serializerProtocol.Fail(ErrorKind::UnknownKey, "Bad Member Name");
+    }
+
+    void SerializeInMemberByIdentifier(auto &serializerProtocol, const uint32_t identifier, const auto &) {
+        if (identifier == 0 || identifier > serialize_slot_count) return serializerProtocol.Fail(ErrorKind::UnknownKey, "Bad Member Identifier");
+        static_cast<Derived *>(this)->SerializeInField(serializerProtocol, identifier - 1);
+    }
+
+    void SerializeInMemberByIndex(auto &serializerProtocol, const uint32_t index, const auto &) {
+        if (index >= serialize_slot_count) return serializerProtocol.Fail(ErrorKind::UnknownKey, "Bad Member Index");
+        static_cast<Derived *>(this)->SerializeInField(serializerProtocol, index);
+    }
+};
+
+template <typename T>
+class Patch;
+
+// Element which is object, list or map is written as its own patch, other element is written whole
+void SerializeOutPatchValue(auto &serializerProtocol, const uint32_t identifier, const std::string_view name, const auto &from, const auto &to) {
+    using value_type = std::remove_cvref_t<decltype(to)>;
+    if constexpr (typecheck::patchable<value_type>) StructSerializeOutField(serializerProtocol, identifier, name, Patch<value_type> { from, to });
+    else StructSerializeOutField(serializerProtocol, identifier, name, to);
+}
+
+template <typename T>
+void SerializeInPatchValue(auto &serializerProtocol, T &value) {
+    if constexpr (typecheck::patchable<T>) {
+        Patch<T> patch { value };
+        serializerProtocol.SerializeIn(patch);
+    } else serializerProtocol.SerializeIn(value);
+}
+
+// Edit of list element, element is added when index is size of list
+template <typename T>
+class ListPatchEntry : public PatchStruct<ListPatchEntry<T>> {
+    using value_type = typename T::value_type;
+    const T *from { };
+    const T *to { };
+    T *target { };
+    uint64_t index { };
+    uint64_t size { };
+    bool hasIndex { false };
+
+public:
+    static constexpr std::string_view field_names[] { "index", "value" };
+
+    ListPatchEntry(const T &from, const T &to, const uint64_t index) : from { &from }, to { &to }, index { index } { }
+    ListPatchEntry(T &target, const uint64_t size) : target { &target }, size { size } { }
+    ListPatchEntry(const ListPatchEntry &) = default;
+    ListPatchEntry &operator=(const ListPatchEntry &) = default;
+
+    template <typename SerializeOutProtocol>
+    void SerializeOut(SerializeOutProtocol &serializerProtocol) const {
+        StructSerializeOutPatchFields(serializerProtocol, 3, [this, &serializerProtocol](const uint32_t slot) {
+            if (slot == 0) StructSerializeOutField(serializerProtocol, 1, field_names[0], index);
+            else if constexpr (std::is_same_v<value_type, bool>) StructSerializeOutField(serializerProtocol, 2, field_names[1], static_cast<bool>((*to)[index]));
+            else if (index < from->size()) SerializeOutPatchValue(serializerProtocol, 2, field_names[1], (*from)[index], (*to)[index]);
+            else SerializeOutPatchValue(serializerProtocol, 2, field_names[1], DefaultValue<value_type>(), (*to)[index]);
+        });
+    }
+
+    template <typename SerializeInProtocol>
+    void SerializeIn(SerializeInProtocol &serializerProtocol) {
+        serializerProtocol.StructSerializeIn(this);
+    }
+
+    void SerializeInField(auto &serializerProtocol, const uint32_t slot) {
+        if (slot == 0) {
+            serializerProtocol.SerializeIn(index);
+            if (serializerProtocol.Failed()) return;
+            if (index > target->size() || index >= size) return serializerProtocol.Fail(ErrorKind::BadValue, "Bad list patch index");
+            if (index == target->size()) target->emplace_back();
+            hasIndex = true;
+        } else {
+            if (!hasIndex) return serializerProtocol.Fail(ErrorKind::BadValue, "List patch value before index");
+            if constexpr (std::is_same_v<value_type, bool>) {
+                bool value { };
+                serializerProtocol.SerializeIn(value);
+                (*target)[index] = value;
+            } else SerializeInPatchValue(serializerProtocol, (*target)[index]);
+        }
+    }
+};
+
+// Insert or edit of map entry, value of inserted key is patched from default value
+template <typename T>
+class MapPatchEntry : public PatchStruct<MapPatchEntry<T>> {
+    using key_type = typename T::key_type;
+    using mapped_type = typename T::mapped_type;
+    const key_type *key { };
+    const mapped_type *from { };
+    const mapped_type *to { };
+    T *target { };
+    key_type decodedKey { };
+    bool hasKey { false };
+
+public:
+    static constexpr std::string_view field_names[] { "key", "value" };
+
+    MapPatchEntry(const key_type &key, const mapped_type &from, const mapped_type &to) : key { &key }, from { &from }, to { &to } { }
+    MapPatchEntry(T &target) : target { &target } { }
+    MapPatchEntry(const MapPatchEntry &) = default;
+    MapPatchEntry &operator=(const MapPatchEntry &) = default;
+
+    template <typename SerializeOutProtocol>
+    void SerializeOut(SerializeOutProtocol &serializerProtocol) const {
+        StructSerializeOutPatchFields(serializerProtocol, 3, [this, &serializerProtocol](const uint32_t slot) {
+            if (slot == 0) StructSerializeOutField(serializerProtocol, 1, field_names[0], *key);
+            else SerializeOutPatchValue(serializerProtocol, 2, field_names[1], *from, *to);
+        });
+    }
+
+    template <typename SerializeInProtocol>
+    void SerializeIn(SerializeInProtocol &serializerProtocol) {
+        serializerProtocol.StructSerializeIn(this);
+    }
+
+    void SerializeInField(auto &serializerProtocol, const uint32_t slot) {
+        if (slot == 0) {
+            serializerProtocol.SerializeIn(decodedKey);
+            hasKey = !serializerProtocol.Failed();
+        } else {
+            if (!hasKey) return serializerProtocol.Fail(ErrorKind::BadValue, "Map patch value before key");
+            SerializeInPatchValue(serializerProtocol, (*target)[decodedKey]);
+        }
+    }
+};
+
+// Patch turning from into to, applied to target. Object patch has changed members, see
+// SerializeOutPatch of generated class. List patch has new size followed by edits of changed
+// and added elements. Map patch has erased keys followed by edits of changed and inserted keys.
+// Element which is object, list or map is edited by its own patch, other element is replaced.
+template <typename T>
+class Patch : public PatchStruct<Patch<T>> {
+    const T *from { };
+    const T *to { };
+    T *target { };
+    uint64_t size { };
+
+    // Decodes list elements one at a time with function instead of storing them
+    template <typename Element, typename Function>
+    struct ListFunction {
+        Function function;
+        constexpr bool Full() const { return false; }
+        void Read(auto &&readElement) { function(readElement); }
+        constexpr void Finish() { }
+    };
+
+    template <typename Function>
+    void ListSerializeIn(auto &serializerProtocol, Function &&function) {
+        ListFunction<T, Function> decoder { std::forward<Function>(function) };
+        serializerProtocol.ListSerializeIn(decoder);
+    }
+
+public:
+    static constexpr std::string_view field_names[] {
+        typecheck::map<T> ? "erase" : "size",
+        typecheck::map<T> ? "set" : "edits"
+    };
+
+    Patch(const T &from, const T &to) : from { &from }, to { &to } { }
+    explicit Patch(T &target) : target { &target } { }
+    Patch(const Patch &) = default;
+    Patch &operator=(const Patch &) = default;
+
+    template <typename SerializeOutProtocol>
+    void SerializeOut(SerializeOutProtocol &serializerProtocol) const {
+        if constexpr (typecheck::object<T>) {
+            to->SerializeOutPatch(serializerProtocol, *from);
+        } else if constexpr (typecheck::vector<T>) {
+            std::vector<ListPatchEntry<T>> edits { };
+            for(size_t index { 0 }; index < to->size(); ++index) {
+                if (index >= from->size() || (*from)[index] != (*to)[index]) edits.emplace_back(*from, *to, index);
+            }
+            StructSerializeOutPatchFields(serializerProtocol, edits.empty() ? 1 : 3, [this, &serializerProtocol, &edits](const uint32_t slot) {
+                if (slot == 0) StructSerializeOutField(serializerProtocol, 1, field_names[0], static_cast<uint64_t>(to->size()));
+                else StructSerializeOutField(serializerProtocol, 2, field_names[1], edits);
+            });
+        } else {
+            std::vector<typename T::key_type> erased { };
+            for(auto &entry: *from) {
+                if (to->find(entry.first) == to->end()) erased.push_back(entry.first);
+            }
+            std::vector<MapPatchEntry<T>> edits { };
+            for(auto &entry: *to) {
+                auto itr = from->find(entry.first);
+                if (itr == from->end()) edits.emplace_back(entry.first, DefaultValue<typename T::mapped_type>(), entry.second);
+                else if (itr->second != entry.second) edits.emplace_back(entry.first, itr->second, entry.second);
+            }
+            const uint64_t presence { (erased.empty() ? 0U : 1U) | (edits.empty() ? 0U : 2U) };
+            StructSerializeOutPatchFields(serializerProtocol, presence, [&serializerProtocol, &erased, &edits](const uint32_t slot) {
+                if (slot == 0) StructSerializeOutField(serializerProtocol, 1, field_names[0], erased);
+                else StructSerializeOutField(serializerProtocol, 2, field_names[1], edits);
+            });
+        }
+    }
+
+    template <typename SerializeInProtocol>
+    void SerializeIn(SerializeInProtocol &serializerProtocol) {
+        static_assert(SerializeInProtocol::decode_mode != DecodeMode::Reuse, "Patch is applied to existing object, it cannot be decoded in reuse mode");
+        if constexpr (typecheck::object<T>) {
+            target->SerializeIn(serializerProtocol, PatchFields { });
+        } else {
+            size = target->size();
+            serializerProtocol.StructSerializeIn(this);
+            if (!serializerProtocol.Failed() && target->size() != size) serializerProtocol.Fail(ErrorKind::BadValue, "List patch does not match size");
+        }
+    }
+
+    void SerializeInField(auto &serializerProtocol, const uint32_t slot) {
+        if constexpr (typecheck::vector<T>) {
+            if (slot == 0) {
+                serializerProtocol.SerializeIn(size);
+                if (size < target->size()) target->resize(size);
+            } else {
+                ListSerializeIn(serializerProtocol, [this](auto &&readElement) {
+                    ListPatchEntry<T> entry { *target, size };
+                    readElement(entry);
+                });
+            }
+        } else {
+            if (slot == 0) {
+                ListSerializeIn(serializerProtocol, [this](auto &&readElement) {
+                    typename T::key_type key { };
+                    if (readElement(key)) target->erase(key);
+                });
+            } else {
+                ListSerializeIn(serializerProtocol, [this](auto &&readElement) {
+                    MapPatchEntry<T> entry { *target };
+                    readElement(entry);
+                });
+            }
+            size = target->size();
+        }
+    }
+};
+
+// Value written for changed member by SerializeOutPatch of generated class
+template <typename T>
+decltype(auto) MakePatch(const T &from, const T &to) {
+    if constexpr (typecheck::patchable<T>) return Patch<T> { from, to };
+    else return (to);
+}
+
+// Member decode, with PatchFields object, list and map member is patched and other member is replaced
+template <typename T>
+void SerializeInMember(auto &serializerProtocol, const auto &selector, T &value) {
+    if constexpr (requires { std::remove_cvref_t<decltype(selector)>::patch; }) {
+        if constexpr (typecheck::patchable<T>) {
+            Patch<T> patch { value };
+            serializerProtocol.SerializeIn(patch);
+        } else {
+            value = T { };
+            serializerProtocol.SerializeIn(value);
+        }
+    } else serializerProtocol.template SerializeIn<T>(value);
+}
+
+// Selector passed to parent, fields of parent are numbered from OFFSET in derived class
+template <uint32_t OFFSET, typename Selector>
+class ParentFieldSelector {
+    const Selector &selector;
+
+public:
+    constexpr ParentFieldSelector(const Selector &selector) : selector { selector } { }
+
+    constexpr bool Test(const uint32_t field) const { return selector.Test(OFFSET + field); }
+};
+
+// Parent is patched with PatchFields, other selector is tested with field index of derived class.
+// Streamed and indexed list are members of derived class, hence parent list is decoded as usual.
+template <uint32_t OFFSET>
+constexpr auto ParentSelector(const auto &selector) {
+    using selector_type = std::remove_cvref_t<decltype(selector)>;
+    if constexpr (requires { selector_type::patch; }) return PatchFields { };
+    else if constexpr (std::is_same_v<selector_type, AllFields>) return AllFields { };
+    else return ParentFieldSelector<OFFSET, selector_type> { selector };
+}
+
+// List member is streamed when selector is StreamSelector of the member, decoded in parallel
+// when selector is IndexedSelector of the member, otherwise it is decoded in list or patched
+template <uint32_t FIELD, typename T>
+void SerializeInList(auto &serializerProtocol, const auto &selector, T &value) {
+    using selector_type = std::remove_cvref_t<decltype(selector)>;
+    if constexpr (requires { selector_type::stream_field; }) {
+        if constexpr (selector_type::stream_field == FIELD) {
+            selector.StreamIn(serializerProtocol);
+            return;
+        }
+    }
+    if constexpr (requires { selector_type::index_field; }) {
+        if constexpr (selector_type::index_field == FIELD) {
+            selector.IndexedIn(serializerProtocol, value);
+            return;
+        }
+    }
+    SerializeInMember(serializerProtocol, selector, value);
+}
+
+// Decodes map entries one at a time. Entries are inserted with hint at end which is
+// linear for sorted input. Reuse recycles nodes of std::map and std::unordered_map
+// and slots of flat_map.
+template <typename T, DecodeMode DECODE_MODE>
+class MapDecoder {
+    static constexpr bool reuseFlat { DECODE_MODE == DecodeMode::Reuse && typecheck::flat_map<T> };
+    static constexpr bool reuseNode { DECODE_MODE == DecodeMode::Reuse && !typecheck::flat_map<T> };
+    template <typename U>
+    struct ContainerOf { using type = typename U::container_type; };
+    using spare_type = typename std::conditional_t<reuseFlat, ContainerOf<T>, std::type_identity<T>>::type;
+
+    T &value;
+    spare_type spare { };
+    size_t count { };
+
+    template <typename Part>
+    Part MakeEntryPart() const {
+        if constexpr (requires { value.get_allocator(); }) return std::make_obj_using_allocator<Part>(value.get_allocator());
+        else return Part { };
+    }
+
+public:
+    MapDecoder(T &value) : value { value } {
+        if constexpr (reuseFlat) spare = std::move(value).extract();
+        if constexpr (reuseNode) spare.swap(value);
+    }
+
+    void Reserve(const size_t size) {
+        if constexpr (reuseFlat) {
+            if (spare.size() < size) spare.reserve(size);
+        } else if constexpr (requires { value.reserve(size); }) value.reserve(size);
+    }
+
+    void Read(auto &&readEntry) {
+        if constexpr (reuseFlat) {
+            if (count < spare.size()) readEntry(spare[count].first, spare[count].second);
+            else {
+                auto &entry = spare.emplace_back();
+                readEntry(entry.first, entry.second);
+            }
+            ++count;
+            return;
+        } else if constexpr (reuseNode) {
+            if (!spare.empty()) {
+                auto node = spare.extract(std::begin(spare));
+                readEntry(node.key(), node.mapped());
+                value.insert(std::end(value), std::move(node));
+                return;
+            }
+        }
+        // Allocator aware map gets key and value from its own allocator so that they are moved without copy
+        auto key = MakeEntryPart<typename T::key_type>();
+        auto mapped = MakeEntryPart<typename T::mapped_type>();
+        readEntry(key, mapped);
+        value.emplace_hint(std::end(value), std::move(key), std::move(mapped));
+    }
+
+    void Finish() {
+        if constexpr (reuseFlat) {
+            spare.resize(count);
+            value.replace(std::move(spare));
+        }
+    }
+};
+
+// Transcode target that writes nothing, validation is transcoding into it
+class ValidateWriter {
+public:
+    constexpr static bool pack_bits = true; // Packed word is read as it is
+
+    struct Frame {
+        size_t count { 0 };
+    };
+
+    template <typename T>
+    Frame StructStart() { return { }; }
+    template <typename T>
+    void StructEnd(Frame &) { }
+    template <typename T>
+    void Member(Frame &, const uint32_t, const std::string_view, const uint32_t) { }
+    template <typename T>
+    void UnionMember(Frame &, const uint32_t, const std::string_view, const uint32_t, const uint32_t) { }
+    template <typename T, typename P>
+    void PackedMember(Frame &, const uint32_t, const uint32_t, const P, const P, const uint32_t, const P) { }
+    void Value(const auto &) { }
+    void Default(const auto &) { }
+    template <typename T>
+    Frame ListStart(const size_t = 0) { return { }; }
+    void ListNext(Frame &frame) { ++frame.count; }
+    template <typename T>
+    void ListEnd(Frame &) { }
+    void MapKey(Frame &frame) { ListNext(frame); }
+    void MapValue() { }
+    void MapEntryEnd() { }
+}; // class ValidateWriter
+
+template <SerializeType type>
+class json { };
+
+template <DecodeMode DECODE_MODE = DecodeMode::Default>
+class JsonIn : public DecodeState<DECODE_MODE> {
+public:
+    constexpr static SerializeKeyType serialize_key_type = SerializeKeyType::String;
+    template <DecodeMode MODE>
+    using with_decode_mode = JsonIn<MODE>;
+
+protected:
+    using DecodeState<DECODE_MODE>::inStream;
+
+public:
+    using DecodeState<DECODE_MODE>::DecodeState;
+    using DecodeState<DECODE_MODE>::Fail;
+    using DecodeState<DECODE_MODE>::Failed;
+
 protected:
     constexpr bool IsWhiteSpace(const char val) noexcept { return val == ' ' || val == '\t' || val == '\n' || val == '\r'; }
-    void SkipWhiteSpace() { while(IsWhiteSpace(*inStream)) ++inStream; }
+    void SkipWhiteSpace() { while(!inStream.full() && IsWhiteSpace(*inStream)) ++inStream; }
+    bool Peek(const char value) const { return !inStream.full() && *inStream == value; }
 
     void CheckAndIncrease(char value) {
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
         if (*inStream != value) {
-            std::string errStr { "Expected " };
-            errStr.push_back(value);
-            errStr += " but found ";
-            errStr.push_back(*inStream);
-            throw exception::BadInputData { inStream , std::move(errStr) };
+            if constexpr (DECODE_MODE == DecodeMode::NoThrow) {
+                Fail(ErrorKind::UnexpectedCharacter);
+                return;
+            } else {
+                std::string errStr { "Expected " };
+                errStr.push_back(value);
+                errStr += " but found ";
+                errStr.push_back(*inStream);
+                ROHIT_THROW(exception::BadInputData { inStream , std::move(errStr) });
+            }
         }
         ++inStream;
     }
@@ -232,9 +1300,14 @@ protected:
     const std::string_view SerializeInGetKey() {
         SkipWhiteSpace();
         CheckAndIncrease('"');
+        if (Failed()) return { };
         auto start = inStream.curr();
         // TODO:: Escape character
-        while(*inStream != '"') ++inStream;
+        while(!inStream.full() && *inStream != '"') ++inStream;
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd, "Expecting '\"'");
+            return { };
+        }
         auto end = inStream.curr();
         ++inStream;
         SkipWhiteSpace();
@@ -243,48 +1316,65 @@ protected:
         return { reinterpret_cast<const char *>(start), reinterpret_cast<const char *>(end) };
     }
 
+    // Matches whole literal case insensitive from current position, literal is in lower case
+    bool MatchLiteral(const std::string_view literal) {
+        if (inStream.RemainingBuffer() < literal.size()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return false;
+        }
+        for(auto ch: literal) {
+            if (std::tolower(*inStream) != ch) {
+                Fail(ErrorKind::UnexpectedCharacter);
+                return false;
+            }
+            ++inStream;
+        }
+        return true;
+    }
+
     void SerializeInBool(bool &value) {
-        if (inStream.RemainingBuffer() < 4) throw exception::BadInputData { inStream };
+        if (inStream.RemainingBuffer() < 4) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
         auto ch = std::tolower(*inStream);
         if (ch == 't') {
-            ++inStream;
-            if (std::tolower(*inStream) != 'r') throw exception::BadInputData { inStream };
-            ++inStream;
-            if (std::tolower(*inStream) != 'u') throw exception::BadInputData { inStream };
-            ++inStream;
-            if (std::tolower(*inStream) != 'e') throw exception::BadInputData { inStream };
-            ++inStream;
-            value = true;
+            if (MatchLiteral("true")) value = true;
         } else if (ch == 'f') {
-            ++inStream;
-            if (std::tolower(*inStream) != 'a') throw exception::BadInputData { inStream };
-            ++inStream;
-            if (std::tolower(*inStream) != 'l') throw exception::BadInputData { inStream };
-            ++inStream;
-            if (std::tolower(*inStream) != 's') throw exception::BadInputData { inStream };
-            ++inStream;
-            if (inStream.full()) throw exception::BadInputData { inStream };
-            if (std::tolower(*inStream) != 'e') throw exception::BadInputData { inStream };
-            ++inStream;
-            value = false;
+            if (MatchLiteral("false")) value = false;
         }
     }
 
     void SerializeInChar(char &value) {
-        if (inStream.RemainingBuffer() < 3) throw exception::BadInputData { inStream };
-        if (*inStream != '"') throw exception::BadInputData { inStream };
+        if (inStream.RemainingBuffer() < 3) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
+        if (*inStream != '"') {
+            Fail(ErrorKind::UnexpectedCharacter);
+            return;
+        }
         ++inStream;
         value = *inStream;
         ++inStream;
-        if (*inStream != '"') throw exception::BadInputData { inStream };
+        if (*inStream != '"') {
+            Fail(ErrorKind::UnexpectedCharacter);
+            return;
+        }
         ++inStream;
     }
 
     void SerializeInUnsignedInteger(std::unsigned_integral auto &value) {
         using ValueType = std::remove_reference_t<decltype(value)>;
-        if (inStream.full()) throw exception::BadInputData { inStream };
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
         auto ch = *inStream;
-        if (ch < '0' || ch > '9') throw exception::BadInputData { inStream };
+        if (ch < '0' || ch > '9') {
+            Fail(ErrorKind::UnexpectedCharacter);
+            return;
+        }
         value = ch - '0';
         ++inStream;
         while(!inStream.full()) {
@@ -332,14 +1422,24 @@ protected:
     }
 
     void SerializeInSignedInteger(std::signed_integral auto &value) {
-        if (inStream.full()) throw exception::BadInputData { inStream };
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
         // TODO: Check out of range values
-        if ((*inStream < '0' || *inStream > '9') && *inStream != '-' && *inStream != '+') throw exception::BadInputData { inStream };
+        if ((*inStream < '0' || *inStream > '9') && *inStream != '-' && *inStream != '+') {
+            Fail(ErrorKind::UnexpectedCharacter);
+            return;
+        }
         auto sign { static_cast<std::remove_reference_t<decltype(value)>>(1) };
         if (*inStream == '-') {
             sign = -1;
             ++inStream;
         } else if (*inStream == '+') ++inStream;
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
         value = *inStream - '0';
         ++inStream;
         while(!inStream.full()) {
@@ -350,11 +1450,26 @@ protected:
         value *= sign;
     }
 
-    void SerializeInString(std::string &value) {
-        if (inStream.RemainingBuffer() < 2) throw exception::BadInputData { inStream };
+    void SerializeInString(auto &value) {
+        if (inStream.RemainingBuffer() < 2) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
         CheckAndIncrease('"');
-        while(*inStream != '"') {
-            if (inStream.full()) throw exception::BadInputData { inStream, "Expecting '\"'" };
+        if (Failed()) return;
+        value.clear();
+        while(true) {
+            if (inStream.full()) {
+                Fail(ErrorKind::UnexpectedEnd, "Expecting '\"'");
+                return;
+            }
+            if (*inStream == '"') break;
+            if constexpr (typecheck::inline_string<std::remove_reference_t<decltype(value)>>) {
+                if (value.full()) {
+                    Fail(ErrorKind::CapacityExceeded, "String exceeds inline capacity");
+                    return;
+                }
+            }
             value.push_back(*inStream);
             ++inStream;
         }
@@ -362,83 +1477,164 @@ protected:
     }
 
     void SerializeInFloatingPoint(std::floating_point auto &value) {
-        if (inStream.full()) throw exception::BadInputData { inStream };
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
         // TODO: Check out of range values
-        if ((*inStream < '0' || *inStream > '9') && *inStream != '-' && *inStream != '+') throw exception::BadInputData { inStream };
-        auto start = inStream.curr();
+        if ((*inStream < '0' || *inStream > '9') && *inStream != '-' && *inStream != '+') {
+            Fail(ErrorKind::UnexpectedCharacter);
+            return;
+        }
+        auto start = reinterpret_cast<const char *>(inStream.curr());
+        if (*inStream == '+') ++start; // from_chars does not accept leading '+'
         while (!inStream.full() && *inStream != ',' && *inStream != '!' && *inStream != ']' && *inStream != '}' && *inStream != ' ')
             ++inStream;
-        std::string number {start, inStream.curr()};
-        if constexpr (std::is_same_v<float, std::remove_reference_t<decltype(value)>>) value = std::stof(number);
-        else value = std::stod(number);
+        const auto end = reinterpret_cast<const char *>(inStream.curr());
+        const auto result = std::from_chars(start, end, value);
+        if (result.ec != std::errc { } || result.ptr != end) Fail(ErrorKind::BadValue, "Bad floating point number");
     }
 
-    void SerializeInVector(typecheck::vector auto &value) {
+    void SerializeInVector(auto &value) {
+        ListDecoder<std::remove_reference_t<decltype(value)>, DECODE_MODE> decoder { value };
+        ListSerializeIn(decoder);
+    }
+
+public:
+    // Reads list element by element into decoder, see ListDecoder and ListStream
+    void ListSerializeIn(auto &decoder) {
         CheckAndIncrease('[');
         SkipWhiteSpace();
-        if (*inStream != ']') {
+        if (Failed()) return;
+        if (!Peek(']')) {
             while(true) {
-                using value_type = std::remove_reference_t<decltype(value)>::value_type;
-                value_type valuetype { };
-                SerializeIn(valuetype);
-                value.emplace_back(valuetype);
+                if (decoder.Full()) {
+                    Fail(ErrorKind::CapacityExceeded, "Array exceeds inline capacity");
+                    return;
+                }
+                decoder.Read([this](auto &element) {
+                    SerializeIn(element);
+                    return !Failed();
+                });
                 SkipWhiteSpace();
-                if (*inStream == ']') break;
+                if (Failed()) return;
+                if (Peek(']')) break;
                 CheckAndIncrease(',');
                 SkipWhiteSpace();
-                if (*inStream == ']') {
-                    throw exception::BadInputData { inStream, "Unexpected ',', there must be next array entry after ','" };
+                if (Failed()) return;
+                if (Peek(']')) {
+                    Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there must be next array entry after ','");
+                    return;
                 }
             }
         }
-        ++inStream;
+        decoder.Finish();
+        CheckAndIncrease(']');
+    }
+
+protected:
+    void SkipString() {
+        CheckAndIncrease('"');
+        if (Failed()) return;
+        while(true) {
+            if (inStream.full()) {
+                Fail(ErrorKind::UnexpectedEnd, "Expecting '\"'");
+                return;
+            }
+            const auto ch = *inStream++;
+            if (ch == '"') break;
+            if (ch == '\\') {
+                if (inStream.full()) {
+                    Fail(ErrorKind::UnexpectedEnd);
+                    return;
+                }
+                ++inStream;
+            }
+        }
+    }
+
+    // Skips any JSON value without decoding it
+    void SkipValue() {
+        SkipWhiteSpace();
+        if (inStream.full()) {
+            Fail(ErrorKind::UnexpectedEnd);
+            return;
+        }
+        if (*inStream == '"') {
+            SkipString();
+        } else if (*inStream == '{' || *inStream == '[') {
+            size_t depth { 0 };
+            do {
+                if (inStream.full()) {
+                    Fail(ErrorKind::UnexpectedEnd, "Unterminated object or array");
+                    return;
+                }
+                const auto ch = *inStream;
+                if (ch == '"') {
+                    SkipString();
+                    if (Failed()) return;
+                    continue;
+                }
+                if (ch == '{' || ch == '[') ++depth;
+                else if (ch == '}' || ch == ']') --depth;
+                ++inStream;
+            } while(depth);
+        } else {
+            while(!inStream.full() && *inStream != ',' && *inStream != '}' && *inStream != ']' && !IsWhiteSpace(*inStream)) ++inStream;
+        }
+    }
+
+    // Expects "name": with name as given
+    void SerializeInMapEntryName(const std::string_view name) {
+        SkipWhiteSpace();
+        auto key = SerializeInGetKey();
+        if (Failed()) return;
+        if (key != name) {
+            if constexpr (DECODE_MODE == DecodeMode::NoThrow) Fail(ErrorKind::UnknownKey);
+            else ROHIT_THROW(exception::BadInputData { inStream, "Expected '" + std::string { name } + "' but found " + std::string { key } });
+        }
+    }
+
+    void SerializeInMapEntry(auto &key, auto &mapped) {
+        CheckAndIncrease('{');
+        SerializeInMapEntryName("key");
+        SerializeIn(key);
+        SkipWhiteSpace();
+        CheckAndIncrease(',');
+        SerializeInMapEntryName("value");
+        SerializeIn(mapped);
+        SkipWhiteSpace();
+        CheckAndIncrease('}');
     }
 
     void SerializeInMap(typecheck::map auto &value) {
         CheckAndIncrease('[');
         SkipWhiteSpace();
-        if (*inStream != ']') {
+        if (Failed()) return;
+        MapDecoder<std::remove_reference_t<decltype(value)>, DECODE_MODE> decoder { value };
+        if (!Peek(']')) {
             while(true) {
-                CheckAndIncrease('{');
-                SkipWhiteSpace();
-                std::string temp { };
-                SerializeIn(temp);
-                if (temp != "key") throw exception::BadInputData { inStream, "Expected 'key' but found " + temp };
-                SkipWhiteSpace();
-                CheckAndIncrease(':');
-                SkipWhiteSpace();
-                using T = std::remove_reference_t<decltype(value)>;
-                typename T::key_type key { };
-                SerializeIn(key);
+                decoder.Read([this](auto &key, auto &mapped) { SerializeInMapEntry(key, mapped); });
                 SkipWhiteSpace();
+                if (Failed()) return;
+                if (Peek(']')) break;
                 CheckAndIncrease(',');
                 SkipWhiteSpace();
-                std::string tempValue { };
-                SerializeIn(tempValue);
-                if (tempValue != "value") throw exception::BadInputData { inStream, "Expected 'value' but found " + temp };
-                SkipWhiteSpace();
-                CheckAndIncrease(':');
-                SkipWhiteSpace();
-                typename T::mapped_type valuetype { };
-                SerializeIn(valuetype);
-                value.emplace(std::move(key), std::move(valuetype));
-                SkipWhiteSpace();
-                CheckAndIncrease('}');
-                SkipWhiteSpace();
-                if (*inStream == ']') break;
-                CheckAndIncrease(',');
-                SkipWhiteSpace();
-                if (*inStream == ']') {
-                    throw exception::BadInputData { inStream, "Unexpected ',', there must be next map entry after ','" };
+                if (Failed()) return;
+                if (Peek(']')) {
+                    Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there must be next map entry after ','");
+                    return;
                 }
             }
         }
-        ++inStream;
+        decoder.Finish();
+        CheckAndIncrease(']');
     }
 
 public:
     template <typename T>
     void SerializeIn(T &value) {
+        if (Failed()) return;
         if constexpr (std::is_same_v<bool, T>) {
             SerializeInBool(value);
         } else if constexpr (std::is_same_v<char, T>) {
@@ -447,42 +1643,257 @@ public:
             SerializeInUnsignedInteger(value);
         } else if constexpr (std::signed_integral<T>) {
             SerializeInSignedInteger(value);
-        } else if constexpr (std::is_same_v<std::string, T>) {
+        } else if constexpr (typecheck::string<T> || typecheck::inline_string<T>) {
             SerializeInString(value);
         } else if constexpr (std::floating_point<T>) {
             SerializeInFloatingPoint(value);
-        } else if constexpr (typecheck::SerializerOutEnabledPtr<T, json>) {
+        } else if constexpr (typecheck::SerializerOutEnabledPtr<T, JsonIn>) {
             value->SerializeIn(*this);
-        } else if constexpr (typecheck::SerializerOutEnabled<T, json>) {
+        } else if constexpr (typecheck::SerializerOutEnabled<T, JsonIn>) {
             value.SerializeIn(*this);
-        } else if constexpr (typecheck::vector<T>) {
+        } else if constexpr (typecheck::vector<T> || typecheck::inline_vector<T>) {
             SerializeInVector(value);
         } else if constexpr (typecheck::map<T>) {
             SerializeInMap(value);
-        } else throw exception::BadType { inStream };
+        } else Fail(ErrorKind::BadType);
+    }
+
+    template <typename T>
+    void SkipIn() {
+        if (Failed()) return;
+        SkipValue();
+    }
+
+    // JSON always writes enum as name
+    template <typename T>
+    void ValidateEnumName() {
+        ValidateIn<T>();
+    }
+
+    // Validation is transcoding into writer that writes nothing, nothing is decoded or allocated
+    template <typename T>
+    void ValidateIn() {
+        ValidateWriter writer { };
+        TranscodeIn<T>(writer);
+    }
+
+    template <typename T>
+    void StructValidateIn() {
+        ValidateWriter writer { };
+        StructTranscodeIn<T>(writer);
+    }
+
+    // Reads member value, enum is read from its name
+    template <typename T>
+    void TranscodeRead(T &value) {
+        if constexpr (std::is_enum_v<T>) {
+            const auto name = ValidateString(std::numeric_limits<size_t>::max());
+            if (!Failed() && !from_string(name, value)) Fail(ErrorKind::BadValue, "Bad Enum Name");
+        } else SerializeIn(value);
+    }
+
+    // Transcoding passes each value to writer as it is read, only one leaf value is held
+    template <typename T>
+    void TranscodeIn(auto &writer) {
+        if (Failed()) return;
+        if constexpr (typecheck::TranscodeEnabled<T, JsonIn, std::remove_reference_t<decltype(writer)>>) {
+            T::TranscodeIn(*this, writer);
+        } else if constexpr (typecheck::vector<T> || typecheck::inline_vector<T>) {
+            TranscodeList<T>(writer);
+        } else if constexpr (typecheck::map<T>) {
+            TranscodeMap<T>(writer);
+        } else if constexpr (typecheck::string<T>) {
+            const auto value = ValidateString(std::numeric_limits<size_t>::max());
+            if (!Failed()) writer.Value(value);
+        } else if constexpr (typecheck::inline_string<T>) {
+            const auto value = ValidateString(T::static_capacity);
+            if (!Failed()) writer.Value(T { value });
+        } else {
+            T value { };
+            TranscodeRead(value);
+            if (!Failed()) writer.Value(value);
+        }
+    }
+
+    template <typename T>
+    void StructTranscodeIn(auto &writer) {
+        if (Failed() || !this->EnterNested()) return;
+        SkipWhiteSpace();
+        CheckAndIncrease('{');
+        SkipWhiteSpace();
+        auto frame = writer.template StructStart<T>();
+        if (!Failed() && Peek('}')) ++inStream;
+        else while(!Failed()) {
+            auto key = SerializeInGetKey();
+            if (Failed()) break;
+            T::TranscodeMemberByName(*this, writer, frame, key);
+            SkipWhiteSpace();
+            if (Failed()) break;
+            if (Peek('}')) {
+                ++inStream;
+                break;
+            }
+            CheckAndIncrease(',');
+            SkipWhiteSpace();
+            if (Peek('}')) Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there next object expected after ','");
+        }
+        writer.template StructEnd<T>(frame);
+        this->LeaveNested();
+    }
+
+protected:
+    // Array size is known only at its end
+    template <typename T>
+    void TranscodeList(auto &writer) {
+        CheckAndIncrease('[');
+        SkipWhiteSpace();
+        if (Failed()) return;
+        auto frame = writer.template ListStart<T>();
+        if (!Peek(']')) {
+            while(true) {
+                if constexpr (typecheck::inline_vector<T>) {
+                    if (frame.count == T::static_capacity) {
+                        Fail(ErrorKind::CapacityExceeded, "Array exceeds inline capacity");
+                        return;
+                    }
+                }
+                writer.ListNext(frame);
+                TranscodeIn<typename T::value_type>(writer);
+                SkipWhiteSpace();
+                if (Failed()) return;
+                if (Peek(']')) break;
+                CheckAndIncrease(',');
+                SkipWhiteSpace();
+                if (Failed()) return;
+                if (Peek(']')) {
+                    Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there must be next array entry after ','");
+                    return;
+                }
+            }
+        }
+        CheckAndIncrease(']');
+        writer.template ListEnd<T>(frame);
+    }
+
+    template <typename T>
+    void TranscodeMap(auto &writer) {
+        CheckAndIncrease('[');
+        SkipWhiteSpace();
+        if (Failed()) return;
+        auto frame = writer.template ListStart<T>();
+        if (!Peek(']')) {
+            while(true) {
+                CheckAndIncrease('{');
+                SerializeInMapEntryName("key");
+                writer.MapKey(frame);
+                TranscodeIn<typename T::key_type>(writer);
+                SkipWhiteSpace();
+                CheckAndIncrease(',');
+                SerializeInMapEntryName("value");
+                writer.MapValue();
+                TranscodeIn<typename T::mapped_type>(writer);
+                SkipWhiteSpace();
+                CheckAndIncrease('}');
+                writer.MapEntryEnd();
+                SkipWhiteSpace();
+                if (Failed()) return;
+                if (Peek(']')) break;
+                CheckAndIncrease(',');
+                SkipWhiteSpace();
+                if (Failed()) return;
+                if (Peek(']')) {
+                    Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there must be next map entry after ','");
+                    return;
+                }
+            }
+        }
+        CheckAndIncrease(']');
+        writer.template ListEnd<T>(frame);
+    }
+
+    // String ends at first '"' as in decoding, content must be UTF-8
+    std::string_view ValidateString(const size_t capacity) {
+        CheckAndIncrease('"');
+        if (Failed()) return { };
+        const auto begin = inStream.curr();
+        auto current = begin;
+        while(true) {
+            current = FindQuoteOrNonAscii(current, inStream.end());
+            if (current != inStream.end() && *current == '"') break;
+            const auto next = current == inStream.end() ? nullptr : SkipUtf8Sequence(current, inStream.end());
+            if (!next) {
+                inStream += static_cast<size_t>(current - inStream.curr());
+                if (current == inStream.end()) Fail(ErrorKind::UnexpectedEnd, "Expecting '\"'");
+                else Fail(ErrorKind::BadValue, "Invalid UTF-8");
+                return { };
+            }
+            current = next;
+        }
+        const auto length = static_cast<size_t>(current - begin);
+        if (length > capacity) {
+            Fail(ErrorKind::CapacityExceeded, "String exceeds inline capacity");
+            return { };
+        }
+        inStream += length + 1;
+        return { reinterpret_cast<const char *>(begin), length };
+    }
+
+public:
+
+    template <typename T>
+    void StructSerializeIn(T *obj) {
+        StructSerializeIn(obj, AllFields { });
+    }
+
+    template <typename T>
+    void StructSerializeIn(T *obj, const auto &selector)
+    {
+        if (Failed()) return;
+        if constexpr (DECODE_MODE == DecodeMode::Reuse) {
+            ResetTrivialMembers(*obj);
+            FieldRecorder<T, std::remove_cvref_t<decltype(selector)>> recorder { selector };
+            StructSerializeInMembers(obj, recorder);
+            ResetAbsentMembers(*obj, recorder);
+        } else StructSerializeInMembers(obj, selector);
     }
 
+private:
     template <typename T>
-    void StructSerializeIn(T *obj )
+    void StructSerializeInMembers(T *obj, const auto &selector)
     {
         static_assert(serialize_key_type == SerializeKeyType::String, "Only String key type supported");
         SkipWhiteSpace();
         CheckAndIncrease('{');
         SkipWhiteSpace();
+        if (Failed()) return;
+        if (Peek('}')) {
+            ++inStream;
+            return;
+        }
         while(true) {
             auto key = SerializeInGetKey();
-            obj->SerializeInMemberByName(*this, key);
+            if (Failed()) return;
+            obj->SerializeInMemberByName(*this, key, selector);
             SkipWhiteSpace();
-            if (*inStream == '}') break;
+            if (Failed()) return;
+            if (Peek('}')) break;
             CheckAndIncrease(',');
             SkipWhiteSpace();
-            if (*inStream == '}') {
-                throw exception::BadInputData { inStream, "Unexpected ',', there next object expected after ','" };
+            if (Failed()) return;
+            if (Peek('}')) {
+                Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there next object expected after ','");
+                return;
             }
         }
         ++inStream;
     }
-}; // class json<SerializeType::In>
+}; // class JsonIn
+
+template<>
+class json<SerializeType::In> : public JsonIn<> {
+public:
+    using JsonIn<>::JsonIn;
+};
 
 template <bool beautify>
 class json_formatter {
@@ -644,10 +2055,15 @@ public:
 };
 
 
-template <bool beautify>
+template <bool beautify, EncodeMode ENCODE_MODE = EncodeMode::Default>
 class JsonOut : public json_formatter<beautify> {
 public:
     constexpr static SerializeKeyType serialize_key_type = SerializeKeyType::String;
+    constexpr static bool pack_bits = false; // Packed members are written individually
+    constexpr static EncodeMode encode_mode = ENCODE_MODE;
+
+private:
+    bool firstMember { true };
 
 public:
     JsonOut(Stream &outStream) : json_formatter<beautify> { outStream, format::compress } { }
@@ -720,18 +2136,21 @@ public:
             BeforeData();
             auto floatStr = std::to_string(value);
             outStream.Append(floatStr);
-        } else if constexpr (std::same_as<T, std::string>) {
+        } else if constexpr (typecheck::string<T>) {
             BeforeData();
             outStream.Write('"', value, '"');
         } else if constexpr (std::same_as<T, std::string_view>) { 
             BeforeData();
             outStream.Write('"', value, '"');
+        } else if constexpr (typecheck::inline_string<T>) {
+            BeforeData();
+            outStream.Write('"', value.view(), '"');
         } else if constexpr (typecheck::SerializerOutEnabledPtr<T, json<SerializeType::Out>>) {
             value->SerializeOut(*this);
         } else if constexpr (typecheck::SerializerOutEnabled<T, json<SerializeType::Out>>) {
             value.SerializeOut(*this);
         } else {
-            throw exception::UnknownSerializationType {outStream, "Unknown Serialization Type"};
+            ROHIT_THROW(exception::UnknownSerializationType {outStream, "Unknown Serialization Type"});
         }
     }
 
@@ -745,23 +2164,72 @@ public:
         SerializeOutList(value, [this](const T::value_type &val) { SerializeOut(val); });
     }
 
+    template <typecheck::inline_vector T>
+    void SerializeOut(const T &value) {
+        SerializeOutList(value, [this](const T::value_type &val) { SerializeOut(val); });
+    }
+
+    // Indentation of beautified output depends on nesting, it is written sequentially
+    template <typecheck::parallel_list T>
+    void SerializeOut(const T &value) {
+        if constexpr (beautify) SerializeOut(value.list);
+        else {
+            WriteBracketOpen();
+            SerializeOutChunks<JsonOut>(outStream, value, [](auto &serializerProtocol) { serializerProtocol.ListSerializeOutNext(); });
+            WriteBracketClose();
+        }
+    }
+
+    template <typecheck::range_list T>
+    void SerializeOut(const T &value) {
+        WriteBracketOpen();
+        bool first { true };
+        for(auto &&item: value.range) {
+            if (first) first = false;
+            else json_formatter<beautify>::template WriteComma<false>();
+            SerializeOut(item);
+        }
+        WriteBracketClose();
+    }
+
     template <typecheck::map T>
     void SerializeOut(const T &value) {
         SerializeOutList(value, [this](const T::value_type &val) { SerializeOutKeyValuePair(val); });
     }
 
-    void StructSerializeOutStart(const auto &value) {
+    void StructSerializeOutStart() {
         WriteBraceOpen();
-        SerializeOutFirst(value.first, value.second);
+        firstMember = true;
+    }
+
+    void StructSerializeOutStart(const auto &value) {
+        StructSerializeOutStart();
+        StructSerializeOut(value);
     }
 
     void StructSerializeOut(const auto &value) {
-        SerializeOutSecond(value.first, value.second);
+        if (firstMember) {
+            firstMember = false;
+            SerializeOutFirst(value.first, value.second);
+        } else SerializeOutSecond(value.first, value.second);
     }
 
     void StructSerializeOutEnd() {
         WriteBraceClose();
+        firstMember = false;
+    }
+
+    // Name of member, its value is written next
+    void StructSerializeOutName(const std::string_view name) {
+        if (firstMember) firstMember = false;
+        else json_formatter<beautify>::template WriteComma<true>();
+        SerializeOut(name);
+        WriteColon();
     }
+
+    void ListSerializeOutStart() { WriteBracketOpen(); }
+    void ListSerializeOutNext() { json_formatter<beautify>::template WriteComma<false>(); }
+    void ListSerializeOutEnd() { WriteBracketClose(); }
 }; // class JsonOut<>
 
 template <>
@@ -773,36 +2241,39 @@ public:
 template <SerializeType type, SerializeKeyType SERIALIZE_KEY_TYPE>
 class binary { };
 
-template <SerializeKeyType SERIALIZE_KEY_TYPE>
-class binaryInBase {
+template <SerializeKeyType SERIALIZE_KEY_TYPE, DecodeMode DECODE_MODE = DecodeMode::Default>
+class binaryInBase : public DecodeState<DECODE_MODE> {
 public:
     constexpr static SerializeKeyType serialize_key_type = SERIALIZE_KEY_TYPE;
+    template <DecodeMode MODE>
+    using with_decode_mode = binaryInBase<SERIALIZE_KEY_TYPE, MODE>;
 
 protected:
-    const Stream &inStream;
+    using DecodeState<DECODE_MODE>::inStream;
 
 public:
-    binaryInBase(const Stream &inStream) : inStream { inStream } { }
-
-    const auto &GetStream() { return inStream; }
-    auto &GetStream() const { return inStream; }
+    using DecodeState<DECODE_MODE>::DecodeState;
+    using DecodeState<DECODE_MODE>::Fail;
+    using DecodeState<DECODE_MODE>::Failed;
 
+    // Returns 0 on failure in NoThrow mode, 0 ends member list and is empty size
     uint32_t SerializeInVariable() {
-        if (inStream.full()) throw exception::BadInputData { inStream };
+        if (Failed()) return 0;
+        if (inStream.full()) return FailVariable();
         const uint32_t val = *inStream++;
         switch(val & 0xc0) {
             default:
             case 0x00: return val;
             case 0x40:
-                if (inStream.full()) throw exception::BadInputData { inStream };
+                if (inStream.full()) return FailVariable();
                 return ((val & 0x3f) << 8) | *inStream++;
             case 0x80: {
-                if (inStream.RemainingBuffer() < 3) throw exception::BadInputData { inStream };
+                if (inStream.RemainingBuffer() < 2) return FailVariable();
                 const uint32_t val8 = *inStream++;
                 return ((val & 0x3f) << 16) | (val8 << 8) | *inStream++;
             }
             case 0xc0: {
-                if (inStream.RemainingBuffer() < 7) throw exception::BadInputData { inStream };
+                if (inStream.RemainingBuffer() < 3) return FailVariable();
                 const uint32_t val16 = *inStream++;
                 const uint32_t val8 = *inStream++;
                 return ((val & 0x3f) << 24) | (val16 << 16) | (val8 << 8) | *inStream++;
@@ -812,29 +2283,30 @@ public:
 
     template <typename T>
     void SerializeIn(T &value) {
+        if (Failed()) return;
         if constexpr (std::is_same_v<char, T>) {
-            if (inStream.full()) throw exception::BadInputData { inStream };
+            if (inStream.full()) return Fail(ErrorKind::UnexpectedEnd);
             value = *inStream++;
         } else if constexpr (std::is_same_v<bool, T>) {
-            if (inStream.full()) throw exception::BadInputData { inStream };
+            if (inStream.full()) return Fail(ErrorKind::UnexpectedEnd);
             value = !!(*inStream++);
         } else if constexpr (std::is_enum_v<T>) {
             auto ival = SerializeInVariable();
             value = static_cast<T>(ival);
         }
         else if constexpr (std::integral<T>) {
-            if (inStream.RemainingBuffer() < sizeof(T)) throw exception::BadInputData { inStream };
+            if (inStream.RemainingBuffer() < sizeof(T)) return Fail(ErrorKind::UnexpectedEnd);
             T source = *reinterpret_cast<const T *>(inStream.curr());
             value = ChangeEndian<std::endian::big, std::endian::native>(source);
             inStream += sizeof(T);
-        } else if constexpr (std::is_same_v<std::string, T>) {
+        } else if constexpr (typecheck::string<T>) {
             // variable size following string of size
             auto size = SerializeInVariable();
-            if (inStream.RemainingBuffer() < size) throw exception::BadInputData { inStream };
-            value = std::string { inStream.curr(), inStream.curr() + size };
+            if (inStream.RemainingBuffer() < size) return Fail(ErrorKind::UnexpectedEnd);
+            value.assign(inStream.curr(), inStream.curr() + size);
             inStream += size;
         } else if constexpr (std::floating_point<T>) {
-            if (inStream.RemainingBuffer() < sizeof(T)) throw exception::BadInputData { inStream };
+            if (inStream.RemainingBuffer() < sizeof(T)) return Fail(ErrorKind::UnexpectedEnd);
             T source = *reinterpret_cast<const T *>(inStream.curr());
             value = ChangeEndian<std::endian::big, std::endian::native>(source);
             inStream += sizeof(T);
@@ -842,43 +2314,396 @@ public:
             value->SerializeIn(*this);
         } else if constexpr (typecheck::SerializerOutEnabled<T, binary<SerializeType::In, SERIALIZE_KEY_TYPE>>) {
             value.SerializeIn(*this);
+        } else if constexpr (typecheck::inline_string<T>) {
+            auto size = SerializeInInlineSize<T>();
+            const size_t slotSize = SERIALIZE_KEY_TYPE == SerializeKeyType::None ? T::static_capacity : size;
+            if (Failed()) return;
+            if (inStream.RemainingBuffer() < slotSize) return Fail(ErrorKind::UnexpectedEnd);
+            value.assign(std::string_view { reinterpret_cast<const char *>(inStream.curr()), size });
+            inStream += slotSize;
+        } else if constexpr (typecheck::inline_vector<T>) {
+            auto size = SerializeInInlineSize<T>();
+            ListDecoder<T, DECODE_MODE> decoder { value };
+            for (size_t i = 0; i < size && !Failed(); ++i) decoder.Read([this](auto &element) { SerializeIn(element); });
+            decoder.Finish();
+            if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::None) SkipInCount<typename T::value_type>(T::static_capacity - size);
         } else if constexpr (typecheck::vector<T>) {
             // variable size following vector members
+            ListDecoder<T, DECODE_MODE> decoder { value };
+            ListSerializeIn(decoder);
+        } else if constexpr (typecheck::map<T>) {
+            // variable size following map members, ordered maps are written in key order
+            // so hint at end makes loading sorted input linear
             auto size = SerializeInVariable();
-            for (size_t i = 0; i < size; ++i) {
-                typename T::value_type valuetype { };
-                SerializeIn(valuetype);
-                value.emplace_back(std::move(valuetype));
+            MapDecoder<T, DECODE_MODE> decoder { value };
+            decoder.Reserve(std::min<size_t>(size, inStream.RemainingBuffer()));
+            for (size_t i = 0; i < size && !Failed(); ++i) {
+                decoder.Read([this](auto &key, auto &mapped) {
+                    SerializeIn(key);
+                    SerializeIn(mapped);
+                });
+            }
+            decoder.Finish();
+        } else Fail(ErrorKind::BadType);
+    }
+
+    // Reads list element by element into decoder, see ListDecoder and ListStream
+    void ListSerializeIn(auto &decoder) {
+        const auto size = SerializeInVariable();
+        for (size_t i = 0; i < size && !Failed(); ++i) {
+            decoder.Read([this](auto &element) {
+                SerializeIn(element);
+                return !Failed();
+            });
+        }
+        decoder.Finish();
+    }
+
+    // List is sized once and each chunk of index.interval elements is decoded by its own protocol
+    // into its slots on pool. Index must match list, offsets are relative to start of decoding.
+    // Chunks do not throw, decoding fails with error of first failing chunk.
+    template <typecheck::vector T>
+    void ListSerializeInIndexed(T &value, const ListIndex &index, auto &pool) {
+        static_assert(!std::is_same_v<typename T::value_type, bool>, "Elements of std::vector<bool> cannot be decoded in parallel");
+        const size_t size = SerializeInVariable();
+        if (Failed()) return;
+        const size_t chunkCount { index.interval ? (size + index.interval - 1) / index.interval : 0 };
+        const size_t position = inStream.curr() - this->start;
+        if (!index.interval || index.offsets.size() != chunkCount + 1 || index.offsets.front() != position
+                || !std::is_sorted(index.offsets.begin(), index.offsets.end())
+                || index.offsets.back() - position > inStream.RemainingBuffer()) {
+            return Fail(ErrorKind::BadValue, "List index does not match input");
+        }
+        // Chunk decoder is as Default, element kept for reuse is reset in place
+        const size_t reused { DECODE_MODE == DecodeMode::Reuse ? std::min(size, value.size()) : 0 };
+        value.resize(size);
+        std::vector<DecodeStatus> status(chunkCount);
+        pool.ParallelFor(chunkCount, [this, &value, &index, &status, size, reused](const size_t chunk) {
+            const auto chunkStream = MakeConstantFullStream(this->start + index.offsets[chunk], index.offsets[chunk + 1] - index.offsets[chunk]);
+            with_decode_mode<DecodeMode::NoThrow> serializerProtocol { chunkStream };
+            const size_t end { std::min<size_t>(size, (chunk + 1) * index.interval) };
+            for(size_t element { chunk * index.interval }; element < end && !serializerProtocol.Failed(); ++element) {
+                if (element < reused) value[element] = DefaultValue<typename T::value_type>();
+                serializerProtocol.SerializeIn(value[element]);
             }
+            if (!serializerProtocol.Failed() && !chunkStream.full()) serializerProtocol.Fail(ErrorKind::BadValue, "List index does not match input");
+            status[chunk] = serializerProtocol.GetStatus();
+        });
+        for(size_t chunk { 0 }; chunk < chunkCount; ++chunk) {
+            if (status[chunk]) continue;
+            inStream += index.offsets[chunk] + status[chunk].Offset() - position;
+            return Fail(status[chunk].error(), status[chunk].Message().data());
+        }
+        inStream += index.offsets.back() - position;
+    }
+
+    // Skips a value using its type, fixed size array are skipped in one step
+    template <typename T>
+    void SkipIn() {
+        if (Failed()) return;
+        if constexpr (std::is_same_v<char, T> || std::is_same_v<bool, T>) {
+            if (inStream.full()) return Fail(ErrorKind::UnexpectedEnd);
+            ++inStream;
+        } else if constexpr (std::is_enum_v<T>) {
+            SerializeInVariable();
+        } else if constexpr (std::integral<T> || std::floating_point<T>) {
+            if (inStream.RemainingBuffer() < sizeof(T)) return Fail(ErrorKind::UnexpectedEnd);
+            inStream += sizeof(T);
+        } else if constexpr (typecheck::string<T>) {
+            auto size = SerializeInVariable();
+            if (inStream.RemainingBuffer() < size) return Fail(ErrorKind::UnexpectedEnd);
+            inStream += size;
+        } else if constexpr (typecheck::SerializerOutEnabled<T, binary<SerializeType::In, SERIALIZE_KEY_TYPE>>) {
+            T value { };
+            value.SerializeIn(*this, NoFields { });
+        } else if constexpr (typecheck::inline_string<T>) {
+            auto size = SerializeInInlineSize<T>();
+            SkipInCount<char>(SERIALIZE_KEY_TYPE == SerializeKeyType::None ? T::static_capacity : size);
+        } else if constexpr (typecheck::inline_vector<T>) {
+            auto size = SerializeInInlineSize<T>();
+            SkipInCount<typename T::value_type>(SERIALIZE_KEY_TYPE == SerializeKeyType::None ? T::static_capacity : size);
+        } else if constexpr (typecheck::vector<T>) {
+            SkipInCount<typename T::value_type>(SerializeInVariable());
         } else if constexpr (typecheck::map<T>) {
-            // variable size following map members
             auto size = SerializeInVariable();
-            for (size_t i = 0; i < size; ++i) {
-                typename T::key_type key { };
-                SerializeIn(key);
-                typename T::mapped_type valuetype { };
-                SerializeIn(valuetype);
-                value.emplace(std::move(key), std::move(valuetype));
+            for (size_t i = 0; i < size && !Failed(); ++i) {
+                SkipIn<typename T::key_type>();
+                SkipIn<typename T::mapped_type>();
+            }
+        } else Fail(ErrorKind::BadType);
+    }
+
+    // Validation walks input against schema, length prefix is used to skip, nothing is decoded or allocated
+    template <typename T>
+    void ValidateIn() {
+        if (Failed()) return;
+        if constexpr (std::is_same_v<bool, T>) {
+            if (inStream.full()) return Fail(ErrorKind::UnexpectedEnd);
+            if (*inStream > 1) return Fail(ErrorKind::BadValue, "Bad bool");
+            ++inStream;
+        } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            SkipIn<T>();
+        } else if constexpr (typecheck::string<T>) {
+            ValidateUtf8(SerializeInVariable(), 0);
+        } else if constexpr (typecheck::ValidateEnabled<T, binaryInBase>) {
+            T::ValidateIn(*this);
+        } else if constexpr (typecheck::inline_string<T>) {
+            const auto size = SerializeInInlineSize<T>();
+            ValidateUtf8(size, SERIALIZE_KEY_TYPE == SerializeKeyType::None ? T::static_capacity - size : 0);
+        } else if constexpr (typecheck::inline_vector<T>) {
+            const auto size = SerializeInInlineSize<T>();
+            ValidateInCount<typename T::value_type>(SERIALIZE_KEY_TYPE == SerializeKeyType::None ? T::static_capacity : size);
+        } else if constexpr (typecheck::vector<T>) {
+            ValidateInCount<typename T::value_type>(SerializeInVariable());
+        } else if constexpr (typecheck::map<T>) {
+            const auto size = SerializeInVariable();
+            for (size_t i = 0; i < size && !Failed(); ++i) {
+                ValidateIn<typename T::key_type>();
+                ValidateIn<typename T::mapped_type>();
+            }
+        } else Fail(ErrorKind::BadType);
+    }
+
+    // Keyed by name enum members are written as their name
+    template <typename T>
+    void ValidateEnumName() {
+        T value { };
+        SerializeInEnumName(value);
+    }
+
+    template <typename T>
+    void StructValidateIn() {
+        if (Failed() || !this->EnterNested()) return;
+        if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::Integer) {
+            while(true) {
+                auto key = SerializeInVariable();
+                if (key == 0) break;
+                T::ValidateMemberByIdentifier(*this, key);
+            }
+        } else if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::String) {
+            while(true) {
+                auto size = SerializeInVariable();
+                if (size == 0) break;
+                if (inStream.RemainingBuffer() < size) {
+                    Fail(ErrorKind::UnexpectedEnd);
+                    break;
+                }
+                const std::string_view key { reinterpret_cast<const char *>(inStream.curr()), size };
+                inStream += size;
+                T::ValidateMemberByName(*this, key);
+            }
+        } else if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::Bitmap) {
+            std::array<uint64_t, (T::serialize_slot_count + 63) / 64> presence { };
+            SerializeInBitmap(presence, T::serialize_slot_count);
+            for(size_t word { 0 }; word < presence.size(); ++word) {
+                auto bits = presence[word];
+                while(bits && !Failed()) {
+                    const auto index = static_cast<uint32_t>(word * 64 + std::countr_zero(bits));
+                    bits &= bits - 1;
+                    T::ValidateMemberByIndex(*this, index);
+                }
+            }
+        }
+        this->LeaveNested();
+    }
+
+    // Reads member value, keyed by name enum member is read from its name
+    template <typename T>
+    void TranscodeRead(T &value) {
+        if constexpr (std::is_enum_v<T> && SERIALIZE_KEY_TYPE == SerializeKeyType::String) SerializeInEnumName(value);
+        else SerializeIn(value);
+    }
+
+    // Transcoding passes each value to writer as it is read, only one leaf value is held
+    template <typename T>
+    void TranscodeIn(auto &writer) {
+        if (Failed()) return;
+        if constexpr (typecheck::TranscodeEnabled<T, binaryInBase, std::remove_reference_t<decltype(writer)>>) {
+            T::TranscodeIn(*this, writer);
+        } else if constexpr (typecheck::inline_vector<T> || typecheck::vector<T>) {
+            size_t size { };
+            if constexpr (typecheck::inline_vector<T>) size = SerializeInInlineSize<T>();
+            else size = SerializeInVariable();
+            auto frame = writer.template ListStart<T>(size);
+            for (size_t i = 0; i < size && !Failed(); ++i) {
+                writer.ListNext(frame);
+                TranscodeIn<typename T::value_type>(writer);
+            }
+            if constexpr (typecheck::inline_vector<T> && SERIALIZE_KEY_TYPE == SerializeKeyType::None) {
+                SkipInCount<typename T::value_type>(T::static_capacity - size);
+            }
+            writer.template ListEnd<T>(frame);
+        } else if constexpr (typecheck::map<T>) {
+            const auto size = SerializeInVariable();
+            auto frame = writer.template ListStart<T>(size);
+            for (size_t i = 0; i < size && !Failed(); ++i) {
+                writer.MapKey(frame);
+                TranscodeIn<typename T::key_type>(writer);
+                writer.MapValue();
+                TranscodeIn<typename T::mapped_type>(writer);
+                writer.MapEntryEnd();
+            }
+            writer.template ListEnd<T>(frame);
+        } else {
+            T value { };
+            TranscodeRead(value);
+            if (!Failed()) writer.Value(value);
+        }
+    }
+
+    template <typename T>
+    void StructTranscodeIn(auto &writer) {
+        if (Failed() || !this->EnterNested()) return;
+        auto frame = writer.template StructStart<T>();
+        if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::Integer) {
+            while(true) {
+                auto key = SerializeInVariable();
+                if (key == 0) break;
+                T::TranscodeMemberByIdentifier(*this, writer, frame, key);
+            }
+        } else if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::String) {
+            while(true) {
+                auto size = SerializeInVariable();
+                if (size == 0) break;
+                if (inStream.RemainingBuffer() < size) {
+                    Fail(ErrorKind::UnexpectedEnd);
+                    break;
+                }
+                const std::string_view key { reinterpret_cast<const char *>(inStream.curr()), size };
+                inStream += size;
+                T::TranscodeMemberByName(*this, writer, frame, key);
+            }
+        } else if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::Bitmap) {
+            std::array<uint64_t, (T::serialize_slot_count + 63) / 64> presence { };
+            SerializeInBitmap(presence, T::serialize_slot_count);
+            for(size_t word { 0 }; word < presence.size(); ++word) {
+                auto bits = presence[word];
+                while(bits && !Failed()) {
+                    const auto index = static_cast<uint32_t>(word * 64 + std::countr_zero(bits));
+                    bits &= bits - 1;
+                    T::TranscodeMemberByIndex(*this, writer, frame, index);
+                }
             }
-        } else throw exception::BadType { inStream };
+        }
+        writer.template StructEnd<T>(frame);
+        this->LeaveNested();
     }
 
+    // Skips count values of type T, arithmetic values are skipped in one step
     template <typename T>
-    void StructSerializeIn(T *obj)
+    void SkipInCount(const size_t count) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (inStream.RemainingBuffer() / sizeof(T) < count) return Fail(ErrorKind::UnexpectedEnd);
+            inStream += count * sizeof(T);
+        } else {
+            for (size_t i = 0; i < count && !Failed(); ++i) SkipIn<T>();
+        }
+    }
+
+    // binary_none writes inline size as fixed width integer followed by all the slots,
+    // other key types write variable size followed by used slots only
+    template <typename T>
+    size_t SerializeInInlineSize() {
+        size_t size { };
+        if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::None) {
+            typename T::size_type fixedSize { };
+            SerializeIn(fixedSize);
+            size = fixedSize;
+        } else size = SerializeInVariable();
+        if (size > T::static_capacity) {
+            Fail(ErrorKind::CapacityExceeded, "Size exceeds inline capacity");
+            return 0;
+        }
+        return size;
+    }
+
+    template <typename T>
+    void StructSerializeIn(T *obj) {
+        StructSerializeIn(obj, AllFields { });
+    }
+
+    template <typename T>
+    void StructSerializeIn(T *obj, const auto &selector)
+    {
+        if (Failed()) return;
+        if constexpr (DECODE_MODE == DecodeMode::Reuse) {
+            ResetTrivialMembers(*obj);
+            FieldRecorder<T, std::remove_cvref_t<decltype(selector)>> recorder { selector };
+            StructSerializeInMembers(obj, recorder);
+            ResetAbsentMembers(*obj, recorder);
+        } else StructSerializeInMembers(obj, selector);
+    }
+
+    template <typename T>
+    void StructSerializeInMembers(T *obj, const auto &selector)
     {
         if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::Integer) {
             while(true) {
                 auto key = SerializeInVariable();
                 if (key == 0) break;
-                obj->SerializeInMemberByIdentifier(*this, key);
+                obj->SerializeInMemberByIdentifier(*this, key, selector);
             }
         } else if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::String) {
             while(true) {
                 std::string key { };
                 SerializeIn(key);
                 if (key.empty()) break;
-                obj->SerializeInMemberByName(*this, key);
+                obj->SerializeInMemberByName(*this, key, selector);
             }
+        } else if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::Bitmap) {
+            std::array<uint64_t, (T::serialize_slot_count + 63) / 64> presence { };
+            SerializeInBitmap(presence, T::serialize_slot_count);
+            for(size_t word { 0 }; word < presence.size(); ++word) {
+                auto bits = presence[word];
+                while(bits && !Failed()) {
+                    const auto index = static_cast<uint32_t>(word * 64 + std::countr_zero(bits));
+                    bits &= bits - 1;
+                    obj->SerializeInMemberByIndex(*this, index, selector);
+                }
+            }
+        }
+    }
+
+    // Bit n of bitmap is bit (n % 8) of byte (n / 8)
+    template <size_t N>
+    void SerializeInBitmap(std::array<uint64_t, N> &presence, const size_t slotCount) {
+        const size_t byteCount = (slotCount + 7) / 8;
+        if (inStream.RemainingBuffer() < byteCount) return Fail(ErrorKind::UnexpectedEnd);
+        for(size_t index { 0 }; index < byteCount; ++index) {
+            presence[index / 8] |= static_cast<uint64_t>(static_cast<uint8_t>(*inStream++)) << ((index % 8) * 8);
+        }
+    }
+
+private:
+    uint32_t FailVariable() {
+        Fail(ErrorKind::UnexpectedEnd);
+        return 0;
+    }
+
+    template <typename T>
+    void SerializeInEnumName(T &value) {
+        if (Failed()) return;
+        const auto size = SerializeInVariable();
+        if (inStream.RemainingBuffer() < size) return Fail(ErrorKind::UnexpectedEnd);
+        const std::string_view name { reinterpret_cast<const char *>(inStream.curr()), size };
+        if (!Failed() && !from_string(name, value)) return Fail(ErrorKind::BadValue, "Bad Enum Name");
+        inStream += size;
+    }
+
+    // size bytes must be UTF-8, padding bytes following it are only skipped
+    void ValidateUtf8(const size_t size, const size_t padding) {
+        if (Failed()) return;
+        if (inStream.RemainingBuffer() < size + padding) return Fail(ErrorKind::UnexpectedEnd);
+        if (!IsValidUtf8(inStream.curr(), inStream.curr() + size)) return Fail(ErrorKind::BadValue, "Invalid UTF-8");
+        inStream += size + padding;
+    }
+
+    template <typename T>
+    void ValidateInCount(const size_t count) {
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<bool, T>) {
+            if (!Failed()) SkipInCount<T>(count);
+        } else {
+            for (size_t i = 0; i < count && !Failed(); ++i) ValidateIn<T>();
         }
     }
 
@@ -902,10 +2727,19 @@ public:
     using binaryInBase<SerializeKeyType::String>::binaryInBase;
 }; // class binary<SerializeType::In, SerializeKeyType::String>
 
-template <SerializeKeyType SERIALIZE_KEY_TYPE>
+template <>
+class binary<SerializeType::In, SerializeKeyType::Bitmap> : public binaryInBase<SerializeKeyType::Bitmap> {
+public:
+    using binaryInBase<SerializeKeyType::Bitmap>::binaryInBase;
+}; // class binary<SerializeType::In, SerializeKeyType::Bitmap>
+
+template <SerializeKeyType SERIALIZE_KEY_TYPE, EncodeMode ENCODE_MODE = EncodeMode::Default>
 class binaryOutBase {
 public:
     constexpr static SerializeKeyType serialize_key_type = SERIALIZE_KEY_TYPE;
+    constexpr static bool pack_bits = true; // Packed members are written as single word
+    constexpr static EncodeMode encode_mode = ENCODE_MODE;
+    static_assert(SERIALIZE_KEY_TYPE != SerializeKeyType::None || ENCODE_MODE == EncodeMode::Default, "Positional binary cannot skip members");
 
 protected:
     Stream &outStream;
@@ -991,7 +2825,7 @@ public:
             outStream += sizeof(T);
             auto dest = reinterpret_cast<T *>(outStream.curr() - sizeof(T));
             *dest = ChangeEndian<std::endian::native, std::endian::big>(value);
-        } else if constexpr (std::is_same_v<std::string, T>) {
+        } else if constexpr (typecheck::string<T>) {
             // variable size following string of size
             SerializeOutVariable(value.size());
             outStream.Append(value);
@@ -1007,11 +2841,36 @@ public:
             value->SerializeOut(*this);
         } else if constexpr (typecheck::SerializerOutEnabled<T, binary<SerializeType::Out, SERIALIZE_KEY_TYPE>>) {
             value.SerializeOut(*this);
+        } else if constexpr (typecheck::inline_string<T>) {
+            if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::None) {
+                // Fixed width, unused slots are zero
+                SerializeOut(static_cast<typename T::size_type>(value.size()));
+                outStream.Append(std::string_view { value.data(), T::static_capacity });
+            } else {
+                SerializeOutVariable(value.size());
+                outStream.Append(value.view());
+            }
+        } else if constexpr (typecheck::inline_vector<T>) {
+            if constexpr (SERIALIZE_KEY_TYPE == SerializeKeyType::None) {
+                // Fixed width, unused slots are value initialized
+                SerializeOut(static_cast<typename T::size_type>(value.size()));
+                for (size_t i = 0; i < T::static_capacity; ++i) SerializeOut(value.data()[i]);
+            } else {
+                SerializeOutVariable(value.size());
+                for (const auto &item : value) SerializeOut(item);
+            }
         } else if constexpr (typecheck::vector<T>) {
             SerializeOutVariable(value.size());
             for (const auto &item : value) {
                 SerializeOut(item);
             }
+        } else if constexpr (typecheck::range_list<T>) {
+            SerializeOutRange(value.range);
+        } else if constexpr (typecheck::indexed_list<T>) {
+            SerializeOutIndexed(value);
+        } else if constexpr (typecheck::parallel_list<T>) {
+            SerializeOutVariable(value.list.size());
+            SerializeOutChunks<binaryOutBase>(outStream, value, [](auto &) { });
         } else if constexpr (typecheck::map<T>) {
             SerializeOutVariable(value.size());
             for (const auto &item : value) {
@@ -1019,8 +2878,45 @@ public:
                 SerializeOut(item.second);
             }
         } else {
-            throw exception::BadType {outStream, "Bad Type, this is internal error."};
+            ROHIT_THROW(exception::BadType {outStream, "Bad Type, this is internal error."});
+        }
+    }
+
+    // Count of unsized range is known only at its end, widest variable size is reserved and patched
+    void SerializeOutRange(std::ranges::input_range auto &range) {
+        if constexpr (std::ranges::sized_range<decltype(range)>) {
+            SerializeOutVariable(std::ranges::size(range));
+            for (auto &&item : range) SerializeOut(item);
+        } else {
+            auto fullStream = dynamic_cast<FullStream *>(&outStream);
+            if (!fullStream) ROHIT_THROW(exception::BadType { outStream, "Unsized range needs full stream" });
+            const auto offset = fullStream->CurrentOffset();
+            outStream.WriteRaw(static_cast<uint8_t>(0xc0), static_cast<uint8_t>(0), static_cast<uint8_t>(0), static_cast<uint8_t>(0));
+            uint32_t count { 0 };
+            for (auto &&item : range) {
+                if (count == 0x3fffffff) ROHIT_THROW(exception::BadType { outStream, "Too many entries" });
+                SerializeOut(item);
+                ++count;
+            }
+            const auto bigEndian = ChangeEndian<std::endian::native, std::endian::big>(count | 0xc0000000U);
+            std::memcpy(fullStream->begin() + offset, &bigEndian, sizeof(bigEndian));
+        }
+    }
+
+    // Offset of every interval-th element and of end of list is recorded relative to base
+    void SerializeOutIndexed(const auto &value) {
+        auto fullStream = dynamic_cast<FullStream *>(&outStream);
+        if (!fullStream) ROHIT_THROW(exception::BadType { outStream, "Indexed list needs full stream" });
+        auto &index = value.index;
+        if (!index.interval) ROHIT_THROW(exception::BadType { outStream, "Index interval must not be 0" });
+        index.offsets.clear();
+        SerializeOutVariable(value.list.size());
+        for(size_t element { 0 }; element < value.list.size(); ++element) {
+            if (element % index.interval == 0) index.offsets.push_back(fullStream->CurrentOffset() - value.base);
+            const typename std::remove_cvref_t<decltype(value.list)>::value_type &item = value.list[element];
+            SerializeOut(item);
         }
+        index.offsets.push_back(fullStream->CurrentOffset() - value.base);
     }
 
     template <typecheck::functions T>
@@ -1028,6 +2924,16 @@ public:
         value(outStream);
     }
 
+    void StructSerializeOutStart() { }
+
+    template <size_t N>
+    void StructSerializeOutBitmap(const std::array<uint64_t, N> &presence, const size_t slotCount) {
+        const size_t byteCount = (slotCount + 7) / 8;
+        for(size_t index { 0 }; index < byteCount; ++index) {
+            outStream.WriteRaw(static_cast<uint8_t>(presence[index / 8] >> ((index % 8) * 8)));
+        }
+    }
+
     void StructSerializeOutStart(const auto &value) {
         StructSerializeOut(value);
     }
@@ -1064,6 +2970,174 @@ public:
     using binaryOutBase<SerializeKeyType::String>::binaryOutBase;
 }; // class binary<SerializeType::Out, SerializeKeyType::String>
 
+template <>
+class binary<SerializeType::Out, SerializeKeyType::Bitmap> : public binaryOutBase<SerializeKeyType::Bitmap> {
+public:
+    using binaryOutBase<SerializeKeyType::Bitmap>::binaryOutBase;
+}; // class binary<SerializeType::Out, SerializeKeyType::Bitmap>
+
+// Writes values of a transcoded class in output protocol as they are read from input protocol, no object is
+// built. Sizes and bitmaps not known when binary output reaches them are reserved and patched later, hence
+// output must be a full stream. Positional output needs members in schema order, missing ones are written
+// with their default value.
+template <typename SerializeOutProtocol, typename SerializeInProtocol>
+class TranscodeWriter : public SerializeOutProtocol {
+public:
+    static constexpr size_t unknown_size { std::numeric_limits<size_t>::max() };
+
+    struct Frame {
+        size_t offset { unknown_size };
+        size_t packedOffset { unknown_size };
+        size_t count { 0 };
+        uint32_t nextIndex { 0 };
+    };
+
+private:
+    static constexpr bool is_json { std::is_base_of_v<json_formatter<false>, SerializeOutProtocol> || std::is_base_of_v<json_formatter<true>, SerializeOutProtocol> };
+    static constexpr SerializeKeyType out_key_type { SerializeOutProtocol::serialize_key_type };
+    FullStream &fullStream;
+    SerializeInProtocol &serializerInProtocol;
+
+    template <typename T>
+    void Patch(const size_t offset, const T value) {
+        const auto bigEndian = ChangeEndian<std::endian::native, std::endian::big>(value);
+        std::memcpy(fullStream.begin() + offset, &bigEndian, sizeof(T));
+    }
+
+    template <typename T>
+    T ReadPatched(const size_t offset) const {
+        T value { };
+        std::memcpy(&value, fullStream.begin() + offset, sizeof(T));
+        return ChangeEndian<std::endian::big, std::endian::native>(value);
+    }
+
+public:
+    TranscodeWriter(FullStream &fullStream, SerializeInProtocol &serializerInProtocol)
+        : SerializeOutProtocol { fullStream }, fullStream { fullStream }, serializerInProtocol { serializerInProtocol } { }
+    TranscodeWriter(const TranscodeWriter &) = delete;
+    TranscodeWriter &operator=(const TranscodeWriter &) = delete;
+
+    template <typename T>
+    Frame StructStart() {
+        Frame frame { };
+        if constexpr (is_json) this->StructSerializeOutStart();
+        else if constexpr (out_key_type == SerializeKeyType::Bitmap) {
+            frame.offset = fullStream.CurrentOffset();
+            for(size_t index { 0 }; index < (T::serialize_slot_count + 7) / 8; ++index) fullStream.WriteRaw(static_cast<uint8_t>(0));
+        }
+        return frame;
+    }
+
+    template <typename T>
+    void StructEnd(Frame &frame) {
+        if constexpr (is_json) this->StructSerializeOutEnd();
+        else if constexpr (out_key_type == SerializeKeyType::None) {
+            while(frame.nextIndex < T::serialize_slot_count) T::TranscodeDefault(*this, frame.nextIndex++);
+        } else this->StructSerializeOutEnd();
+    }
+
+    // Key of member whose value is written next, index is slot of member as in bitmap
+    template <typename T>
+    void Member(Frame &frame, const uint32_t identifier, const std::string_view name, const uint32_t index) {
+        if constexpr (is_json) this->StructSerializeOutName(name);
+        else if constexpr (out_key_type == SerializeKeyType::Integer) this->SerializeOutVariable(identifier);
+        else if constexpr (out_key_type == SerializeKeyType::String) this->SerializeOut(name);
+        else {
+            if (index < frame.nextIndex) return serializerInProtocol.Fail(ErrorKind::BadValue, "Member out of schema order");
+            if constexpr (out_key_type == SerializeKeyType::Bitmap) {
+                fullStream.begin()[frame.offset + index / 8] |= static_cast<uint8_t>(1U << (index % 8));
+            } else {
+                while(frame.nextIndex < index) T::TranscodeDefault(*this, frame.nextIndex++);
+            }
+            frame.nextIndex = index + 1;
+        }
+    }
+
+    // Name of union member carries its type, other keys are followed by index of type
+    template <typename T>
+    void UnionMember(Frame &frame, const uint32_t identifier, const std::string_view name, const uint32_t index, const uint32_t typeIndex) {
+        Member<T>(frame, identifier, name, index);
+        if constexpr (!is_json && out_key_type != SerializeKeyType::String) this->SerializeOutVariable(typeIndex);
+    }
+
+    // Packed member read on its own is placed in packed word, word is written at first of them
+    template <typename T, typename P>
+    void PackedMember(Frame &frame, const uint32_t identifier, const uint32_t index, const P initial, const P value, const uint32_t shift, const P mask) {
+        if (frame.packedOffset == unknown_size) {
+            Member<T>(frame, identifier, "#bits", index);
+            frame.packedOffset = fullStream.CurrentOffset();
+            this->SerializeOut(initial);
+        }
+        const auto word = ReadPatched<P>(frame.packedOffset);
+        Patch(frame.packedOffset, static_cast<P>((word & ~static_cast<P>(mask << shift)) | ((value & mask) << shift)));
+    }
+
+    // Member enum is written as name by name keyed protocols
+    template <typename T>
+    void Value(const T &value) {
+        if constexpr (std::is_enum_v<T> && out_key_type == SerializeKeyType::String) this->SerializeOut(to_string(value));
+        else this->SerializeOut(value);
+    }
+
+    // Value of member missing in positional input
+    void Default(const auto &value) { this->SerializeOut(value); }
+
+    template <typename T>
+    Frame ListStart(const size_t size = unknown_size) {
+        Frame frame { };
+        if constexpr (is_json) {
+            this->ListSerializeOutStart();
+        } else {
+            if (size == unknown_size) frame.offset = fullStream.CurrentOffset();
+            if constexpr (typecheck::inline_vector<T> && out_key_type == SerializeKeyType::None) {
+                this->SerializeOut(static_cast<typename T::size_type>(size == unknown_size ? 0 : size));
+            } else if (size == unknown_size) {
+                // Widest variable encoding, value is patched at end
+                fullStream.WriteRaw(static_cast<uint8_t>(0xc0), static_cast<uint8_t>(0), static_cast<uint8_t>(0), static_cast<uint8_t>(0));
+            } else this->SerializeOutVariable(size);
+        }
+        return frame;
+    }
+
+    void ListNext(Frame &frame) {
+        if constexpr (is_json) {
+            if (frame.count) this->ListSerializeOutNext();
+        }
+        ++frame.count;
+    }
+
+    template <typename T>
+    void ListEnd(Frame &frame) {
+        if constexpr (is_json) {
+            this->ListSerializeOutEnd();
+        } else {
+            if constexpr (typecheck::inline_vector<T> && out_key_type == SerializeKeyType::None) {
+                for(auto index = frame.count; index < T::static_capacity; ++index) this->SerializeOut(typename T::value_type { });
+                if (frame.offset != unknown_size) Patch(frame.offset, static_cast<typename T::size_type>(frame.count));
+            } else if (frame.offset != unknown_size) {
+                if (frame.count > 0x3fffffff) return serializerInProtocol.Fail(ErrorKind::CapacityExceeded, "Too many entries");
+                Patch(frame.offset, static_cast<uint32_t>(frame.count | 0xc0000000));
+            }
+        }
+    }
+
+    void MapKey(Frame &frame) {
+        ListNext(frame);
+        if constexpr (is_json) {
+            this->StructSerializeOutStart();
+            this->StructSerializeOutName("key");
+        }
+    }
+
+    void MapValue() {
+        if constexpr (is_json) this->StructSerializeOutName("value");
+    }
+
+    void MapEntryEnd() {
+        if constexpr (is_json) this->StructSerializeOutEnd();
+    }
+}; // class TranscodeWriter
+
 template <SerializeType type>
 using binary_integer = binary<type, SerializeKeyType::Integer>;
 
@@ -1073,4 +3147,39 @@ using binary_string = binary<type, SerializeKeyType::String>;
 template <SerializeType type>
 using binary_none = binary<type, SerializeKeyType::None>;
 
+template <SerializeType type>
+using binary_bitmap = binary<type, SerializeKeyType::Bitmap>;
+
+// Sparse output skips default members, input is same as non sparse
+template <SerializeType type>
+using json_sparse = std::conditional_t<type == SerializeType::In, json<SerializeType::In>, JsonOut<false, EncodeMode::Sparse>>;
+
+template <SerializeType type>
+using binary_integer_sparse = std::conditional_t<type == SerializeType::In,
+    binary<SerializeType::In, SerializeKeyType::Integer>, binaryOutBase<SerializeKeyType::Integer, EncodeMode::Sparse>>;
+
+template <SerializeType type>
+using binary_string_sparse = std::conditional_t<type == SerializeType::In,
+    binary<SerializeType::In, SerializeKeyType::String>, binaryOutBase<SerializeKeyType::String, EncodeMode::Sparse>>;
+
+// Reuse input decodes into existing object keeping its allocations, output is same as non reuse
+template <SerializeType type>
+using json_reuse = std::conditional_t<type == SerializeType::In, JsonIn<DecodeMode::Reuse>, json<SerializeType::Out>>;
+
+template <SerializeType type>
+using binary_none_reuse = std::conditional_t<type == SerializeType::In,
+    binaryInBase<SerializeKeyType::None, DecodeMode::Reuse>, binary<SerializeType::Out, SerializeKeyType::None>>;
+
+template <SerializeType type>
+using binary_integer_reuse = std::conditional_t<type == SerializeType::In,
+    binaryInBase<SerializeKeyType::Integer, DecodeMode::Reuse>, binary<SerializeType::Out, SerializeKeyType::Integer>>;
+
+template <SerializeType type>
+using binary_string_reuse = std::conditional_t<type == SerializeType::In,
+    binaryInBase<SerializeKeyType::String, DecodeMode::Reuse>, binary<SerializeType::Out, SerializeKeyType::String>>;
+
+template <SerializeType type>
+using binary_bitmap_reuse = std::conditional_t<type == SerializeType::In,
+    binaryInBase<SerializeKeyType::Bitmap, DecodeMode::Reuse>, binary<SerializeType::Out, SerializeKeyType::Bitmap>>;
+
 } // namespace rohit::serializer
\ No newline at end of file
@@ -111,7 +111,9 @@ enum class ObjectType {
 
 enum class ClassAtributes : uint8_t {
     None = 0x00,
-    Packed = 0x01
+    Packed = 0x01,
+    BitPacked = 0x02, // Pack bool and small enum into a single word in binary
+    BitField = 0x04 // Packed members are generated as C++ bit-field
 };
 
 struct Namespace;
@@ -151,12 +153,13 @@ struct Namespace : public Base {
 struct TypeName {
     TypeName(std::string &&Name, Namespace *declaredNameSpace) : Name { std::move(Name) }, EnumName { }, declaredNameSpace { declaredNameSpace } { }
     TypeName(std::string &&Name, std::string &&EnumName, Namespace *declaredNameSpace) : Name { std::move(Name) }, EnumName { std::move(EnumName) }, declaredNameSpace { declaredNameSpace } { }
-    TypeName(const TypeName &rhs) : Name { rhs.Name }, EnumName { rhs.EnumName }, declaredNameSpace { rhs.declaredNameSpace }, definedNameSpace { definedNameSpace } { }
+    TypeName(const TypeName &rhs) : Name { rhs.Name }, EnumName { rhs.EnumName }, declaredNameSpace { rhs.declaredNameSpace }, definedNameSpace { rhs.definedNameSpace }, type { rhs.type } { }
     TypeName &operator=(const TypeName &rhs) {
         Name = rhs.Name;
         EnumName = rhs.EnumName;
         declaredNameSpace = rhs.declaredNameSpace;
         definedNameSpace = rhs.definedNameSpace;
+        type = rhs.type;
         return *this;
     }
 
@@ -184,6 +187,8 @@ struct Member {
         none,
         array,
         map,
+        hashmap,
+        flatmap,
         Union
     };
     AccessType access;
@@ -194,8 +199,10 @@ struct Member {
     uint32_t id;
     std::string Key; // Optional parameter
     std::string defaultValue;
+    uint32_t bitCount { }; // Non zero for bits(N) member
+    uint32_t capacity { }; // Non zero for array[N] and string[N] member
 
-    bool operator==(const Member &rhs) const { return access == rhs.access && modifer == rhs.modifer && typeNameList == rhs.typeNameList && Name == rhs.Name; }
+    bool operator==(const Member &rhs) const { return access == rhs.access && modifer == rhs.modifer && typeNameList == rhs.typeNameList && Name == rhs.Name && bitCount == rhs.bitCount && capacity == rhs.capacity; }
 };
 
 struct Class;
@@ -253,6 +260,36 @@ void ParseClassBody(const Stream &inStream, Class *obj, uint32_t &id);
 } // namespace Parser
 
 namespace Writer::CPP {
+enum class MemberLayout {
+    Declared, // Members are emitted in .def order
+    Optimized // Members are emitted by alignment to reduce padding, wire order is unchanged
+};
+
+enum class Allocator {
+    Standard, // std::string, std::vector and std::map
+    Pmr // std::pmr containers, class is allocator aware and passes its allocator to members
+};
+
+struct Options {
+    MemberLayout layout { MemberLayout::Declared };
+    Allocator allocator { Allocator::Standard };
+};
+
+// Size is estimated using sizeof and alignof of generator host
+struct ClassLayoutReport {
+    std::string name { };
+    size_t sizeDeclared { };
+    size_t paddingDeclared { };
+    size_t sizeOptimized { };
+    size_t paddingOptimized { };
+};
+
 void Write(Stream &outStream, std::vector<std::unique_ptr<Base>> &statementlist);
+void Write(Stream &outStream, std::vector<std::unique_ptr<Base>> &statementlist, const Options &options);
+std::vector<ClassLayoutReport> GetLayoutReport(const std::vector<std::unique_ptr<Base>> &statementlist);
+std::vector<ClassLayoutReport> GetLayoutReport(const std::vector<std::unique_ptr<Base>> &statementlist, const Options &options);
+
+// Number of bits used by member in packed word, zero if member is not packed
+uint32_t GetPackedBitCount(const Class *obj, const Member &member);
 } // namespace Writer::CPP
 } // namespace rohit::serializer
\ No newline at end of file
@@ -0,0 +1,736 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <rohit/serializercreator.h>
+#include <rohit/serializer.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <bit>
+#include <type_traits>
+
+// Runtime schema, classes of a parsed .def are compiled to a flat list of operations each
+// and values are read and written in any protocol without generated code. Output is same
+// as output of generated class for same schema.
+namespace rohit::serializer::Runtime {
+
+// Type of value, element of list or mapped value of map
+enum class OpCode : uint8_t {
+    Bool,
+    Char,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Float,
+    Double,
+    String,
+    Enum,
+    Object
+};
+
+// How member is stored in its class
+enum class OpShape : uint8_t {
+    Value,
+    Parent, // Parent class written as a nested object
+    List,
+    Map,
+    Union,
+    Packed // Member of packed word, binary writes all of them at first packed member
+};
+
+struct Op {
+    OpShape shape { };
+    OpCode code { };
+    OpCode keyCode { }; // Type of map key
+    uint8_t shift { }; // Position of packed member in packed word
+    uint8_t bitCount { }; // Width of packed member
+    uint16_t capacity { }; // Non zero for inline string and inline list
+    uint16_t alternativeCount { }; // Number of types of union
+    uint32_t id { };
+    uint32_t slot { }; // Bitmap slot, all packed members share a slot
+    uint32_t type { }; // Index of class or enum, index of first alternative for union
+    uint32_t key { }; // Index of name in keys, union has one name for each alternative
+};
+
+struct Alternative {
+    OpCode code { };
+    uint32_t type { };
+};
+
+// Name of member in string keyed protocols
+struct Key {
+    size_t hash { };
+    std::string name { };
+    uint32_t op { };
+    uint32_t alternative { };
+};
+
+// Value of any type of schema. Bool, char, integer and enum are kept in scalar, floating point
+// as bits of double. Object has one item for each op of its class, list has its elements,
+// map has key followed by value for each entry and union has one item of type in scalar.
+struct DynamicValue {
+    uint64_t scalar { };
+    std::string text { };
+    std::vector<DynamicValue> items { };
+
+    template <typename T>
+    T Get() const {
+        if constexpr (std::floating_point<T>) return static_cast<T>(std::bit_cast<double>(scalar));
+        else if constexpr (std::is_same_v<T, bool>) return scalar != 0;
+        else return static_cast<T>(scalar);
+    }
+
+    template <typename T>
+    void Set(const T value) {
+        if constexpr (std::floating_point<T>) scalar = std::bit_cast<uint64_t>(static_cast<double>(value));
+        else if constexpr (std::signed_integral<T>) scalar = static_cast<uint64_t>(static_cast<int64_t>(value));
+        else scalar = static_cast<uint64_t>(value);
+    }
+
+    bool operator==(const DynamicValue &rhs) const = default;
+};
+
+struct ClassPlan {
+    static constexpr uint32_t none { std::numeric_limits<uint32_t>::max() };
+    static constexpr uint32_t packed_word { std::numeric_limits<uint32_t>::max() }; // Alternative of "#bits" key
+
+    std::string name { };
+    std::vector<Op> ops { }; // Parents followed by members in .def order
+    std::vector<std::string> memberNames { }; // C++ name of each op
+    std::vector<Key> keys { };
+    std::vector<std::pair<size_t, uint32_t>> keyHashes { }; // Sorted hash and index of key, names are looked up by binary search
+    std::vector<Alternative> alternatives { };
+    std::vector<uint32_t> identifiers { }; // Op by member identifier, none when there is no such member
+    std::vector<std::pair<uint32_t, uint32_t>> identifierList { }; // Sorted identifier and op, used when identifiers are too sparse for table
+    std::vector<uint32_t> slots { }; // First op of each bitmap slot
+    uint32_t packedOp { none }; // First packed op
+    uint32_t packedSize { }; // Bytes in packed word
+    uint64_t packedDefault { };
+    DynamicValue defaultObject { };
+
+    const Key *FindKey(const std::string_view keyName) const {
+        const auto hash = rohit::Hash(keyName);
+        for(auto itr = std::lower_bound(keyHashes.begin(), keyHashes.end(), std::make_pair(hash, 0U)); itr != keyHashes.end() && itr->first == hash; ++itr) {
+            auto &key = keys[itr->second];
+            if (key.name == keyName) return &key;
+        }
+        return nullptr;
+    }
+
+    uint32_t FindIdentifier(const uint32_t identifier) const {
+        if (!identifierList.empty()) {
+            auto itr = std::lower_bound(identifierList.begin(), identifierList.end(), std::make_pair(identifier, 0U));
+            return itr != identifierList.end() && itr->first == identifier ? itr->second : none;
+        }
+        return identifier < identifiers.size() ? identifiers[identifier] : none;
+    }
+
+    uint64_t GetPackedWord(const DynamicValue &object) const {
+        uint64_t word { 0 };
+        if (packedOp == none) return word;
+        for(uint32_t index { packedOp }; index < ops.size(); ++index) {
+            auto &op = ops[index];
+            if (op.shape != OpShape::Packed) continue;
+            const auto mask = op.bitCount >= 64 ? ~0ULL : (1ULL << op.bitCount) - 1;
+            word |= (object.items[index].scalar & mask) << op.shift;
+        }
+        return word;
+    }
+
+    void SetPackedWord(DynamicValue &object, const uint64_t word) const {
+        for(uint32_t index { packedOp }; index < ops.size(); ++index) {
+            auto &op = ops[index];
+            if (op.shape != OpShape::Packed) continue;
+            const auto mask = op.bitCount >= 64 ? ~0ULL : (1ULL << op.bitCount) - 1;
+            object.items[index].scalar = (word >> op.shift) & mask;
+        }
+    }
+};
+
+struct EnumPlan {
+    std::string name { };
+    std::vector<std::string> names { };
+
+    // Index of enum value, none when name is not found
+    uint32_t Find(const std::string_view valueName) const {
+        for(uint32_t index { 0 }; index < names.size(); ++index) {
+            if (names[index] == valueName) return index;
+        }
+        return ClassPlan::none;
+    }
+};
+
+// Calls function with std::type_identity of C++ type of primitive code
+template <typename Function>
+void VisitPrimitive(const OpCode code, Function &&function) {
+    switch(code) {
+    case OpCode::Bool: function(std::type_identity<bool> { }); break;
+    case OpCode::Char: function(std::type_identity<char> { }); break;
+    case OpCode::Int8: function(std::type_identity<int8_t> { }); break;
+    case OpCode::Int16: function(std::type_identity<int16_t> { }); break;
+    case OpCode::Int32: function(std::type_identity<int32_t> { }); break;
+    case OpCode::Int64: function(std::type_identity<int64_t> { }); break;
+    case OpCode::UInt8: function(std::type_identity<uint8_t> { }); break;
+    case OpCode::UInt16: function(std::type_identity<uint16_t> { }); break;
+    case OpCode::UInt32: function(std::type_identity<uint32_t> { }); break;
+    case OpCode::UInt64: function(std::type_identity<uint64_t> { }); break;
+    case OpCode::Float: function(std::type_identity<float> { }); break;
+    case OpCode::Double: function(std::type_identity<double> { }); break;
+    default: break;
+    }
+}
+
+// Calls function with std::type_identity of unsigned type of size bytes
+template <typename Function>
+void VisitUnsigned(const size_t size, Function &&function) {
+    switch(size) {
+    case 1: function(std::type_identity<uint8_t> { }); break;
+    case 2: function(std::type_identity<uint16_t> { }); break;
+    case 4: function(std::type_identity<uint32_t> { }); break;
+    default: function(std::type_identity<uint64_t> { }); break;
+    }
+}
+
+template <typename SerializeInProtocol>
+class SchemaReader;
+
+template <typename SerializeOutProtocol>
+class SchemaWriter;
+
+// Compiled form of all classes and enums of a parsed .def, class is referred by its index.
+// Compilation throws std::invalid_argument for a schema it cannot represent.
+class Schema {
+    std::vector<ClassPlan> classes { };
+    std::vector<EnumPlan> enums { };
+
+public:
+    Schema(const std::vector<std::unique_ptr<Base>> &statementlist);
+
+    // Full name is with namespace, e.g. arraytest::person
+    uint32_t FindClass(const std::string_view fullName) const;
+    // Index of item of member in object, member is C++ name of member or name of parent
+    uint32_t FindMember(const uint32_t classIndex, const std::string_view memberName) const;
+
+    const ClassPlan &GetClass(const uint32_t classIndex) const { return classes[classIndex]; }
+    const EnumPlan &GetEnum(const uint32_t enumIndex) const { return enums[enumIndex]; }
+    size_t ClassCount() const { return classes.size(); }
+
+    // Object with default value of all members
+    const DynamicValue &NewObject(const uint32_t classIndex) const { return classes[classIndex].defaultObject; }
+    DynamicValue DefaultValue(const OpCode code, const uint32_t type) const {
+        if (code == OpCode::Object) return classes[type].defaultObject;
+        return { };
+    }
+
+    template <template<SerializeType> class SerializerProtocol>
+    void SerializeOut(const uint32_t classIndex, const DynamicValue &value, Stream &stream) const {
+        SchemaWriter<SerializerProtocol<SerializeType::Out>> writer { *this, stream };
+        writer.WriteObject(classIndex, value);
+    }
+
+    template <template<SerializeType> class SerializerProtocol>
+    DynamicValue SerializeIn(const uint32_t classIndex, const Stream &stream) const {
+        DynamicValue value { NewObject(classIndex) };
+        SchemaReader<SerializerProtocol<SerializeType::In>> reader { *this, stream };
+        reader.ReadObject(classIndex, value);
+        return value;
+    }
+
+    // Bad input is reported in returned status as in TrySerializeIn of generated class
+    template <template<SerializeType> class SerializerProtocol>
+    DecodeStatus TrySerializeIn(const uint32_t classIndex, const Stream &stream, DynamicValue &value) const {
+        using SerializerInProtocol = typename SerializerProtocol<SerializeType::In>::template with_decode_mode<DecodeMode::NoThrow>;
+        value = NewObject(classIndex);
+        SchemaReader<SerializerInProtocol> reader { *this, stream };
+        reader.ReadObject(classIndex, value);
+        return reader.GetStatus();
+    }
+}; // class Schema
+
+// Reads class of schema in input protocol, derived from protocol for its tokenizer
+template <typename SerializeInProtocol>
+class SchemaReader : public SerializeInProtocol {
+    static constexpr bool is_json { std::is_base_of_v<JsonIn<SerializeInProtocol::decode_mode>, SerializeInProtocol> };
+    static constexpr SerializeKeyType key_type { SerializeInProtocol::serialize_key_type };
+    const Schema &schema;
+
+    using SerializeInProtocol::inStream;
+
+public:
+    using SerializeInProtocol::Fail;
+    using SerializeInProtocol::Failed;
+
+    SchemaReader(const Schema &schema, const Stream &stream) : SerializeInProtocol { stream }, schema { schema } { }
+    SchemaReader(const SchemaReader &) = delete;
+    SchemaReader &operator=(const SchemaReader &) = delete;
+
+    void ReadObject(const uint32_t classIndex, DynamicValue &object) {
+        if (Failed()) return;
+        auto &plan = schema.GetClass(classIndex);
+        if constexpr (is_json) {
+            this->SkipWhiteSpace();
+            this->CheckAndIncrease('{');
+            this->SkipWhiteSpace();
+            if (Failed()) return;
+            if (this->Peek('}')) {
+                ++inStream;
+                return;
+            }
+            while(true) {
+                auto key = this->SerializeInGetKey();
+                if (Failed()) return;
+                ReadMemberByName(plan, key, object);
+                this->SkipWhiteSpace();
+                if (Failed()) return;
+                if (this->Peek('}')) break;
+                this->CheckAndIncrease(',');
+                this->SkipWhiteSpace();
+                if (Failed()) return;
+                if (this->Peek('}')) {
+                    Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there next object expected after ','");
+                    return;
+                }
+            }
+            ++inStream;
+        } else if constexpr (key_type == SerializeKeyType::None) {
+            for(uint32_t index { 0 }; index < plan.slots.size() && !Failed(); ++index) ReadSlot(plan, plan.slots[index], object);
+        } else if constexpr (key_type == SerializeKeyType::Integer) {
+            while(!Failed()) {
+                const auto identifier = this->SerializeInVariable();
+                if (identifier == 0) break;
+                const auto opIndex = plan.FindIdentifier(identifier);
+                if (opIndex == ClassPlan::none) return Fail(ErrorKind::UnknownKey, "Bad Member Identifier");
+                ReadSlot(plan, opIndex, object);
+            }
+        } else if constexpr (key_type == SerializeKeyType::String) {
+            while(!Failed()) {
+                const auto key = ReadName();
+                if (key.empty()) break;
+                ReadMemberByName(plan, key, object);
+            }
+        } else if constexpr (key_type == SerializeKeyType::Bitmap) {
+            const size_t byteCount = (plan.slots.size() + 7) / 8;
+            if (inStream.RemainingBuffer() < byteCount) return Fail(ErrorKind::UnexpectedEnd);
+            const auto bitmap = inStream.curr();
+            inStream += byteCount;
+            for(size_t byteIndex { 0 }; byteIndex < byteCount; ++byteIndex) {
+                auto bits = static_cast<uint32_t>(bitmap[byteIndex]);
+                while(bits && !Failed()) {
+                    const auto slot = byteIndex * 8 + static_cast<size_t>(std::countr_zero(bits));
+                    bits &= bits - 1;
+                    if (slot >= plan.slots.size()) return Fail(ErrorKind::UnknownKey, "Bad Member Index");
+                    ReadSlot(plan, plan.slots[slot], object);
+                }
+            }
+        }
+    }
+
+private:
+    // Reads member at its slot in binary, packed slot is whole packed word and union has index of its type
+    void ReadSlot(const ClassPlan &plan, const uint32_t opIndex, DynamicValue &object) {
+        auto &op = plan.ops[opIndex];
+        if (op.shape == OpShape::Packed) ReadPackedWord(plan, object);
+        else if (op.shape == OpShape::Union) {
+            const auto alternative = this->SerializeInVariable();
+            if (Failed()) return;
+            ReadUnion(plan, op, alternative, object.items[opIndex]);
+        } else ReadMember(op, object.items[opIndex], false);
+    }
+
+    void ReadMemberByName(const ClassPlan &plan, const std::string_view keyName, DynamicValue &object) {
+        auto key = plan.FindKey(keyName);
+        if (!key) return Fail(ErrorKind::UnknownKey, "Bad Member Name");
+        auto &op = plan.ops[key->op];
+        if (key->alternative == ClassPlan::packed_word) ReadPackedWord(plan, object);
+        else if (op.shape == OpShape::Union) ReadUnion(plan, op, key->alternative, object.items[key->op]);
+        else ReadMember(op, object.items[key->op], key_type == SerializeKeyType::String);
+    }
+
+    void ReadPackedWord(const ClassPlan &plan, DynamicValue &object) {
+        VisitUnsigned(plan.packedSize, [this, &plan, &object](auto type) {
+            typename decltype(type)::type word { };
+            SerializeInProtocol::SerializeIn(word);
+            if (!Failed()) plan.SetPackedWord(object, word);
+        });
+    }
+
+    void ReadUnion(const ClassPlan &plan, const Op &op, const uint32_t alternative, DynamicValue &value) {
+        if (alternative >= op.alternativeCount) return Fail(ErrorKind::UnknownKey, "Bad Enum Name");
+        auto &type = plan.alternatives[op.type + alternative];
+        value.scalar = alternative;
+        value.items.assign(1, schema.DefaultValue(type.code, type.type));
+        ReadValue(type.code, type.type, 0, value.items[0], is_json);
+    }
+
+    // Enum member is read from its name in string keyed protocols
+    void ReadMember(const Op &op, DynamicValue &value, const bool enumByName) {
+        switch(op.shape) {
+        case OpShape::Parent:
+            ReadObject(op.type, value);
+            break;
+        case OpShape::List:
+            ReadList(op, value);
+            break;
+        case OpShape::Map:
+            ReadMap(op, value);
+            break;
+        default:
+            ReadValue(op.code, op.type, op.capacity, value, enumByName);
+            break;
+        }
+    }
+
+    void ReadValue(const OpCode code, const uint32_t type, const uint16_t capacity, DynamicValue &value, const bool enumByName) {
+        if (Failed()) return;
+        if (code == OpCode::Object) ReadObject(type, value);
+        else if (code == OpCode::String) {
+            if (capacity) ReadInlineString(capacity, value);
+            else SerializeInProtocol::SerializeIn(value.text);
+        } else if (code == OpCode::Enum) {
+            if (is_json || enumByName) {
+                const auto name = ReadName();
+                if (Failed()) return;
+                const auto index = schema.GetEnum(type).Find(name);
+                if (index == ClassPlan::none) return Fail(ErrorKind::BadValue, "Bad Enum Name");
+                value.scalar = index;
+            } else if constexpr (!is_json) value.scalar = this->SerializeInVariable();
+        } else {
+            VisitPrimitive(code, [this, &value](auto valueType) {
+                typename decltype(valueType)::type primitive { };
+                SerializeInProtocol::SerializeIn(primitive);
+                value.Set(primitive);
+            });
+        }
+    }
+
+    // Returned name points to input
+    std::string_view ReadName() {
+        if constexpr (is_json) return this->ValidateString(std::numeric_limits<size_t>::max());
+        else {
+            const auto size = this->SerializeInVariable();
+            if (Failed()) return { };
+            if (inStream.RemainingBuffer() < size) {
+                Fail(ErrorKind::UnexpectedEnd);
+                return { };
+            }
+            const std::string_view name { reinterpret_cast<const char *>(inStream.curr()), size };
+            inStream += size;
+            return name;
+        }
+    }
+
+    // binary_none writes inline size as fixed width integer followed by all the slots
+    size_t ReadInlineSize(const uint16_t capacity) {
+        size_t size { };
+        if constexpr (key_type == SerializeKeyType::None) {
+            VisitUnsigned(capacity <= UINT8_MAX ? 1 : 2, [this, &size](auto type) {
+                typename decltype(type)::type fixedSize { };
+                SerializeInProtocol::SerializeIn(fixedSize);
+                size = fixedSize;
+            });
+        } else size = this->SerializeInVariable();
+        if (size > capacity) {
+            Fail(ErrorKind::CapacityExceeded, "Size exceeds inline capacity");
+            return 0;
+        }
+        return size;
+    }
+
+    void ReadInlineString(const uint16_t capacity, DynamicValue &value) {
+        if constexpr (is_json) {
+            SerializeInProtocol::SerializeIn(value.text);
+            if (value.text.size() > capacity) Fail(ErrorKind::CapacityExceeded, "String exceeds inline capacity");
+        } else {
+            const auto size = ReadInlineSize(capacity);
+            const size_t slotSize = key_type == SerializeKeyType::None ? capacity : size;
+            if (Failed()) return;
+            if (inStream.RemainingBuffer() < slotSize) return Fail(ErrorKind::UnexpectedEnd);
+            value.text.assign(reinterpret_cast<const char *>(inStream.curr()), size);
+            inStream += slotSize;
+        }
+    }
+
+    DynamicValue &AddItem(const OpCode code, const uint32_t type, DynamicValue &value) {
+        return value.items.emplace_back(schema.DefaultValue(code, type));
+    }
+
+    void ReadList(const Op &op, DynamicValue &value) {
+        value.items.clear();
+        if constexpr (is_json) {
+            this->CheckAndIncrease('[');
+            this->SkipWhiteSpace();
+            if (Failed() || this->Peek(']')) return this->CheckAndIncrease(']');
+            while(true) {
+                if (op.capacity && value.items.size() == op.capacity) return Fail(ErrorKind::CapacityExceeded, "Array exceeds inline capacity");
+                ReadValue(op.code, op.type, 0, AddItem(op.code, op.type, value), true);
+                this->SkipWhiteSpace();
+                if (Failed()) return;
+                if (this->Peek(']')) break;
+                this->CheckAndIncrease(',');
+                this->SkipWhiteSpace();
+                if (Failed()) return;
+                if (this->Peek(']')) return Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there must be next array entry after ','");
+            }
+            this->CheckAndIncrease(']');
+        } else {
+            const size_t size = op.capacity ? ReadInlineSize(op.capacity) : this->SerializeInVariable();
+            for(size_t index { 0 }; index < size && !Failed(); ++index) ReadValue(op.code, op.type, 0, AddItem(op.code, op.type, value), false);
+            if constexpr (key_type == SerializeKeyType::None) {
+                // Unused slots are read and dropped
+                if (op.capacity) {
+                    for(size_t index { size }; index < op.capacity && !Failed(); ++index) {
+                        auto unused = schema.DefaultValue(op.code, op.type);
+                        ReadValue(op.code, op.type, 0, unused, false);
+                    }
+                }
+            }
+        }
+    }
+
+    void ReadMap(const Op &op, DynamicValue &value) {
+        value.items.clear();
+        if constexpr (is_json) {
+            this->CheckAndIncrease('[');
+            this->SkipWhiteSpace();
+            if (Failed() || this->Peek(']')) return this->CheckAndIncrease(']');
+            while(true) {
+                this->CheckAndIncrease('{');
+                this->SerializeInMapEntryName("key");
+                ReadValue(op.keyCode, 0, 0, AddItem(op.keyCode, 0, value), true);
+                this->SkipWhiteSpace();
+                this->CheckAndIncrease(',');
+                this->SerializeInMapEntryName("value");
+                ReadValue(op.code, op.type, 0, AddItem(op.code, op.type, value), true);
+                this->SkipWhiteSpace();
+                this->CheckAndIncrease('}');
+                this->SkipWhiteSpace();
+                if (Failed()) return;
+                if (this->Peek(']')) break;
+                this->CheckAndIncrease(',');
+                this->SkipWhiteSpace();
+                if (Failed()) return;
+                if (this->Peek(']')) return Fail(ErrorKind::UnexpectedCharacter, "Unexpected ',', there must be next map entry after ','");
+            }
+            this->CheckAndIncrease(']');
+        } else {
+            const size_t size = this->SerializeInVariable();
+            for(size_t index { 0 }; index < size && !Failed(); ++index) {
+                ReadValue(op.keyCode, 0, 0, AddItem(op.keyCode, 0, value), false);
+                ReadValue(op.code, op.type, 0, AddItem(op.code, op.type, value), false);
+            }
+        }
+    }
+}; // class SchemaReader
+
+// Writes class of schema in output protocol, output is same as of generated class
+template <typename SerializeOutProtocol>
+class SchemaWriter : public SerializeOutProtocol {
+    static constexpr bool is_json { std::is_base_of_v<json_formatter<false>, SerializeOutProtocol> || std::is_base_of_v<json_formatter<true>, SerializeOutProtocol> };
+    static constexpr SerializeKeyType key_type { SerializeOutProtocol::serialize_key_type };
+    static constexpr bool sparse { SerializeOutProtocol::encode_mode == EncodeMode::Sparse };
+    const Schema &schema;
+    // JsonOut keeps its stream private, raw writes go to same stream
+    Stream &outStream;
+
+public:
+    SchemaWriter(const Schema &schema, Stream &stream) : SerializeOutProtocol { stream }, schema { schema }, outStream { stream } { }
+    SchemaWriter(const SchemaWriter &) = delete;
+    SchemaWriter &operator=(const SchemaWriter &) = delete;
+
+    void WriteObject(const uint32_t classIndex, const DynamicValue &object) {
+        auto &plan = schema.GetClass(classIndex);
+        if constexpr (key_type == SerializeKeyType::Bitmap) {
+            for(size_t byteIndex { 0 }; byteIndex < (plan.slots.size() + 7) / 8; ++byteIndex) {
+                uint8_t bits { 0 };
+                for(size_t slot { byteIndex * 8 }; slot < std::min(plan.slots.size(), byteIndex * 8 + 8); ++slot) {
+                    if (IsPresent(plan, plan.slots[slot], object)) bits |= static_cast<uint8_t>(1U << (slot % 8));
+                }
+                outStream.WriteRaw(bits);
+            }
+            for(auto opIndex: plan.slots) {
+                if (IsPresent(plan, opIndex, object)) WriteSlot(plan, opIndex, object);
+            }
+        } else {
+            this->StructSerializeOutStart();
+            for(uint32_t opIndex { 0 }; opIndex < plan.ops.size(); ++opIndex) {
+                auto &op = plan.ops[opIndex];
+                if (op.shape == OpShape::Packed && SerializeOutProtocol::pack_bits && opIndex != plan.packedOp) continue;
+                if constexpr (sparse) {
+                    if (op.shape != OpShape::Parent && op.shape != OpShape::Union && IsDefault(plan, opIndex, object)) continue;
+                }
+                WriteKey(plan, op, object.items[opIndex]);
+                WriteSlot(plan, opIndex, object);
+            }
+            this->StructSerializeOutEnd();
+        }
+    }
+
+private:
+    // Parent and union are always written, packed word and other member when not default
+    bool IsPresent(const ClassPlan &plan, const uint32_t opIndex, const DynamicValue &object) const {
+        auto &op = plan.ops[opIndex];
+        if (op.shape == OpShape::Parent || op.shape == OpShape::Union) return true;
+        return !IsDefault(plan, opIndex, object);
+    }
+
+    // Collections are default only when empty and object is never default, as IsDefault of generated class
+    bool IsDefault(const ClassPlan &plan, const uint32_t opIndex, const DynamicValue &object) const {
+        auto &op = plan.ops[opIndex];
+        if (op.shape == OpShape::Packed && SerializeOutProtocol::pack_bits) return plan.GetPackedWord(object) == plan.packedDefault;
+        if (op.shape == OpShape::List || op.shape == OpShape::Map) return object.items[opIndex].items.empty();
+        if (op.code == OpCode::Object) return false;
+        return object.items[opIndex] == plan.defaultObject.items[opIndex];
+    }
+
+    void WriteKey(const ClassPlan &plan, const Op &op, const DynamicValue &value) {
+        if constexpr (is_json || key_type == SerializeKeyType::String) {
+            if (op.shape == OpShape::Union && value.scalar >= op.alternativeCount) ROHIT_THROW(exception::BadType { outStream, "Bad union value" });
+            std::string_view name { plan.keys[op.key + (op.shape == OpShape::Union ? value.scalar : 0)].name };
+            if (op.shape == OpShape::Packed && SerializeOutProtocol::pack_bits) name = "#bits";
+            if constexpr (is_json) this->StructSerializeOutName(name);
+            else SerializeOutProtocol::SerializeOut(name);
+        } else if constexpr (key_type == SerializeKeyType::Integer) {
+            this->SerializeOutVariable(op.id);
+        }
+    }
+
+    // Value of member at its slot, union is preceded by index of its type in binary
+    void WriteSlot(const ClassPlan &plan, const uint32_t opIndex, const DynamicValue &object) {
+        auto &op = plan.ops[opIndex];
+        auto &value = object.items[opIndex];
+        switch(op.shape) {
+        case OpShape::Parent:
+            WriteObject(op.type, value);
+            break;
+        case OpShape::List:
+            WriteList(op, value);
+            break;
+        case OpShape::Map:
+            WriteMap(op, value);
+            break;
+        case OpShape::Union: {
+            if (value.scalar >= op.alternativeCount || value.items.size() != 1) ROHIT_THROW(exception::BadType { outStream, "Bad union value" });
+            if constexpr (!is_json && key_type != SerializeKeyType::String) this->SerializeOutVariable(value.scalar);
+            auto &type = plan.alternatives[op.type + value.scalar];
+            WriteValue(type.code, type.type, 0, value.items[0], is_json);
+            break;
+        }
+        case OpShape::Packed:
+            if constexpr (SerializeOutProtocol::pack_bits) {
+                VisitUnsigned(plan.packedSize, [this, &plan, &object](auto type) {
+                    SerializeOutProtocol::SerializeOut(static_cast<typename decltype(type)::type>(plan.GetPackedWord(object)));
+                });
+                break;
+            }
+            [[fallthrough]];
+        default:
+            WriteValue(op.code, op.type, op.capacity, value, key_type == SerializeKeyType::String);
+            break;
+        }
+    }
+
+    void WriteValue(const OpCode code, const uint32_t type, const uint16_t capacity, const DynamicValue &value, const bool enumByName) {
+        if (code == OpCode::Object) WriteObject(type, value);
+        else if (code == OpCode::String) {
+            if (capacity && !is_json) WriteInlineString(capacity, value.text);
+            else SerializeOutProtocol::SerializeOut(std::string_view { value.text });
+        } else if (code == OpCode::Enum) {
+            if (is_json || enumByName) {
+                auto &names = schema.GetEnum(type).names;
+                if (value.scalar >= names.size()) ROHIT_THROW(exception::BadType { outStream, "Bad enum value" });
+                SerializeOutProtocol::SerializeOut(std::string_view { names[value.scalar] });
+            } else if constexpr (!is_json) this->SerializeOutVariable(value.scalar);
+        } else {
+            VisitPrimitive(code, [this, &value](auto valueType) {
+                SerializeOutProtocol::SerializeOut(value.Get<typename decltype(valueType)::type>());
+            });
+        }
+    }
+
+    // binary_none writes inline size as fixed width integer followed by all the slots
+    void WriteInlineSize(const uint16_t capacity, const size_t size) {
+        if constexpr (key_type == SerializeKeyType::None) {
+            VisitUnsigned(capacity <= UINT8_MAX ? 1 : 2, [this, size](auto type) {
+                SerializeOutProtocol::SerializeOut(static_cast<typename decltype(type)::type>(size));
+            });
+        } else if constexpr (!is_json) this->SerializeOutVariable(size);
+    }
+
+    void WriteInlineString(const uint16_t capacity, const std::string &text) {
+        if (text.size() > capacity) ROHIT_THROW(exception::BadType { outStream, "String exceeds inline capacity" });
+        WriteInlineSize(capacity, text.size());
+        outStream.Append(std::string_view { text });
+        if constexpr (key_type == SerializeKeyType::None) {
+            for(size_t index { text.size() }; index < capacity; ++index) outStream.WriteRaw(static_cast<uint8_t>(0));
+        }
+    }
+
+    void WriteList(const Op &op, const DynamicValue &value) {
+        if constexpr (is_json) {
+            this->ListSerializeOutStart();
+            for(size_t index { 0 }; index < value.items.size(); ++index) {
+                if (index) this->ListSerializeOutNext();
+                WriteValue(op.code, op.type, 0, value.items[index], true);
+            }
+            this->ListSerializeOutEnd();
+        } else {
+            if (op.capacity) {
+                if (value.items.size() > op.capacity) ROHIT_THROW(exception::BadType { outStream, "Array exceeds inline capacity" });
+                WriteInlineSize(op.capacity, value.items.size());
+            } else this->SerializeOutVariable(value.items.size());
+            for(auto &item: value.items) WriteValue(op.code, op.type, 0, item, false);
+            if constexpr (key_type == SerializeKeyType::None) {
+                // Unused slots are written with default value
+                if (op.capacity) {
+                    const auto unused = schema.DefaultValue(op.code, op.type);
+                    for(size_t index { value.items.size() }; index < op.capacity; ++index) WriteValue(op.code, op.type, 0, unused, false);
+                }
+            }
+        }
+    }
+
+    void WriteMap(const Op &op, const DynamicValue &value) {
+        if (value.items.size() % 2) ROHIT_THROW(exception::BadType { outStream, "Map must have key and value" });
+        if constexpr (is_json) {
+            this->ListSerializeOutStart();
+            for(size_t index { 0 }; index < value.items.size(); index += 2) {
+                if (index) this->ListSerializeOutNext();
+                this->StructSerializeOutStart();
+                this->StructSerializeOutName("key");
+                WriteValue(op.keyCode, 0, 0, value.items[index], true);
+                this->StructSerializeOutName("value");
+                WriteValue(op.code, op.type, 0, value.items[index + 1], true);
+                this->StructSerializeOutEnd();
+            }
+            this->ListSerializeOutEnd();
+        } else {
+            this->SerializeOutVariable(value.items.size() / 2);
+            for(size_t index { 0 }; index < value.items.size(); index += 2) {
+                WriteValue(op.keyCode, 0, 0, value.items[index], false);
+                WriteValue(op.code, op.type, 0, value.items[index + 1], false);
+            }
+        }
+    }
+}; // class SchemaWriter
+
+} // namespace rohit::serializer::Runtime
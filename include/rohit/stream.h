@@ -16,6 +16,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include <rohit/config.h>
 #include <charconv>
 #include <concepts>
 #include <type_traits>
@@ -26,11 +27,22 @@
 #include <stdexcept>
 #include <filesystem>
 #include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace rohit {
 
 template <typename T>
 constexpr T byteswap(const T &val) {
+    if constexpr (std::floating_point<T>) {
+        // Floating point is swapped as integer of same size
+        using integer_type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        return std::bit_cast<T>(byteswap(std::bit_cast<integer_type>(val)));
+    } else {
 #if __cpp_lib_byteswap
         return std::byteswap(val);
 #else
@@ -63,6 +75,7 @@ constexpr T byteswap(const T &val) {
             } else return (val >> 56) | (val << 56) | retval;
         } else static_assert(false, "Unsupported type");
 #endif
+    }
 }
 
 template <std::endian source, std::endian destination, typename T>
@@ -134,8 +147,8 @@ protected:
     mutable uint8_t *_curr;
     uint8_t * _end;
 
-    void CheckOverflow() const { if (_curr >= _end) throw exception::StreamOverflowException { }; }
-    void CheckOverflow(size_t len) const { if (_curr + len > _end) throw exception::StreamOverflowException { }; }
+    void CheckOverflow() const { if (_curr >= _end) ROHIT_THROW(exception::StreamOverflowException { }); }
+    void CheckOverflow(size_t len) const { if (_curr + len > _end) ROHIT_THROW(exception::StreamOverflowException { }); }
 
     Stream() : _curr { nullptr }, _end { nullptr } { }
 public:
@@ -224,8 +237,8 @@ public:
     inline void Append(const Stream &source) { Reserve(source.RemainingBuffer()); _curr = std::copy(source.curr(), source.end(), _curr); }
     inline void Append(const auto *begin, const auto *end) { Reserve(begin, end); _curr = std::copy(reinterpret_cast<const uint8_t *>(begin), reinterpret_cast<const uint8_t *>(end), _curr); }
     inline void Append(const auto *begin, size_t size) { Reserve(size); _curr = std::copy(reinterpret_cast<const uint8_t *>(begin), reinterpret_cast<const uint8_t *>(begin) + size, _curr); }
-    inline void Append(const char value) { Reserve(value); *_curr++ = value; }
-    inline void Append(const uint8_t value) { Reserve(value); *_curr++ = value; }
+    inline void Append(const char value) { Reserve(1); *_curr++ = value; }
+    inline void Append(const uint8_t value) { Reserve(1); *_curr++ = value; }
     template <size_t size>
     inline void Append(const char (&value)[size]) { 
         if constexpr (size >= 1) {
@@ -262,6 +275,9 @@ public:
             Append(value);
         } else if constexpr (std::is_same_v<ValueType, std::string_view>) {
             Append(value);
+        } else if constexpr (std::is_convertible_v<const ValueType &, std::string_view>) {
+            // Strings with other allocator, e.g. std::pmr::string
+            Append(std::string_view { value });
         }else static_assert(false, "Unsupported type");
     }
 
@@ -276,7 +292,7 @@ protected:
     friend class FixedBuffer;
     uint8_t * _begin;
 
-    void CheckUnderflow() const { if (_curr == _begin) throw exception::StreamUnderflowException { }; }
+    void CheckUnderflow() const { if (_curr == _begin) ROHIT_THROW(exception::StreamUnderflowException { }); }
 
     FullStream() : Stream { }, _begin { nullptr } { }
 public:
@@ -363,7 +379,7 @@ class FullStreamAutoAlloc : public FullStream {
             auto new_capacity = Capacity() * 2;
             while(curr_index + len > new_capacity) new_capacity += Capacity();
             _begin = reinterpret_cast<uint8_t *>(realloc(reinterpret_cast<void *>(_begin), new_capacity));
-            if (_begin == nullptr) throw exception::MemoryAllocationException { };
+            if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
             _end = _begin + new_capacity;
             _curr = _begin + curr_index;
         }
@@ -371,7 +387,7 @@ class FullStreamAutoAlloc : public FullStream {
 
 public:
     using FullStream::FullStream;
-    FullStreamAutoAlloc(const size_t size) : FullStream { reinterpret_cast<uint8_t *>(malloc(size)), size } { if (_begin == nullptr) throw exception::MemoryAllocationException { }; }
+    FullStreamAutoAlloc(const size_t size) : FullStream { reinterpret_cast<uint8_t *>(malloc(size)), size } { if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { }); }
     FullStreamAutoAlloc() : FullStream { } { }
     ~FullStreamAutoAlloc() { free(_begin); }
 
@@ -402,7 +418,7 @@ public:
     auto ReturnOldAndAlloc(const size_t size) { 
         FullStream stream { _begin, _end, _curr };
         _begin = reinterpret_cast<uint8_t *>(malloc(size));
-        if (_begin == nullptr) throw exception::MemoryAllocationException { }; 
+        if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { }); 
         _curr = _begin;
         _end = _begin + size;
         return stream;
@@ -421,9 +437,9 @@ class FullStreamAutoAllocLimits : public FullStream {
         if (_curr == _end) {
             auto curr_index = CurrentOffset();
             auto new_capacity = Capacity() * 2;
-            if (new_capacity > limits->MaxReadBuffer) throw exception::StreamOverflowException { };
+            if (new_capacity > limits->MaxReadBuffer) ROHIT_THROW(exception::StreamOverflowException { });
             _begin = reinterpret_cast<uint8_t *>(realloc(reinterpret_cast<void *>(_begin), new_capacity));
-            if (_begin == nullptr) throw exception::MemoryAllocationException { };
+            if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
             _end = _begin + new_capacity;
             _curr = _begin + curr_index;
         }
@@ -434,9 +450,9 @@ class FullStreamAutoAllocLimits : public FullStream {
             auto curr_index = CurrentOffset();
             auto new_capacity = Capacity() * 2;
             while(curr_index + len > new_capacity) new_capacity += Capacity();
-            if (new_capacity > limits->MaxReadBuffer) throw exception::StreamOverflowException { };
+            if (new_capacity > limits->MaxReadBuffer) ROHIT_THROW(exception::StreamOverflowException { });
             _begin = reinterpret_cast<uint8_t *>(realloc(reinterpret_cast<void *>(_begin), new_capacity));
-            if (_begin == nullptr) throw exception::MemoryAllocationException { };
+            if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
             _end = _begin + new_capacity;
             _curr = _begin + curr_index;
         }
@@ -447,7 +463,7 @@ class FullStreamAutoAllocLimits : public FullStream {
         if (current_buffer_size < limits->MinReadBuffer) {
             auto curr_index = CurrentOffset();
             _begin = reinterpret_cast<uint8_t *>(realloc(reinterpret_cast<void *>(_begin), limits->MinReadBuffer));
-            if (_begin == nullptr) throw exception::MemoryAllocationException { };
+            if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { });
             _end = _begin + limits->MinReadBuffer;
             _curr = _begin + curr_index;
         }
@@ -455,7 +471,7 @@ class FullStreamAutoAllocLimits : public FullStream {
 
 public:
     using FullStream::FullStream;
-    FullStreamAutoAllocLimits(const streamlimit_t *limits) : FullStream { reinterpret_cast<uint8_t *>(malloc(limits->MinReadBuffer)), limits->MinReadBuffer }, limits { limits } { if (_begin == nullptr) throw exception::MemoryAllocationException { }; }
+    FullStreamAutoAllocLimits(const streamlimit_t *limits) : FullStream { reinterpret_cast<uint8_t *>(malloc(limits->MinReadBuffer)), limits->MinReadBuffer }, limits { limits } { if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { }); }
     FullStreamAutoAllocLimits() : FullStream { } { }
     ~FullStreamAutoAllocLimits() { free(_begin); }
     FullStreamAutoAllocLimits(const FullStreamAutoAllocLimits &) = delete;
@@ -487,7 +503,7 @@ public:
     auto ReturnOldAndAlloc() { 
         FullStream stream { _begin, _end, _curr };
         _begin = reinterpret_cast<uint8_t *>(malloc(limits->MinReadBuffer));
-        if (_begin == nullptr) throw exception::MemoryAllocationException { }; 
+        if (_begin == nullptr) ROHIT_THROW(exception::MemoryAllocationException { }); 
         _curr = _begin;
         _end = _begin + limits->MinReadBuffer;
         return stream;
@@ -548,11 +564,11 @@ inline const FullStream MakeConstantFullStream(const std::string &string) { retu
 template <typename ChT> inline const FullStream MakeConstantFullStream(const ChT *begin, const ChT *end, const ChT *curr) { return FullStream { const_cast<ChT *>(begin), const_cast<ChT *>(end), const_cast<ChT *>(curr) }; }
 inline const StreamAutoFree MakeStreamFromFile(const std::filesystem::path &path) {
     if (!std::filesystem::is_regular_file(path)) {
-        throw std::invalid_argument { "Not a valid file" };
+        ROHIT_THROW(std::invalid_argument { "Not a valid file" });
     }
 
     std::ifstream filestream { path, std::ios::binary | std::ios::ate };
-    if (!filestream.is_open()) throw std::runtime_error { "Unable to open file" };
+    if (!filestream.is_open()) ROHIT_THROW(std::runtime_error { "Unable to open file" });
 
     filestream.seekg(0, std::ios::end);
     size_t size = filestream.tellg();
@@ -566,12 +582,53 @@ inline const StreamAutoFree MakeStreamFromFile(const std::filesystem::path &path
     return StreamAutoFree { buffer, size };
 }
 
+#if defined(__unix__) || defined(__APPLE__)
+// Read only file mapped in memory, pages are read on first access and file is unmapped with stream
+class StreamMapped : public FullStream {
+    const size_t mappedSize;
+
+public:
+    StreamMapped(void *begin, const size_t size) : FullStream { reinterpret_cast<uint8_t *>(begin), size }, mappedSize { size } { }
+    StreamMapped(const StreamMapped &) = delete;
+    StreamMapped &operator=(const StreamMapped &) = delete;
+    ~StreamMapped() { if (mappedSize) munmap(_begin, mappedSize); }
+};
+
+inline const StreamMapped MakeMappedStreamFromFile(const std::filesystem::path &path) {
+    if (!std::filesystem::is_regular_file(path)) {
+        ROHIT_THROW(std::invalid_argument { "Not a valid file" });
+    }
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) ROHIT_THROW(std::runtime_error { "Unable to open file" });
+    struct stat fileStatus { };
+    if (fstat(fd, &fileStatus) != 0) {
+        close(fd);
+        ROHIT_THROW(std::runtime_error { "Unable to read file size" });
+    }
+
+    // Empty file cannot be mapped
+    const size_t size = static_cast<size_t>(fileStatus.st_size);
+    void *buffer = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    close(fd);
+    if (buffer == MAP_FAILED) ROHIT_THROW(std::runtime_error { "Unable to map file" });
+    return StreamMapped { buffer, size };
+}
+#else
+// Platform without mmap reads whole file
+using StreamMapped = StreamAutoFree;
+
+inline const StreamMapped MakeMappedStreamFromFile(const std::filesystem::path &path) { return MakeStreamFromFile(path); }
+#endif
+
 namespace exception {
 class BaseParser : public std::exception {
 protected:
     const std::string whats_err;
 
-    static const auto CreateWhatString(const Stream &stream, const std::string &errorstr) {
+public:
+    // Error text with input around current location of stream
+    static const std::string CreateWhatString(const Stream &stream, const std::string &errorstr) {
         std::string whats_err { "Error: " };
 
         const FullStream *fullstream = dynamic_cast<const FullStream *>(&stream);
@@ -617,7 +674,6 @@ protected:
         return whats_err;
     }
 
-public:
     BaseParser(const Stream &stream, const std::string &errorstr) : whats_err { CreateWhatString(stream, errorstr) } { }
     BaseParser(const Stream &stream) : whats_err { CreateWhatString(stream, {}) } { }
 
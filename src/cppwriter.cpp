@@ -16,6 +16,13 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <rohit/serializercreator.h>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <unordered_map>
+#include <algorithm>
+#include <map>
+#include <memory_resource>
 
 namespace rohit::serializer::Writer::CPP {
 
@@ -39,7 +46,7 @@ const std::string GetCPPTypeSupportUnion(const Member &member) {
     for(auto &typeName: member.typeNameList) {
         retUnion += "\n\t\t\tcase rohit::Hash(\"" + typeName.EnumName + "\"): return e_" + member.Name + "::" + typeName.EnumName + ";";
     }
-    retUnion += "\n\t\t\tdefault: throw std::runtime_error(\"Bad Enum Name\");"
+    retUnion += "\n\t\t\tdefault: ROHIT_THROW(std::runtime_error(\"Bad Enum Name\"));"
                 "\n\t\t}"
                 "\n\t}";
     return retUnion;
@@ -53,27 +60,354 @@ const std::string GetCPPTypeSupport(const Member &member) {
     case Member::array:
         return { };
     case Member::map:
+    case Member::hashmap:
+    case Member::flatmap:
         return { };
     case Member::Union:
         return GetCPPTypeSupportUnion(member);
     }
 }
 
-const std::string GetCPPType(const Member &member) {
+const std::string GetCPPType(const std::string &type, const Allocator allocator) {
+    if (allocator == Allocator::Pmr && type == "string") return "std::pmr::string";
+    return serializer::GetCPPType(type);
+}
+
+const std::string GetCPPType(const Member &member, const Allocator allocator = Allocator::Standard) {
+    const std::string prefix { allocator == Allocator::Pmr ? "std::pmr::" : "std::" };
+    const auto valueType = GetCPPType(member.typeNameList[0].Name, allocator);
     switch(member.modifer) {
     default:
     case Member::none:
         // TODO: Range check
-        return serializer::GetCPPType(member.typeNameList[0].Name);
+        if (member.capacity) return "rohit::inline_string<" + std::to_string(member.capacity) + ">";
+        return valueType;
     case Member::array:
-        return std::string("std::vector<") + serializer::GetCPPType(member.typeNameList[0].Name) + ">";
+        if (member.capacity) return std::string("rohit::inline_vector<") + serializer::GetCPPType(member.typeNameList[0].Name) + ", " + std::to_string(member.capacity) + ">";
+        return prefix + "vector<" + valueType + ">";
     case Member::map:
-        return std::string("std::map<") + serializer::GetCPPType(member.Key) + "," + serializer::GetCPPType(member.typeNameList[0].Name) + ">";
+        return prefix + "map<" + GetCPPType(member.Key, allocator) + "," + valueType + ">";
+    case Member::hashmap:
+        return prefix + "unordered_map<" + GetCPPType(member.Key, allocator) + "," + valueType + ">";
+    case Member::flatmap:
+        if (allocator == Allocator::Pmr) {
+            const auto keyType = GetCPPType(member.Key, allocator);
+            return "rohit::flat_map<" + keyType + "," + valueType + ",std::less<" + keyType + ">,std::pmr::vector<std::pair<" + keyType + "," + valueType + ">>>";
+        }
+        return std::string("rohit::flat_map<") + serializer::GetCPPType(member.Key) + "," + valueType + ">";
     case Member::Union:
         return "e_" + member.Name + " " + member.Name + "_type { };\n\t" + "u_" + member.Name;
     }
 }
 
+const Enum *FindEnum(const std::vector<std::unique_ptr<Base>> &statementlist, const std::string &fullName) {
+    for(auto &statement: statementlist) {
+        if (statement->type == ObjectType::Enum && statement->GetFullName() == fullName) {
+            return dynamic_cast<const Enum *>(statement.get());
+        }
+        if (statement->type == ObjectType::Namespace) {
+            auto enumptr = FindEnum(dynamic_cast<const Namespace *>(statement.get())->statementlist, fullName);
+            if (enumptr) return enumptr;
+        }
+    }
+    return nullptr;
+}
+
+const Enum *FindEnum(const TypeName &typeName) {
+    if (typeName.type != ObjectType::Enum || !typeName.definedNameSpace) return nullptr;
+    return FindEnum(typeName.definedNameSpace->statementlist, typeName.GetFullName());
+}
+
+uint32_t GetEnumBitCount(const Enum *enumptr) {
+    if (enumptr->enumNameList.size() <= 2) return 1;
+    return static_cast<uint32_t>(std::bit_width(enumptr->enumNameList.size() - 1));
+}
+
+uint32_t GetMaxBitCount(const Member &member) {
+    static const std::unordered_map<std::string, uint32_t> maxBitCountMap {
+        {"bool", 1},
+        {"uint8", 8},
+        {"uint16", 16},
+        {"uint32", 32},
+        {"uint64", 64}
+    };
+    auto itr = maxBitCountMap.find(member.typeNameList[0].Name);
+    if (itr != std::end(maxBitCountMap)) return itr->second;
+    return 0;
+}
+
+// Returns number of bits used by member in packed word, zero if member is not packed
+uint32_t GetPackedBitCount(const Class *obj, const Member &member) {
+    if (member.modifer != Member::none) return 0;
+    auto &typeName = member.typeNameList[0];
+    if (member.bitCount) {
+        if (typeName.type == ObjectType::Enum) {
+            auto enumptr = FindEnum(typeName);
+            if (enumptr && member.bitCount < GetEnumBitCount(enumptr)) {
+                throw std::invalid_argument { "bits(" + std::to_string(member.bitCount) + ") is too small for member " + obj->Name + "::" + member.Name };
+            }
+        } else if (member.bitCount > GetMaxBitCount(member)) {
+            throw std::invalid_argument { "bits is only allowed for bool, enum and unsigned integer within its size, member " + obj->Name + "::" + member.Name };
+        }
+        return member.bitCount;
+    }
+    if ((obj->attributes & ClassAtributes::BitPacked) != ClassAtributes::BitPacked) return 0;
+    if (typeName.type == ObjectType::Primitive && typeName.Name == "bool") return 1;
+    if (typeName.type == ObjectType::Enum) {
+        auto enumptr = FindEnum(typeName);
+        // Only small enum are packed
+        if (enumptr && enumptr->enumNameList.size() <= 256) return GetEnumBitCount(enumptr);
+    }
+    return 0;
+}
+
+uint32_t GetPackedBitTotal(const Class *obj) {
+    uint32_t total { 0 };
+    for(auto &member: obj->MemberList) {
+        total += GetPackedBitCount(obj, member);
+    }
+    if (total > 64) throw std::invalid_argument { "Packed members of class " + obj->Name + " require more than 64 bits" };
+    return total;
+}
+
+const Member *GetFirstPackedMember(const Class *obj) {
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member)) return &member;
+    }
+    return nullptr;
+}
+
+const std::string GetPackedBitsType(const uint32_t totalBits) {
+    if (totalBits <= 8) return "uint8_t";
+    if (totalBits <= 16) return "uint16_t";
+    if (totalBits <= 32) return "uint32_t";
+    return "uint64_t";
+}
+
+bool IsBitField(const Class *obj, const Member &member) {
+    return (obj->attributes & ClassAtributes::BitField) == ClassAtributes::BitField && GetPackedBitCount(obj, member);
+}
+
+// Dynamic list can be streamed element by element, see rohit::serializer::StreamSelector
+// and rohit::serializer::RangeListSource, or encoded in parallel, see rohit::serializer::ParallelListSource
+// List of enum is left out, generated code does not support array of enum
+bool IsStreamableList(const Member &member) {
+    return member.modifer == Member::array && !member.capacity && member.typeNameList[0].type != ObjectType::Enum;
+}
+
+// Reference to a bit-field cannot be created, bit-field value must be copied
+const std::string GetMemberValue(const Class *obj, const Member &member) {
+    if (IsBitField(obj, member)) return "static_cast<" + GetCPPType(member) + ">(" + member.Name + ")";
+    return member.Name;
+}
+
+// Value written by SerializeOut, streamable list may be replaced by range of source
+const std::string GetMemberOutValue(const Class *obj, const Member &member) {
+    if (IsStreamableList(member)) return "rohit::serializer::ListOut<f_" + member.Name + ">(source, " + member.Name + ")";
+    return GetMemberValue(obj, member);
+}
+
+// Bitmap slot for each parent and member, all packed members share a slot
+uint32_t GetSlotCount(const Class *obj) {
+    const auto firstPackedMember = GetFirstPackedMember(obj);
+    uint32_t slotCount = static_cast<uint32_t>(obj->parentlist.size());
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member) && &member != firstPackedMember) continue;
+        ++slotCount;
+    }
+    return slotCount;
+}
+
+struct TypeLayout {
+    size_t size { };
+    size_t align { 1 };
+};
+
+constexpr size_t AlignUp(const size_t value, const size_t align) { return (value + align - 1) / align * align; }
+
+// Estimates C++ layout of generated class as compiled on generator host
+class LayoutEstimator {
+    const Allocator allocator;
+    std::unordered_map<std::string, const Class *> classMap { };
+    std::unordered_map<const Class *, TypeLayout> layoutCache[2] { };
+
+    void AddClass(const std::vector<std::unique_ptr<Base>> &statementlist) {
+        for(auto &statement: statementlist) {
+            if (statement->type == ObjectType::Class) {
+                classMap.insert({statement->GetFullName(), dynamic_cast<const Class *>(statement.get())});
+            } else if (statement->type == ObjectType::Namespace) {
+                AddClass(dynamic_cast<const Namespace *>(statement.get())->statementlist);
+            }
+        }
+    }
+
+public:
+    // Parent is not resolved by parser, it is searched from innermost namespace
+    const Class *FindParent(const Class *obj, const std::string &name) const {
+        for(auto nameSpace = obj->parentNamespace; nameSpace; nameSpace = nameSpace->parentNamespace) {
+            auto itr = classMap.find(nameSpace->GetFullName() + "::" + name);
+            if (itr != std::end(classMap)) return itr->second;
+        }
+        auto itr = classMap.find(name);
+        if (itr != std::end(classMap)) return itr->second;
+        return nullptr;
+    }
+
+private:
+    // Inline container is slot array followed by size, size is uint8 upto capacity 255 else uint16
+    static TypeLayout GetInlineLayout(const TypeLayout &slotLayout, const size_t slotCount, const size_t capacity) {
+        const size_t sizeWidth = capacity <= UINT8_MAX ? 1 : 2;
+        const size_t align = std::max(slotLayout.align, sizeWidth);
+        return { AlignUp(AlignUp(slotLayout.size * slotCount, sizeWidth) + sizeWidth, align), align };
+    }
+
+    TypeLayout GetTypeLayout(const TypeName &typeName, const bool optimized) {
+        static const std::unordered_map<std::string, TypeLayout> primitiveLayoutMap {
+            {"char", {sizeof(char), alignof(char)}},
+            {"int8", {sizeof(int8_t), alignof(int8_t)}},
+            {"int16", {sizeof(int16_t), alignof(int16_t)}},
+            {"int32", {sizeof(int32_t), alignof(int32_t)}},
+            {"int64", {sizeof(int64_t), alignof(int64_t)}},
+            {"uint8", {sizeof(uint8_t), alignof(uint8_t)}},
+            {"uint16", {sizeof(uint16_t), alignof(uint16_t)}},
+            {"uint32", {sizeof(uint32_t), alignof(uint32_t)}},
+            {"uint64", {sizeof(uint64_t), alignof(uint64_t)}},
+            {"float", {sizeof(float), alignof(float)}},
+            {"double", {sizeof(double), alignof(double)}},
+            {"bool", {sizeof(bool), alignof(bool)}},
+            {"string", {sizeof(std::string), alignof(std::string)}}
+        };
+        if (typeName.type == ObjectType::Enum) return { sizeof(int), alignof(int) };
+        if (allocator == Allocator::Pmr && typeName.Name == "string") return { sizeof(std::pmr::string), alignof(std::pmr::string) };
+        if (typeName.type == ObjectType::Class) {
+            auto itr = classMap.find(typeName.GetFullName());
+            if (itr != std::end(classMap)) return GetClassLayout(itr->second, optimized);
+        }
+        auto itr = primitiveLayoutMap.find(typeName.Name);
+        if (itr != std::end(primitiveLayoutMap)) return itr->second;
+        return { };
+    }
+
+public:
+    LayoutEstimator(const std::vector<std::unique_ptr<Base>> &statementlist, const Allocator allocator)
+        : allocator { allocator } { AddClass(statementlist); }
+
+    // Member may need more than one field, union has type and value
+    std::vector<TypeLayout> GetMemberLayout(const Member &member, const bool optimized) {
+        switch(member.modifer) {
+        default:
+        case Member::none:
+            if (member.capacity) return { GetInlineLayout({ sizeof(char), alignof(char) }, member.capacity + 1, member.capacity) };
+            return { GetTypeLayout(member.typeNameList[0], optimized) };
+        case Member::array:
+            if (member.capacity) return { GetInlineLayout(GetTypeLayout(member.typeNameList[0], optimized), member.capacity, member.capacity) };
+            if (allocator == Allocator::Pmr) return { { sizeof(std::pmr::vector<char>), alignof(std::pmr::vector<char>) } };
+            return { { sizeof(std::vector<char>), alignof(std::vector<char>) } };
+        case Member::map:
+            if (allocator == Allocator::Pmr) return { { sizeof(std::pmr::map<char, char>), alignof(std::pmr::map<char, char>) } };
+            return { { sizeof(std::map<char, char>), alignof(std::map<char, char>) } };
+        case Member::hashmap:
+            if (allocator == Allocator::Pmr) return { { sizeof(std::pmr::unordered_map<char, char>), alignof(std::pmr::unordered_map<char, char>) } };
+            return { { sizeof(std::unordered_map<char, char>), alignof(std::unordered_map<char, char>) } };
+        case Member::flatmap:
+            if (allocator == Allocator::Pmr) return { { sizeof(std::pmr::vector<char>), alignof(std::pmr::vector<char>) } };
+            return { { sizeof(std::vector<char>), alignof(std::vector<char>) } };
+        case Member::Union: {
+            TypeLayout unionLayout { };
+            for(auto &typeName: member.typeNameList) {
+                const auto layout = GetTypeLayout(typeName, optimized);
+                unionLayout.size = std::max(unionLayout.size, layout.size);
+                unionLayout.align = std::max(unionLayout.align, layout.align);
+            }
+            unionLayout.size = AlignUp(unionLayout.size, unionLayout.align);
+            return { { sizeof(int), alignof(int) }, unionLayout };
+        }
+        }
+    }
+
+    size_t GetMemberAlign(const Member &member, const bool optimized) {
+        size_t align { 1 };
+        for(auto &layout: GetMemberLayout(member, optimized)) align = std::max(align, layout.align);
+        return align;
+    }
+
+    std::vector<const Member *> GetMemberOrder(const Class *obj, const bool optimized) {
+        std::vector<const Member *> memberOrder { };
+        for(auto &member: obj->MemberList) memberOrder.push_back(&member);
+        if (!optimized || (obj->attributes & ClassAtributes::Packed) == ClassAtributes::Packed) return memberOrder;
+        // Bit-field are kept together at end so that they share storage unit
+        std::stable_sort(std::begin(memberOrder), std::end(memberOrder), [this, obj](const Member *lhs, const Member *rhs) {
+            const bool lhsBitField = IsBitField(obj, *lhs);
+            const bool rhsBitField = IsBitField(obj, *rhs);
+            if (lhsBitField != rhsBitField) return rhsBitField;
+            if (lhsBitField) return false;
+            return GetMemberAlign(*lhs, true) > GetMemberAlign(*rhs, true);
+        });
+        return memberOrder;
+    }
+
+    // Padding is number of bytes not used by any member
+    std::pair<TypeLayout, size_t> ComputeClassLayout(const Class *obj, const bool optimized) {
+        const bool packed = (obj->attributes & ClassAtributes::Packed) == ClassAtributes::Packed;
+        TypeLayout classLayout { };
+        size_t bitOffset { 0 };
+        size_t usedBits { 0 };
+        auto placeField = [&classLayout, &bitOffset, &usedBits, packed](const TypeLayout &layout) {
+            const size_t align = packed ? 1 : layout.align;
+            bitOffset = AlignUp(AlignUp(bitOffset, 8) / 8, align) * 8 + layout.size * 8;
+            usedBits += layout.size * 8;
+            classLayout.align = std::max(classLayout.align, align);
+        };
+        for(auto &parent: obj->parentlist) {
+            auto parentClass = FindParent(obj, parent.Name);
+            if (parentClass) placeField(GetClassLayout(parentClass, optimized));
+        }
+        for(auto member: GetMemberOrder(obj, optimized)) {
+            if (IsBitField(obj, *member)) {
+                // Bit-field does not cross storage unit of its declared type
+                const auto layout = GetTypeLayout(member->typeNameList[0], optimized);
+                const auto width = GetPackedBitCount(obj, *member);
+                const auto unitBits = std::max<size_t>(layout.size * 8, 8);
+                if (!packed && bitOffset / unitBits != (bitOffset + width - 1) / unitBits) bitOffset = AlignUp(bitOffset, unitBits);
+                bitOffset += width;
+                usedBits += width;
+                classLayout.align = std::max(classLayout.align, packed ? 1 : layout.align);
+                continue;
+            }
+            for(auto &layout: GetMemberLayout(*member, optimized)) placeField(layout);
+        }
+        classLayout.size = std::max<size_t>(AlignUp(AlignUp(bitOffset, 8) / 8, classLayout.align), 1);
+        return { classLayout, classLayout.size - AlignUp(usedBits, 8) / 8 };
+    }
+
+    TypeLayout GetClassLayout(const Class *obj, const bool optimized) {
+        auto &cache = layoutCache[optimized ? 1 : 0];
+        auto itr = cache.find(obj);
+        if (itr != std::end(cache)) return itr->second;
+        const auto layout = ComputeClassLayout(obj, optimized).first;
+        cache.insert({obj, layout});
+        return layout;
+    }
+
+    void GetLayoutReport(const std::vector<std::unique_ptr<Base>> &statementlist, std::vector<ClassLayoutReport> &reportList) {
+        for(auto &statement: statementlist) {
+            if (statement->type == ObjectType::Class) {
+                auto obj = dynamic_cast<const Class *>(statement.get());
+                const auto [declaredLayout, declaredPadding] = ComputeClassLayout(obj, false);
+                const auto [optimizedLayout, optimizedPadding] = ComputeClassLayout(obj, true);
+                reportList.push_back({ obj->GetFullName(), declaredLayout.size, declaredPadding, optimizedLayout.size, optimizedPadding });
+            } else if (statement->type == ObjectType::Namespace) {
+                GetLayoutReport(dynamic_cast<const Namespace *>(statement.get())->statementlist, reportList);
+            }
+        }
+    }
+}; // class LayoutEstimator
+
+struct WriterContext {
+    const Options &options;
+    LayoutEstimator layoutEstimator;
+};
+
 void WriteAccessType(Stream &outStream, const AccessType access) {
     switch(access) {
         default:
@@ -101,10 +435,12 @@ void WriteParentList(Stream &outStream, const std::vector<Parent> &parents) {
     }
 }
 
-void WriteMemberList(Stream &outStream, const std::vector<Member> &members) {
+void WriteMemberList(Stream &outStream, WriterContext &context, const Class *obj) {
     AccessType lastaccess { AccessType::Private };
 
-    for(auto &member: members) {
+    const bool optimized = context.options.layout == MemberLayout::Optimized;
+    for(auto memberptr: context.layoutEstimator.GetMemberOrder(obj, optimized)) {
+        auto &member = *memberptr;
         if (member.access != lastaccess) {
             outStream.Write('\n');
             WriteAccessType(outStream, member.access);
@@ -113,20 +449,57 @@ void WriteMemberList(Stream &outStream, const std::vector<Member> &members) {
         }
         auto support = GetCPPTypeSupport(member);
         if (!support.empty()) outStream.Write(support, '\n');
-        outStream.Write('\t', GetCPPType(member), ' ', member.Name, " { ");
+        outStream.Write('\t', GetCPPType(member, context.options.allocator), ' ', member.Name);
+        if (IsBitField(obj, member)) outStream.Write(" : ", GetPackedBitCount(obj, member));
+        outStream.Write(" { ");
         if (!member.defaultValue.empty()) outStream.Write(member.defaultValue, ' ');
         outStream.Write("};\n");
         
     }
 }
 
-void WriteSerializerOutBodyForParent(Stream &outStream, const Class *obj, const rohit::serializer::SerializeKeyType serialize_key_type, bool &first) {
+const std::string GetBitMask(const uint32_t bitCount) {
+    if (bitCount >= 64) return "0xffffffffffffffffULL";
+    char buffer[24] { };
+    auto result = std::to_chars(std::begin(buffer), std::end(buffer), (1ULL << bitCount) - 1, 16);
+    return "0x" + std::string { buffer, result.ptr } + "ULL";
+}
+
+void WritePackedBitsAccessor(Stream &outStream, const Class *obj) {
+    const auto totalBits = GetPackedBitTotal(obj);
+    if (!totalBits) return;
+    const auto packedType = GetPackedBitsType(totalBits);
+    outStream.Write(
+        "\t", packedType, " GetPackedBits() const {\n"
+        "\t\t", packedType, " packedBits { };\n");
+    uint32_t shift { 0 };
+    for(auto &member: obj->MemberList) {
+        const auto bitCount = GetPackedBitCount(obj, member);
+        if (!bitCount) continue;
+        outStream.Write("\t\tpackedBits |= static_cast<", packedType, ">(static_cast<", packedType, ">(", member.Name, ") << ", shift, ");\n");
+        shift += bitCount;
+    }
+    outStream.Write(
+        "\t\treturn packedBits;\n"
+        "\t}\n\n"
+        "\tvoid SetPackedBits(const ", packedType, " packedBits) {\n"
+        "\t\tSetPackedBits(packedBits, rohit::serializer::AllFields { });\n"
+        "\t}\n\n"
+        "\t// Only packed members in selector are set\n"
+        "\tvoid SetPackedBits(const ", packedType, " packedBits, const auto &selector) {\n");
+    shift = 0;
+    for(auto &member: obj->MemberList) {
+        const auto bitCount = GetPackedBitCount(obj, member);
+        if (!bitCount) continue;
+        outStream.Write("\t\tif (selector.Test(f_", member.Name, ")) this->", member.Name, " = static_cast<", GetCPPType(member), ">((packedBits >> ", shift, ") & ", GetBitMask(bitCount), ");\n");
+        shift += bitCount;
+    }
+    outStream.Write("\t}\n\n");
+}
+
+void WriteSerializerOutBodyForParent(Stream &outStream, const Class *obj, const rohit::serializer::SerializeKeyType serialize_key_type) {
     for(auto &parent: obj->parentlist) {
-        if (first) {
-            first = false;
-            outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutStart(");
-        }
-        else outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOut(");
+        outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOut(");
         if (serialize_key_type == rohit::serializer::SerializeKeyType::String) {
             outStream.Write(
                 "std::make_pair(std::string_view { \"", parent.displayName, "\" }, static_cast<const ", parent.Name," *>(this))"
@@ -143,40 +516,68 @@ void WriteSerializerOutBodyForParent(Stream &outStream, const Class *obj, const
     }
 }
 
-void WriteSerializerOutBodyNonUnion(Stream &outStream, const Member &member, const rohit::serializer::SerializeKeyType serialize_key_type, bool &first) {
-    if (first) {
-        first = false;
-        outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutStart(");
-    }
-    else outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOut(");
+// In sparse mode keyed member equal to its value in default object is skipped
+void WriteSerializerOutSparseCheck(Stream &outStream, const std::string &value, const std::string &defaultValue, const rohit::serializer::SerializeKeyType serialize_key_type) {
+    if (serialize_key_type == rohit::serializer::SerializeKeyType::None) return;
+    outStream.Write(
+        "\n\t\t\tif (serializerProtocol.encode_mode != rohit::serializer::EncodeMode::Sparse || "
+        "!rohit::serializer::IsDefault(", value, ", ", defaultValue, "))");
+}
+
+void WriteSerializerOutMember(Stream &outStream, const Member &member, const std::string &memberValue, const rohit::serializer::SerializeKeyType serialize_key_type) {
+    outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOut(");
     if (serialize_key_type == rohit::serializer::SerializeKeyType::String) {
         if (member.typeNameList[0].type != ObjectType::Enum) {
             outStream.Write(
-                "std::make_pair(std::string_view { \"", member.displayName, "\" }, ", member.Name,")"
+                "std::make_pair(std::string_view { \"", member.displayName, "\" }, ", memberValue,")"
                 ");");
         } else {
             outStream.Write(
-                "std::make_pair(std::string_view { \"", member.displayName, "\" }, ", member.typeNameList[0].declaredNameSpace->GetFullName() , "::to_string(", member.Name,"))"
+                "std::make_pair(std::string_view { \"", member.displayName, "\" }, ", member.typeNameList[0].declaredNameSpace->GetFullName() , "::to_string(", memberValue,"))"
                 ");");
         }
     } else if (serialize_key_type == rohit::serializer::SerializeKeyType::Integer){
         outStream.Write(
-            "std::make_pair(static_cast<uint32_t>(", member.id,"), ", member.Name,")"
+            "std::make_pair(static_cast<uint32_t>(", member.id,"), ", memberValue,")"
             ");");
     } else {
         outStream.Write(
-            member.Name, ");");
+            memberValue, ");");
+    }
+}
+
+void WriteSerializerOutBodyNonUnion(Stream &outStream, const Class *obj, const Member &member, const rohit::serializer::SerializeKeyType serialize_key_type) {
+    const auto memberValue = GetMemberOutValue(obj, member);
+    if (IsBitField(obj, member)) {
+        WriteSerializerOutSparseCheck(outStream, memberValue, "static_cast<" + GetCPPType(member) + ">(GetDefaultObject()." + member.Name + ")", serialize_key_type);
+    } else {
+        WriteSerializerOutSparseCheck(outStream, memberValue, "GetDefaultObject()." + member.Name, serialize_key_type);
     }
+    WriteSerializerOutMember(outStream, member, memberValue, serialize_key_type);
 }
 
-void WriteSerializerOutBodyUnion(Stream &outStream, const Member &member, const rohit::serializer::SerializeKeyType serialize_key_type, bool &first) {
+// All packed members are written as single word at position of first packed member
+void WriteSerializerOutPackedBits(Stream &outStream, const Member &member, const rohit::serializer::SerializeKeyType serialize_key_type) {
+    outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOut(");
+    if (serialize_key_type == rohit::serializer::SerializeKeyType::String) {
+        outStream.Write("std::make_pair(std::string_view { \"#bits\" }, GetPackedBits()));");
+    } else if (serialize_key_type == rohit::serializer::SerializeKeyType::Integer){
+        outStream.Write("std::make_pair(static_cast<uint32_t>(", member.id,"), GetPackedBits()));");
+    } else {
+        outStream.Write("GetPackedBits());");
+    }
+}
+
+void WriteSerializerOutBodyPackedBits(Stream &outStream, const Member &member, const rohit::serializer::SerializeKeyType serialize_key_type) {
+    WriteSerializerOutSparseCheck(outStream, "GetPackedBits()", "GetDefaultObject().GetPackedBits()", serialize_key_type);
+    WriteSerializerOutPackedBits(outStream, member, serialize_key_type);
+}
+
+void WriteSerializerOutBodyUnion(Stream &outStream, const Member &member, const rohit::serializer::SerializeKeyType serialize_key_type) {
     outStream.Write("\n\t\t\tswitch(", member.Name, "_type) {");
     for(size_t index { 0 }; index < member.typeNameList.size(); ++index) {
         outStream.Write("\n\t\t\t\tcase e_", member.Name, "::", member.typeNameList[index].EnumName, ":");
-        if (first) {
-            outStream.Write("\n\t\t\t\t\tserializerProtocol.StructSerializeOutStart(");
-        }
-        else outStream.Write("\n\t\t\t\t\tserializerProtocol.StructSerializeOut(");
+        outStream.Write("\n\t\t\t\t\tserializerProtocol.StructSerializeOut(");
         if (serialize_key_type == rohit::serializer::SerializeKeyType::String) {
             outStream.Write("std::make_pair( std::string_view {\"", member.displayName, ":", member.typeNameList[index].EnumName, "\"}, ",
                 member.Name, ".", member.typeNameList[index].EnumName, "));",
@@ -191,35 +592,285 @@ void WriteSerializerOutBodyUnion(Stream &outStream, const Member &member, const
                 "\n\t\t\t\t\tbreak;");
         }
     }
-    first = false;
     outStream.Write("\n\t\t\t}");
 }
 
-void WriteSerializerOutBody(Stream &outStream, const Class *obj, const rohit::serializer::SerializeKeyType serialize_key_type) {
-    bool first = true;
-    WriteSerializerOutBodyForParent(outStream, obj, serialize_key_type, first);
+void WriteSerializerOutBody(Stream &outStream, const Class *obj, const rohit::serializer::SerializeKeyType serialize_key_type, const bool packBits) {
+    const auto firstPackedMember = packBits ? GetFirstPackedMember(obj) : nullptr;
+    outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutStart();");
+    WriteSerializerOutBodyForParent(outStream, obj, serialize_key_type);
     for(auto &member: obj->MemberList) {
-        if (member.modifer != Member::Union) {
-            WriteSerializerOutBodyNonUnion(outStream, member, serialize_key_type, first);
+        if (firstPackedMember && GetPackedBitCount(obj, member)) {
+            if (&member == firstPackedMember) WriteSerializerOutBodyPackedBits(outStream, member, serialize_key_type);
+        } else if (member.modifer != Member::Union) {
+            WriteSerializerOutBodyNonUnion(outStream, obj, member, serialize_key_type);
         }
         else {
-            WriteSerializerOutBodyUnion(outStream, member, serialize_key_type, first);
+            WriteSerializerOutBodyUnion(outStream, member, serialize_key_type);
         }
     }
     outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutEnd();");
 }
 
+// Union member is equal when same type is set with equal value
+const std::string GetUnionEqualName(const Member &member) {
+    std::string functionName { "IsEqual" + member.Name };
+    functionName[7] = static_cast<char>(std::toupper(static_cast<unsigned char>(functionName[7])));
+    return functionName;
+}
+
+void WriteEqualOperator(Stream &outStream, const Class *obj) {
+    for(auto &member: obj->MemberList) {
+        if (member.modifer != Member::Union) continue;
+        outStream.Write(
+            "\tbool ", GetUnionEqualName(member), "(const ", obj->Name, " &rhs) const {\n"
+            "\t\tif (", member.Name, "_type != rhs.", member.Name, "_type) return false;\n"
+            "\t\tswitch(", member.Name, "_type) {\n"
+            "\t\t\tdefault:");
+        for(auto &typeName: member.typeNameList) {
+            outStream.Write(
+                "\n\t\t\tcase e_", member.Name, "::", typeName.EnumName, ": return ",
+                member.Name, ".", typeName.EnumName, " == rhs.", member.Name, ".", typeName.EnumName, ";");
+        }
+        outStream.Write(
+            "\n\t\t}\n"
+            "\t}\n\n");
+    }
+
+    outStream.Write("\tbool operator==([[maybe_unused]] const ", obj->Name, " &rhs) const {\n\t\treturn true");
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\n\t\t\t&& static_cast<const ", parent.Name, " &>(*this) == static_cast<const ", parent.Name, " &>(rhs)");
+    }
+    for(auto &member: obj->MemberList) {
+        if (member.modifer == Member::Union) outStream.Write("\n\t\t\t&& ", GetUnionEqualName(member), "(rhs)");
+        else outStream.Write("\n\t\t\t&& ", member.Name, " == rhs.", member.Name);
+    }
+    outStream.Write(";\n\t}\n\n");
+}
+
+// Bitmap has members not equal to reference object, which is default object, or previous object
+// for delta and patch. Parents are always present except in delta and patch. Patch writes object,
+// list and map members and parents as their own patch.
+void WriteSerializerOutBodyKeyBitmap(Stream &outStream, const Class *obj, const bool delta, const bool patch) {
+    const auto firstPackedMember = GetFirstPackedMember(obj);
+    const auto slotCount = GetSlotCount(obj);
+    outStream.Write("\n\t\t\tstd::array<uint64_t, ", (slotCount + 63) / 64, "> presence { };");
+    uint32_t slot { 0 };
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\n\t\t\t");
+        if (delta) outStream.Write("if (static_cast<const ", parent.Name, " &>(*this) != static_cast<const ", parent.Name, " &>(previous)) ");
+        outStream.Write("presence[", slot / 64, "] |= 1ULL << ", slot % 64, ";");
+        ++slot;
+    }
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member)) {
+            if (&member != firstPackedMember) continue;
+            if (delta) outStream.Write("\n\t\t\tif (GetPackedBits() != previous.GetPackedBits())");
+            else outStream.Write("\n\t\t\tif (!rohit::serializer::IsDefault(GetPackedBits(), GetDefaultObject().GetPackedBits()))");
+        } else if (member.modifer != Member::Union) {
+            if (delta) outStream.Write("\n\t\t\tif (", member.Name, " != previous.", member.Name, ")");
+            else outStream.Write("\n\t\t\tif (!rohit::serializer::IsDefault(", GetMemberOutValue(obj, member), ", GetDefaultObject().", member.Name, "))");
+        } else {
+            outStream.Write("\n\t\t\t");
+            if (delta) outStream.Write("if (!", GetUnionEqualName(member), "(previous))");
+        }
+        outStream.Write(" presence[", slot / 64, "] |= 1ULL << ", slot % 64, ";");
+        ++slot;
+    }
+    outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutBitmap(presence, serialize_slot_count);");
+    slot = 0;
+    for(auto &parent: obj->parentlist) {
+        if (delta) outStream.Write("\n\t\t\tif (presence[", slot / 64, "] & (1ULL << ", slot % 64, "))");
+        if (patch) {
+            outStream.Write(
+                "\n\t\t\tserializerProtocol.StructSerializeOut(rohit::serializer::MakePatch(static_cast<const ", parent.Name, " &>(previous), ",
+                "static_cast<const ", parent.Name, " &>(*this)));");
+        } else outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOut(static_cast<const ", parent.Name, " *>(this));");
+        ++slot;
+    }
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member) && &member != firstPackedMember) continue;
+        outStream.Write("\n\t\t\tif (presence[", slot / 64, "] & (1ULL << ", slot % 64, "))");
+        if (&member == firstPackedMember) {
+            WriteSerializerOutBodyPackedBits(outStream, member, rohit::serializer::SerializeKeyType::None);
+        } else if (member.modifer != Member::Union && patch) {
+            WriteSerializerOutMember(outStream, member, "rohit::serializer::MakePatch(previous." + member.Name + ", " + member.Name + ")", rohit::serializer::SerializeKeyType::None);
+        } else if (member.modifer != Member::Union) {
+            WriteSerializerOutBodyNonUnion(outStream, obj, member, rohit::serializer::SerializeKeyType::None);
+        } else {
+            WriteSerializerOutBodyUnion(outStream, member, rohit::serializer::SerializeKeyType::None);
+        }
+        ++slot;
+    }
+    outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutEnd();");
+}
+
+// SerializeOutDelta writes members changed since previous object, see rohit::serializer::DeltaWriter
+void WriteSerializeOutDelta(Stream &outStream, const Class *obj) {
+    outStream.Write(
+        "\t// Bitmap has members which are not equal to those of previous, only they are written. Reader applies\n"
+        "\t// them to its copy of previous object, see rohit::serializer::DeltaReader.\n"
+        "\ttemplate <typename SerializeOutProtocol>\n"
+        "\tvoid SerializeOutDelta(SerializeOutProtocol &serializerProtocol, [[maybe_unused]] const ", obj->Name, " &previous) const {\n"
+        "\t\tstatic_assert(serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Bitmap, \"Delta needs bitmap protocol\");\n"
+        "\t\t[[maybe_unused]] const rohit::serializer::NoListSource source { };\n"
+        "\t\tif constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Bitmap) {");
+    WriteSerializerOutBodyKeyBitmap(outStream, obj, true, false);
+    outStream.Write("\n\t\t}\n\t}\n\n");
+}
+
+// Keyed patch has members which are not equal to those of previous, see WriteSerializerOutBodyKeyBitmap
+void WriteSerializerOutBodyPatch(Stream &outStream, const Class *obj, const rohit::serializer::SerializeKeyType serialize_key_type, const bool packBits) {
+    const auto firstPackedMember = packBits ? GetFirstPackedMember(obj) : nullptr;
+    outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutStart();");
+    for(auto &parent: obj->parentlist) {
+        const auto parentPatch = "rohit::serializer::MakePatch(static_cast<const " + parent.Name + " &>(previous), static_cast<const " + parent.Name + " &>(*this))";
+        outStream.Write(
+            "\n\t\t\tif (static_cast<const ", parent.Name, " &>(*this) != static_cast<const ", parent.Name, " &>(previous))",
+            "\n\t\t\tserializerProtocol.StructSerializeOut(");
+        if (serialize_key_type == rohit::serializer::SerializeKeyType::String) {
+            outStream.Write("std::make_pair(std::string_view { \"", parent.displayName, "\" }, ", parentPatch, "));");
+        } else {
+            outStream.Write("std::make_pair(static_cast<uint32_t>(", parent.id, "), ", parentPatch, "));");
+        }
+    }
+    for(auto &member: obj->MemberList) {
+        if (firstPackedMember && GetPackedBitCount(obj, member)) {
+            if (&member != firstPackedMember) continue;
+            outStream.Write("\n\t\t\tif (GetPackedBits() != previous.GetPackedBits())");
+            WriteSerializerOutPackedBits(outStream, member, serialize_key_type);
+        } else if (member.modifer != Member::Union) {
+            if (IsBitField(obj, member)) {
+                outStream.Write("\n\t\t\tif (", GetMemberValue(obj, member), " != static_cast<", GetCPPType(member), ">(previous.", member.Name, "))");
+            } else outStream.Write("\n\t\t\tif (", member.Name, " != previous.", member.Name, ")");
+            if (IsBitField(obj, member) || member.typeNameList[0].type == ObjectType::Enum) {
+                WriteSerializerOutMember(outStream, member, GetMemberValue(obj, member), serialize_key_type);
+            } else {
+                WriteSerializerOutMember(outStream, member, "rohit::serializer::MakePatch(previous." + member.Name + ", " + member.Name + ")", serialize_key_type);
+            }
+        } else {
+            outStream.Write("\n\t\t\tif (!", GetUnionEqualName(member), "(previous)) {");
+            WriteSerializerOutBodyUnion(outStream, member, serialize_key_type);
+            outStream.Write("\n\t\t\t}");
+        }
+    }
+    outStream.Write("\n\t\t\tserializerProtocol.StructSerializeOutEnd();");
+}
+
+// SerializeOutPatch writes members changed since previous object, see rohit::serializer::Patch
+void WriteSerializeOutPatch(Stream &outStream, const Class *obj) {
+    outStream.Write(
+        "\t// Patch has members which are not equal to those of previous, object, list and map members are written\n"
+        "\t// as their own patch, see rohit::serializer::Patch. Applying it to copy of previous gives this object.\n"
+        "\ttemplate <typename SerializeOutProtocol>\n"
+        "\tvoid SerializeOutPatch(SerializeOutProtocol &serializerProtocol, [[maybe_unused]] const ", obj->Name, " &previous) const {\n"
+        "\t\tstatic_assert(serializerProtocol.serialize_key_type != rohit::serializer::SerializeKeyType::None, \"Patch needs protocol with keys or bitmap\");");
+    outStream.Write("\n\t\tif constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Integer) {");
+    WriteSerializerOutBodyPatch(outStream, obj, rohit::serializer::SerializeKeyType::Integer, true);
+    if (GetPackedBitTotal(obj)) {
+        outStream.Write("\n\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::String && serializerProtocol.pack_bits) {");
+        WriteSerializerOutBodyPatch(outStream, obj, rohit::serializer::SerializeKeyType::String, true);
+    }
+    outStream.Write("\n\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::String) {");
+    WriteSerializerOutBodyPatch(outStream, obj, rohit::serializer::SerializeKeyType::String, false);
+    outStream.Write("\n\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Bitmap) {");
+    WriteSerializerOutBodyKeyBitmap(outStream, obj, true, true);
+    outStream.Write(
+        "\n\t\t}\n"
+        "\t}\n\n"
+        "\t// Patch turning from into to, see ApplyPatch\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+        "\tstatic void Diff(rohit::Stream &stream, const ", obj->Name, " &from, const ", obj->Name, " &to) {\n"
+        "\t\tusing SerializerOutProtocol = SerializerProtocol<rohit::serializer::SerializeType::Out>;\n"
+        "\t\tSerializerOutProtocol serializerProtocol { stream };\n"
+        "\t\tto.SerializeOutPatch(serializerProtocol, from);\n"
+        "\t}\n\n");
+}
+
+// SerializeOutWith<Member> writes object with elements of list taken from a range
+void WriteSerializeOutWithList(Stream &outStream, const Class *obj) {
+    for(auto &member: obj->MemberList) {
+        if (!IsStreamableList(member)) continue;
+        std::string functionName { "SerializeOutWith" + member.Name };
+        functionName[16] = static_cast<char>(std::toupper(static_cast<unsigned char>(functionName[16])));
+        outStream.Write(
+            "\t// Elements of ", member.Name, " are taken from range which is read once instead of member. Count is written\n"
+            "\t// before elements of sized range, otherwise binary output reserves widest size and patches it later,\n"
+            "\t// stream must then be rohit::FullStream.\n"
+            "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol, std::ranges::input_range Range>\n"
+            "\tvoid ", functionName, "(rohit::Stream &stream, Range &&range) const {\n"
+            "\t\tusing SerializerOutProtocol = SerializerProtocol<rohit::serializer::SerializeType::Out>;\n"
+            "\t\tSerializerOutProtocol serializerProtocol { stream };\n"
+            "\t\tSerializeOut(serializerProtocol, rohit::serializer::RangeListSource<f_", member.Name, ", Range> { range });\n"
+            "\t}\n\n");
+    }
+} // WriteSerializeOutWithList
+
+// SerializeOutParallel<Member> encodes chunks of list on pool, output is same as of SerializeOut
+void WriteSerializeOutParallel(Stream &outStream, const Class *obj) {
+    for(auto &member: obj->MemberList) {
+        if (!IsStreamableList(member)) continue;
+        std::string functionName { "SerializeOutParallel" + member.Name };
+        functionName[20] = static_cast<char>(std::toupper(static_cast<unsigned char>(functionName[20])));
+        outStream.Write(
+            "\t// Elements of ", member.Name, " are encoded in chunks of chunkSize on pool in separate buffers which are\n"
+            "\t// appended in order. Pool must provide ParallelFor(count, function), see rohit::ThreadPool.\n"
+            "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol, typename Pool>\n"
+            "\tvoid ", functionName, "(rohit::Stream &stream, Pool &pool, const size_t chunkSize = 1024) const {\n"
+            "\t\tusing SerializerOutProtocol = SerializerProtocol<rohit::serializer::SerializeType::Out>;\n"
+            "\t\tSerializerOutProtocol serializerProtocol { stream };\n"
+            "\t\tSerializeOut(serializerProtocol, rohit::serializer::ParallelListSource<f_", member.Name, ", Pool> { pool, chunkSize });\n"
+            "\t}\n\n");
+    }
+} // WriteSerializeOutParallel
+
+// SerializeOutIndexed<Member> records rohit::serializer::ListIndex of list for SerializeInParallel<Member>
+void WriteSerializeOutIndexed(Stream &outStream, const Class *obj) {
+    for(auto &member: obj->MemberList) {
+        if (!IsStreamableList(member)) continue;
+        std::string functionName { "SerializeOutIndexed" + member.Name };
+        functionName[19] = static_cast<char>(std::toupper(static_cast<unsigned char>(functionName[19])));
+        outStream.Write(
+            "\t// Output is same as of SerializeOut, offset of every index.interval-th element of ", member.Name, " is recorded\n"
+            "\t// in index. Only binary protocols are supported.\n"
+            "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+            "\tvoid ", functionName, "(rohit::FullStream &stream, rohit::serializer::ListIndex &index) const {\n"
+            "\t\tusing SerializerOutProtocol = SerializerProtocol<rohit::serializer::SerializeType::Out>;\n"
+            "\t\tSerializerOutProtocol serializerProtocol { stream };\n"
+            "\t\tindex.offsets.clear();\n"
+            "\t\tSerializeOut(serializerProtocol, rohit::serializer::IndexedListSource<f_", member.Name, "> { index, stream.CurrentOffset() });\n"
+            "\t}\n\n");
+    }
+} // WriteSerializeOutIndexed
+
 void WriteSerializerOutBody(Stream &outStream, const Class *obj) {
     outStream.Write(
+        "\tstatic constexpr uint32_t serialize_slot_count { ", GetSlotCount(obj), " };\n\n"
+        "\tstatic const ", obj->Name, " &GetDefaultObject() {\n"
+        "\t\tstatic const ", obj->Name, " defaultObject { };\n"
+        "\t\treturn defaultObject;\n"
+        "\t}\n\n"
         "\ttemplate <typename SerializeOutProtocol>\n"
-        "\tvoid SerializeOut(SerializeOutProtocol &serializerProtocol) const {"
+        "\tvoid SerializeOut(SerializeOutProtocol &serializerProtocol) const {\n"
+        "\t\tSerializeOut(serializerProtocol, rohit::serializer::NoListSource { });\n"
+        "\t}\n\n"
+        "\t// List member selected by source is written from its range instead of member\n"
+        "\ttemplate <typename SerializeOutProtocol, typename ListSource>\n"
+        "\tvoid SerializeOut(SerializeOutProtocol &serializerProtocol, [[maybe_unused]] const ListSource &source) const {"
     );
+    const bool hasPackedBits = GetPackedBitTotal(obj) != 0;
     outStream.Write("\n\t\tif constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::None) {");
-    WriteSerializerOutBody(outStream, obj, rohit::serializer::SerializeKeyType::None);
+    WriteSerializerOutBody(outStream, obj, rohit::serializer::SerializeKeyType::None, true);
     outStream.Write("\n\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Integer) {");
-    WriteSerializerOutBody(outStream, obj, rohit::serializer::SerializeKeyType::Integer);
+    WriteSerializerOutBody(outStream, obj, rohit::serializer::SerializeKeyType::Integer, true);
+    if (hasPackedBits) {
+        outStream.Write("\n\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::String && serializerProtocol.pack_bits) {");
+        WriteSerializerOutBody(outStream, obj, rohit::serializer::SerializeKeyType::String, true);
+    }
     outStream.Write("\n\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::String) {");
-    WriteSerializerOutBody(outStream, obj, rohit::serializer::SerializeKeyType::String);
+    WriteSerializerOutBody(outStream, obj, rohit::serializer::SerializeKeyType::String, false);
+    outStream.Write("\n\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Bitmap) {");
+    WriteSerializerOutBodyKeyBitmap(outStream, obj, false, false);
     outStream.Write("\n\t\t} else { static_assert(true, \"Unsupported serializer type\"); }\n\t}\n\n");
     outStream.Write(
         "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
@@ -229,11 +880,27 @@ void WriteSerializerOutBody(Stream &outStream, const Class *obj) {
         "\t\tSerializeOut(serializerProtocol);\n"
         "\t}\n\n"
     );
+    WriteSerializeOutWithList(outStream, obj);
+    WriteSerializeOutParallel(outStream, obj);
+    WriteSerializeOutIndexed(outStream, obj);
+    WriteSerializeOutDelta(outStream, obj);
+    WriteSerializeOutPatch(outStream, obj);
+}
+
+// Field index of first member of parent, parents are numbered in order before members
+std::string GetParentFieldOffset(const Class *obj, const Parent &parent) {
+    std::string offset { };
+    for(auto &previous: obj->parentlist) {
+        if (&previous == &parent) break;
+        if (!offset.empty()) offset += " + ";
+        offset += previous.Name + "::field_count";
+    }
+    return offset.empty() ? "0" : offset;
 }
 
 void WriteSerializerInBodyForParentKeyNone(Stream &outStream, const Class *obj) {
     for(auto &parent: obj->parentlist) {
-        outStream.Write("\t\t\tthis->", parent.Name, "::SerializeIn(serializerProtocol);\n");
+        outStream.Write("\t\t\tthis->", parent.Name, "::SerializeIn(serializerProtocol, rohit::serializer::ParentSelector<", GetParentFieldOffset(obj, parent), ">(selector));\n");
     }
 }
 
@@ -241,7 +908,7 @@ void WriteSerializerInBodyForParentKeyInteger(Stream &outStream, const Class *ob
     for(auto &parent: obj->parentlist) {
         outStream.Write(
             "\t\t\tcase ", parent.id, ":\n"
-            "\t\t\t\tthis->", parent.Name, "::SerializeIn(serializerProtocol);\n"
+            "\t\t\t\tthis->", parent.Name, "::SerializeIn(serializerProtocol, rohit::serializer::ParentSelector<", GetParentFieldOffset(obj, parent), ">(selector));\n"
             "\t\t\t\tbreak;\n");
     }
 } // WriteSerializerInBodyForParentKeyInteger
@@ -250,114 +917,173 @@ void WriteSerializerInBodyForParentKeyString(Stream &outStream, const Class *obj
     for(auto &parent: obj->parentlist) {
         outStream.Write(
             "\t\t\tcase rohit::Hash(\"", parent.displayName, "\"):\n"
-            "\t\t\t\tthis->", parent.Name, "::SerializeIn(serializerProtocol);\n"
+            "\t\t\t\tthis->", parent.Name, "::SerializeIn(serializerProtocol, rohit::serializer::ParentSelector<", GetParentFieldOffset(obj, parent), ">(selector));\n"
             "\t\t\t\tbreak;\n");
     }
 } // WriteSerializerInBodyForParentKeyString
 
-void WriteSerializerInBodyNonUnionKeyString(Stream &outStream, const Member &member) {
-    if (member.typeNameList[0].type != ObjectType::Enum) {
+// Statement decoding member in place, streamable list goes through selector, object, list and
+// map member is patched with rohit::serializer::PatchFields
+void WriteSerializerInMemberValue(Stream &outStream, const Member &member, const Allocator allocator) {
+    if (IsStreamableList(member)) {
+        outStream.Write("rohit::serializer::SerializeInList<f_", member.Name, ">(serializerProtocol, selector, this->", member.Name, ");\n");
+    } else if (member.modifer != Member::none || member.typeNameList[0].type == ObjectType::Class) {
+        outStream.Write("rohit::serializer::SerializeInMember(serializerProtocol, selector, this->", member.Name, ");\n");
+    } else {
+        outStream.Write("serializerProtocol.template SerializeIn<", GetCPPType(member, allocator),">(this->", member.Name, ");\n");
+    }
+} // WriteSerializerInMemberValue
+
+// Member not in selector is skipped without decoding
+void WriteSerializerInSkip(Stream &outStream, const Member &member, const std::string &skipType) {
+    outStream.Write("\t\t\t\tif (!selector.Test(f_", member.Name, ")) { serializerProtocol.template SkipIn<", skipType, ">(); break; }\n");
+} // WriteSerializerInSkip
+
+void WriteSerializerInBodyNonUnionKeyString(Stream &outStream, const Class *obj, const Member &member, const Allocator allocator) {
+    if (member.typeNameList[0].type != ObjectType::Enum && IsBitField(obj, member)) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, "\"): {\n");
+        WriteSerializerInSkip(outStream, member, GetCPPType(member));
         outStream.Write(
-            "\t\t\tcase rohit::Hash(\"", member.displayName, "\"):\n"
-            "\t\t\t\tserializerProtocol.template SerializeIn<", GetCPPType(member),">(this->", member.Name, ");\n"
-            "\t\t\t\tbreak;\n");
+            "\t\t\t\t", GetCPPType(member), " local_", member.Name, " { };\n"
+            "\t\t\t\tserializerProtocol.template SerializeIn<", GetCPPType(member),">(local_", member.Name, ");\n"
+            "\t\t\t\tthis->", member.Name, " = local_", member.Name, ";\n"
+            "\t\t\t\tbreak;\n"
+            "\t\t\t}\n");
+    } else if (member.typeNameList[0].type != ObjectType::Enum) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, "\"):\n");
+        WriteSerializerInSkip(outStream, member, GetCPPType(member, allocator));
+        outStream.Write("\t\t\t\t");
+        WriteSerializerInMemberValue(outStream, member, allocator);
+        outStream.Write("\t\t\t\tbreak;\n");
     } else {
+        outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, "\"): {\n");
+        WriteSerializerInSkip(outStream, member, "std::string");
         outStream.Write(
-            "\t\t\tcase rohit::Hash(\"", member.displayName, "\"): {\n"
             "\t\t\t\tstd::string str_", member.Name, " { };\n"
             "\t\t\t\tserializerProtocol.template SerializeIn<std::string>(str_", member.Name, ");\n"
-            "\t\t\t\tthis->", member.Name, " = to_", member.typeNameList[0].Name,"(str_", member.Name, ");\n"
+            "\t\t\t\tdecltype(this->", member.Name, ") value_", member.Name, " { };\n"
+            "\t\t\t\tif (from_string(str_", member.Name, ", value_", member.Name, ")) this->", member.Name, " = value_", member.Name, ";\n"
+            "\t\t\t\telse serializerProtocol.Fail(rohit::serializer::ErrorKind::BadValue, \"Bad Enum Name\");\n"
             "\t\t\t\tbreak;\n"
             "\t\t\t}\n");
     }
 } // WriteSerializerInBodyNonUnionKeyString
 
-void WriteSerializerInBodyNonUnionKeyInteger(Stream &outStream, const Member &member) {
-    outStream.Write(
-        "\t\t\tcase ", member.id, ":\n"
-        "\t\t\t\tserializerProtocol.template SerializeIn<", GetCPPType(member),">(this->", member.Name, ");\n"
-        "\t\t\t\tbreak;\n");
+void WriteSerializerInBodyNonUnionKeyInteger(Stream &outStream, const Member &member, const Allocator allocator) {
+    outStream.Write("\t\t\tcase ", member.id, ":\n");
+    WriteSerializerInSkip(outStream, member, GetCPPType(member, allocator));
+    outStream.Write("\t\t\t\t");
+    WriteSerializerInMemberValue(outStream, member, allocator);
+    outStream.Write("\t\t\t\tbreak;\n");
 } // WriteSerializerInBodyNonUnionKeyInteger
 
-void WriteSerializerInBodyNonUnionKeyNone(Stream &outStream, const Member &member) {
-    outStream.Write(
-        "\t\t\tserializerProtocol.template SerializeIn<", GetCPPType(member),">(this->", member.Name, ");\n");
+void WriteSerializerInBodyNonUnionKeyNone(Stream &outStream, const Member &member, const Allocator allocator) {
+    outStream.Write("\t\t\tif (selector.Test(f_", member.Name, ")) ");
+    WriteSerializerInMemberValue(outStream, member, allocator);
+    outStream.Write("\t\t\telse serializerProtocol.template SkipIn<", GetCPPType(member, allocator), ">();\n");
 } // WriteSerializerInBodyNonUnionKeyNone
 
+void WriteSerializerInBodyPackedBits(Stream &outStream, const Class *obj) {
+    const auto packedType = GetPackedBitsType(GetPackedBitTotal(obj));
+    outStream.Write(
+        "\t\t\t\t", packedType, " packedBits { };\n"
+        "\t\t\t\tserializerProtocol.template SerializeIn<", packedType, ">(packedBits);\n"
+        "\t\t\t\tSetPackedBits(packedBits, selector);\n");
+} // WriteSerializerInBodyPackedBits
 
-void WriteSerializerInBodyUnionKeyInteger(Stream &outStream, const Member &member) {
+// Union type is read in local, member is updated only when selected
+void WriteSerializerInBodyUnionSwitch(Stream &outStream, const Member &member, const std::string &indent, const std::string &badTypeAction) {
     outStream.Write(
-        "\t\t\tcase ", member.id, ": {\n"
-        "\t\t\t\tthis->", member.Name, "_type = static_cast<e_", member.Name, ">(serializerProtocol.SerializeInVariable());\n"
-        "\t\t\t\tswitch(this->", member.Name, "_type) {\n"
+        indent, "const auto ", member.Name, "_type_local = static_cast<e_", member.Name, ">(serializerProtocol.SerializeInVariable());\n",
+        indent, "switch(", member.Name, "_type_local) {\n"
     );
-
     for(size_t index { 0 }; index < member.typeNameList.size(); ++index) {
+        auto &typeName = member.typeNameList[index];
         outStream.Write(
-            "\t\t\t\t\tcase e_", member.Name, "::", member.typeNameList[index].EnumName, ":\n"
-            "\t\t\t\t\t\tserializerProtocol.SerializeIn(this->", member.Name,".", member.typeNameList[index].EnumName, ");\n"
-            "\t\t\t\t\t\tbreak;\n"
+            indent, "\tcase e_", member.Name, "::", typeName.EnumName, ":\n",
+            indent, "\t\tif (selector.Test(f_", member.Name, ")) {\n",
+            indent, "\t\t\tthis->", member.Name, "_type = ", member.Name, "_type_local;\n",
+            indent, "\t\t\tserializerProtocol.SerializeIn(this->", member.Name,".", typeName.EnumName, ");\n",
+            indent, "\t\t} else serializerProtocol.template SkipIn<", typeName.Name, ">();\n",
+            indent, "\t\tbreak;\n"
         );
     }
     outStream.Write(
-        "\t\t\t\t\tdefault:\n"
-        "\t\t\t\t\t\tthrow rohit::serializer::exception::KeyNotFound {serializerProtocol.GetStream(), \"Bad Enum Name\"};\n"
-        "\t\t\t\t}\n"
+        indent, "\tdefault:\n",
+        indent, "\t\t", badTypeAction, "\n",
+        indent, "}\n");
+} // WriteSerializerInBodyUnionSwitch
+
+void WriteSerializerInBodyUnionKeyInteger(Stream &outStream, const Member &member) {
+    outStream.Write("\t\t\tcase ", member.id, ": {\n");
+    WriteSerializerInBodyUnionSwitch(outStream, member, "\t\t\t\t", "serializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"Bad Enum Name\"); break;");
+    outStream.Write(
         "\t\t\t\tbreak;\n"
         "\t\t\t}\n"
     );
 } // WriteSerializerInBodyUnionKeyInteger
 
 void WriteSerializerInBodyUnionKeyNone(Stream &outStream, const Member &member) {
-    outStream.Write(
-        "\t\t\tuint32_t ", member.Name, "_type_local { };\n"
-        "\t\t\t", member.Name, "_type_local = serializerProtocol.SerializeInVariable();\n"
-        "\t\t\tthis->", member.Name, "_type = static_cast<e_", member.Name, ">(", member.Name, "_type_local);\n"
-        "\t\t\tswitch(this->", member.Name, "_type) {\n"
-    );
-    for(size_t index { 0 }; index < member.typeNameList.size(); ++index) {
-        outStream.Write(
-            "\t\t\t\tcase e_", member.Name, "::", member.typeNameList[index].EnumName, ":\n"
-            "\t\t\t\t\tserializerProtocol.SerializeIn(this->", member.Name,".", member.typeNameList[index].EnumName, ");\n"
-            "\t\t\t\t\tbreak;\n"
-        );
-    }
+    outStream.Write("\t\t\t{\n");
+    WriteSerializerInBodyUnionSwitch(outStream, member, "\t\t\t\t", "break;");
     outStream.Write("\t\t\t}\n");
 } // WriteSerializerInBodyUnionKeyNone
 
 
 void WriteSerializerInBodyUnionKeyString(Stream &outStream, const Member &member) {
     for(auto &typeName: member.typeNameList) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, ":", typeName.EnumName, "\"):\n");
+        WriteSerializerInSkip(outStream, member, typeName.Name);
         outStream.Write(
-            "\t\t\tcase rohit::Hash(\"", member.displayName, ":", typeName.EnumName, "\"):\n"
             "\t\t\t\tthis->", member.Name, "_type = e_", member.Name, "::", typeName.EnumName, ";\n",
             "\t\t\t\tserializerProtocol.SerializeIn(this->", member.Name, ".", typeName.EnumName, ");\n"
             "\t\t\t\tbreak;\n");
     }
 } // WriteSerializerInBodyUnionString
 
-void WriteSerializerInBodyKeyNone(Stream &outStream, const Class *obj) {
+void WriteSerializerInBodyKeyNone(Stream &outStream, const Class *obj, const Allocator allocator) {
+    const auto firstPackedMember = GetFirstPackedMember(obj);
     WriteSerializerInBodyForParentKeyNone(outStream, obj);
     for(auto &member: obj->MemberList) {
-        if (member.modifer != Member::Union) {
-            WriteSerializerInBodyNonUnionKeyNone(outStream, member);
+        if (GetPackedBitCount(obj, member)) {
+            if (&member != firstPackedMember) continue;
+            outStream.Write("\t\t\t{\n");
+            WriteSerializerInBodyPackedBits(outStream, obj);
+            outStream.Write("\t\t\t}\n");
+        } else if (member.modifer != Member::Union) {
+            WriteSerializerInBodyNonUnionKeyNone(outStream, member, allocator);
         } else if (member.typeNameList.size()) {
             WriteSerializerInBodyUnionKeyNone(outStream, member);
         }
     }
 } // WriteSerializerInBodyKeyNone
 
-void WriteSerializerInBodyWithKeyInteger(Stream &outStream, const Class *obj) {
+// Overload without selector reads all members
+void WriteSerializerInMemberFunction(Stream &outStream, const std::string &functionName, const std::string &keyType, const std::string &keyName) {
     outStream.Write(
-        "\tvoid SerializeInMemberByIdentifier(auto &serializerProtocol, const uint32_t identifier) {\n"
-        "\t\tswitch(identifier) {\n"
-    );
+        "\tvoid ", functionName, "(auto &serializerProtocol, const ", keyType, " ", keyName, ") {\n"
+        "\t\t", functionName, "(serializerProtocol, ", keyName, ", rohit::serializer::AllFields { });\n"
+        "\t}\n\n"
+        "\tvoid ", functionName, "(auto &serializerProtocol, const ", keyType, " ", keyName, ", [[maybe_unused]] const auto &selector) {\n");
+}
+
+void WriteSerializerInBodyWithKeyInteger(Stream &outStream, const Class *obj, const Allocator allocator) {
+    WriteSerializerInMemberFunction(outStream, "SerializeInMemberByIdentifier", "uint32_t", "identifier");
+    outStream.Write("\t\tswitch(identifier) {\n");
 
     WriteSerializerInBodyForParentKeyInteger(outStream, obj);
 
+    const auto firstPackedMember = GetFirstPackedMember(obj);
     for(auto &member: obj->MemberList) {
-        if (member.modifer != Member::Union) {
-            WriteSerializerInBodyNonUnionKeyInteger(outStream, member);
+        if (GetPackedBitCount(obj, member)) {
+            if (&member != firstPackedMember) continue;
+            outStream.Write("\t\t\tcase ", member.id, ": {\n");
+            WriteSerializerInBodyPackedBits(outStream, obj);
+            outStream.Write(
+                "\t\t\t\tbreak;\n"
+                "\t\t\t}\n");
+        } else if (member.modifer != Member::Union) {
+            WriteSerializerInBodyNonUnionKeyInteger(outStream, member, allocator);
         } else if (member.typeNameList.size()) {
             WriteSerializerInBodyUnionKeyInteger(outStream, member);
         }
@@ -365,22 +1091,29 @@ void WriteSerializerInBodyWithKeyInteger(Stream &outStream, const Class *obj) {
     
     outStream.Write(
         "\t\t\tdefault:\n"
-        "\t\t\t\tthrow rohit::serializer::exception::KeyNotFound {serializerProtocol.GetStream(), \"Bad Member Identifier\"};\n"
+        "\t\t\t\tserializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"Bad Member Identifier\");\n"
+        "\t\t\t\tbreak;\n"
         "\t\t}\n"
         "\t}\n\n");
 }
 
-void WriteSerializerInBodyWithKeyString(Stream &outStream, const Class *obj) {
-    outStream.Write(
-        "\tvoid SerializeInMemberByName(auto &serializerProtocol, const std::string_view &name) {\n"
-        "\t\tswitch(rohit::Hash(name)) {\n"
-    );
+void WriteSerializerInBodyWithKeyString(Stream &outStream, const Class *obj, const Allocator allocator) {
+    WriteSerializerInMemberFunction(outStream, "SerializeInMemberByName", "std::string_view &", "name");
+    outStream.Write("\t\tswitch(rohit::Hash(name)) {\n");
 
     WriteSerializerInBodyForParentKeyString(outStream, obj);
 
+    if (GetPackedBitTotal(obj)) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"#bits\"): {\n");
+        WriteSerializerInBodyPackedBits(outStream, obj);
+        outStream.Write(
+            "\t\t\t\tbreak;\n"
+            "\t\t\t}\n");
+    }
+
     for(auto &member: obj->MemberList) {
         if (member.modifer != Member::Union) {
-            WriteSerializerInBodyNonUnionKeyString(outStream, member);
+            WriteSerializerInBodyNonUnionKeyString(outStream, obj, member, allocator);
         } else if (member.typeNameList.size()) {
             WriteSerializerInBodyUnionKeyString(outStream, member);
         }
@@ -388,41 +1121,672 @@ void WriteSerializerInBodyWithKeyString(Stream &outStream, const Class *obj) {
     
     outStream.Write(
         "\t\t\tdefault:\n"
-        "\t\t\t\tthrow rohit::serializer::exception::KeyNotFound {serializerProtocol.GetStream(), \"Bad Member Name\"};\n"
+        "\t\t\t\tserializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"Bad Member Name\");\n"
+        "\t\t\t\tbreak;\n"
         "\t\t}\n"
         "\t}\n\n");
 }
 
-void WriteSerializerInBody(Stream &outStream, const Class *obj) {
-    WriteSerializerInBodyWithKeyInteger(outStream, obj);
-    WriteSerializerInBodyWithKeyString(outStream, obj);
+void WriteSerializerInBodyWithKeyBitmap(Stream &outStream, const Class *obj, const Allocator allocator) {
+    WriteSerializerInMemberFunction(outStream, "SerializeInMemberByIndex", "uint32_t", "index");
+    outStream.Write("\t\tswitch(index) {\n");
+
+    uint32_t slot { 0 };
+    for(auto &parent: obj->parentlist) {
+        outStream.Write(
+            "\t\t\tcase ", slot++, ":\n"
+            "\t\t\t\tthis->", parent.Name, "::SerializeIn(serializerProtocol, rohit::serializer::ParentSelector<", GetParentFieldOffset(obj, parent), ">(selector));\n"
+            "\t\t\t\tbreak;\n");
+    }
+
+    const auto firstPackedMember = GetFirstPackedMember(obj);
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member) && &member != firstPackedMember) continue;
+        if (&member == firstPackedMember) {
+            outStream.Write("\t\t\tcase ", slot, ": {\n");
+            WriteSerializerInBodyPackedBits(outStream, obj);
+            outStream.Write(
+                "\t\t\t\tbreak;\n"
+                "\t\t\t}\n");
+        } else if (member.modifer != Member::Union) {
+            outStream.Write("\t\t\tcase ", slot, ":\n");
+            WriteSerializerInSkip(outStream, member, GetCPPType(member, allocator));
+            outStream.Write("\t\t\t\t");
+            WriteSerializerInMemberValue(outStream, member, allocator);
+            outStream.Write("\t\t\t\tbreak;\n");
+        } else {
+            outStream.Write("\t\t\tcase ", slot, ": {\n");
+            WriteSerializerInBodyUnionSwitch(outStream, member, "\t\t\t\t", "serializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"Bad Enum Name\"); break;");
+            outStream.Write(
+                "\t\t\t\tbreak;\n"
+                "\t\t\t}\n");
+        }
+        ++slot;
+    }
+
+    outStream.Write(
+        "\t\t\tdefault:\n"
+        "\t\t\t\tserializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"Bad Member Index\");\n"
+        "\t\t\t\tbreak;\n"
+        "\t\t}\n"
+        "\t}\n\n");
+}
+
+// Field names of class including its parents
+void GetFieldNames(WriterContext &context, const Class *obj, std::vector<std::string> &names) {
+    for(auto &parent: obj->parentlist) {
+        auto parentClass = context.layoutEstimator.FindParent(obj, parent.Name);
+        if (parentClass) GetFieldNames(context, parentClass, names);
+    }
+    for(auto &member: obj->MemberList) names.push_back(member.Name);
+}
+
+// Field index is unique in hierarchy, fields of parents come first. Field of first parent keeps
+// its index, field of later parent is declared again with offset of parents before it.
+void WriteFieldIndex(Stream &outStream, WriterContext &context, const Class *obj) {
+    std::string base { };
+    for(auto &parent: obj->parentlist) {
+        if (!base.empty()) {
+            auto parentClass = context.layoutEstimator.FindParent(obj, parent.Name);
+            std::vector<std::string> names { };
+            if (parentClass) GetFieldNames(context, parentClass, names);
+            for(auto &name: names) {
+                outStream.Write("\tstatic constexpr uint32_t f_", name, " { ", base, " + ", parent.Name, "::f_", name, " };\n");
+            }
+            base += " + ";
+        }
+        base += parent.Name + "::field_count";
+    }
+    if (!base.empty()) base += " + ";
+
+    uint32_t index { 0 };
+    for(auto &member: obj->MemberList) {
+        outStream.Write("\tstatic constexpr uint32_t f_", member.Name, " { ", base, index++, " };\n");
+    }
+    outStream.Write("\tstatic constexpr uint32_t field_count { ", base, index, " };\n\n");
+}
+
+const std::string GetMemberTypeTag(const Member &member) {
+    switch(member.modifer) {
+    default:
+    case Member::none:
+        if (member.typeNameList[0].type == ObjectType::Enum) return "rohit::serializer::MemberTypeTag::Enum";
+        if (member.typeNameList[0].type == ObjectType::Class) return "rohit::serializer::MemberTypeTag::Class";
+        return "rohit::serializer::MemberTypeTag::Primitive";
+    case Member::array:
+        return "rohit::serializer::MemberTypeTag::Array";
+    case Member::map:
+    case Member::hashmap:
+    case Member::flatmap:
+        return "rohit::serializer::MemberTypeTag::Map";
+    case Member::Union:
+        return "rohit::serializer::MemberTypeTag::Union";
+    }
+}
+
+void WriteMemberDescriptor(Stream &outStream, const Class *obj, const Allocator allocator) {
+    outStream.Write(
+        "\tstatic constexpr auto GetMemberDescriptors() {\n"
+        "\t\treturn std::make_tuple(");
+    bool first { true };
+    for(auto &member: obj->MemberList) {
+        if (first) first = false;
+        else outStream.Write(',');
+        const auto memberType = member.modifer == Member::Union ? "u_" + member.Name : GetCPPType(member, allocator);
+        const auto commonFields = "\"" + member.Name + "\", \"" + member.displayName + "\", " + std::to_string(member.id) + ", f_" + member.Name + ", " + GetMemberTypeTag(member);
+        if (IsBitField(obj, member)) {
+            outStream.Write(
+                "\n\t\t\trohit::serializer::BitFieldDescriptor<", obj->Name, ", ", memberType, "> { ", commonFields, ",\n"
+                "\t\t\t\t[](const ", obj->Name, " &obj) { return static_cast<", memberType, ">(obj.", member.Name, "); },\n"
+                "\t\t\t\t[](", obj->Name, " &obj, const ", memberType, " value) { obj.", member.Name, " = value; } }");
+        } else {
+            outStream.Write(
+                "\n\t\t\trohit::serializer::MemberDescriptor<", obj->Name, ", ", memberType, "> { ", commonFields, ", &", obj->Name, "::", member.Name, " }");
+        }
+    }
+    outStream.Write(
+        "\n\t\t);\n"
+        "\t}\n\n");
+
+    // Function is called with descriptor and value, parent members are visited first
+    for(const std::string_view constness: { "const ", "" }) {
+        outStream.Write(
+            "\ttemplate <typename Function>\n"
+            "\tconstexpr void ForEachMember(Function &&function) ", constness, "{\n");
+        for(auto &parent: obj->parentlist) {
+            outStream.Write("\t\tthis->", parent.Name, "::ForEachMember(function);\n");
+        }
+        outStream.Write(
+            "\t\tstd::apply([this, &function](const auto &...descriptor) { (function(descriptor, descriptor.Get(*this)), ...); }, GetMemberDescriptors());\n"
+            "\t}\n\n");
+    }
+}
+
+// Stream<Member> decodes other members in object and passes list elements one at a time to function
+void WriteStreamList(Stream &outStream, const Class *obj) {
+    for(auto &member: obj->MemberList) {
+        if (!IsStreamableList(member)) continue;
+        std::string functionName { "Stream" + member.Name };
+        functionName[6] = static_cast<char>(std::toupper(static_cast<unsigned char>(functionName[6])));
+        outStream.Write(
+            "\t// Element of ", member.Name, " is passed to function as rvalue and is not stored, function returning false stops\n"
+            "\t// decoding with ErrorKind::Stopped. Memory used does not depend on number of elements.\n"
+            "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol, typename Function>\n"
+            "\trohit::serializer::DecodeStatus ", functionName, "(const rohit::Stream &stream, Function &&function) {\n"
+            "\t\tusing SerializerInProtocol = typename SerializerProtocol<rohit::serializer::SerializeType::In>::template with_decode_mode<rohit::serializer::DecodeMode::NoThrow>;\n"
+            "\t\tSerializerInProtocol serializerProtocol { stream };\n"
+            "\t\tconst rohit::serializer::StreamSelector<f_", member.Name, ", typename decltype(", member.Name, ")::value_type, Function> selector { function };\n"
+            "\t\tSerializeIn(serializerProtocol, selector);\n"
+            "\t\treturn serializerProtocol.GetStatus();\n"
+            "\t}\n\n");
+    }
+} // WriteStreamList
+
+// SerializeInParallel<Member> decodes chunks of list in parallel using index of SerializeOutIndexed<Member>
+void WriteSerializeInParallel(Stream &outStream, const Class *obj) {
+    for(auto &member: obj->MemberList) {
+        if (!IsStreamableList(member)) continue;
+        std::string functionName { "SerializeInParallel" + member.Name };
+        functionName[19] = static_cast<char>(std::toupper(static_cast<unsigned char>(functionName[19])));
+        outStream.Write(
+            "\t// Elements of ", member.Name, " are decoded in chunks on pool, chunk starts are taken from index.\n"
+            "\t// Only binary protocols are supported, index not matching input fails as BadValue.\n"
+            "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol, typename Pool>\n"
+            "\tvoid ", functionName, "(const rohit::Stream &stream, const rohit::serializer::ListIndex &index, Pool &pool) {\n"
+            "\t\tusing SerializerInProtocol = SerializerProtocol<rohit::serializer::SerializeType::In>;\n"
+            "\t\tSerializerInProtocol serializerProtocol { stream };\n"
+            "\t\tSerializeIn(serializerProtocol, rohit::serializer::IndexedSelector<f_", member.Name, ", Pool> { index, pool });\n"
+            "\t}\n\n");
+    }
+} // WriteSerializeInParallel
+
+void WriteSerializerInBody(Stream &outStream, const Class *obj, const Allocator allocator) {
+    WriteSerializerInBodyWithKeyInteger(outStream, obj, allocator);
+    WriteSerializerInBodyWithKeyString(outStream, obj, allocator);
+    WriteSerializerInBodyWithKeyBitmap(outStream, obj, allocator);
     outStream.Write(
         "\ttemplate <typename SerializeInProtocol>\n"
-        "\tvoid SerializeIn(SerializeInProtocol &serializerProtocol) {"
+        "\tvoid SerializeIn(SerializeInProtocol &serializerProtocol) {\n"
+        "\t\tSerializeIn(serializerProtocol, rohit::serializer::AllFields { });\n"
+        "\t}\n\n"
+        "\ttemplate <typename SerializeInProtocol, typename Selector>\n"
+        "\tvoid SerializeIn(SerializeInProtocol &serializerProtocol, [[maybe_unused]] const Selector &selector) {"
     );
     outStream.Write("\n\t\tif constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::None) {\n");
-    WriteSerializerInBodyKeyNone(outStream, obj);
+    WriteSerializerInBodyKeyNone(outStream, obj, allocator);
     outStream.Write(
         "\t\t} else if constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Integer ||\n"
-        "\t\t\t\t\t\tserializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::String) {\n"
-        "\t\t\tserializerProtocol.template StructSerializeIn<", obj->Name,">(this);\n"
+        "\t\t\t\t\t\tserializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::String ||\n"
+        "\t\t\t\t\t\tserializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::Bitmap) {\n"
+        "\t\t\tserializerProtocol.template StructSerializeIn<", obj->Name,">(this, selector);\n"
         "\t\t} else { static_assert(true, \"Unsupported serializer type\"); }\n"
         "\t}\n\n"
         "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
         "\tvoid SerializeIn(const rohit::Stream &stream) {\n"
+        "\t\tSerializeIn<SerializerProtocol>(stream, rohit::serializer::AllFields { });\n"
+        "\t}\n\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+        "\tvoid SerializeIn(const rohit::Stream &stream, const auto &selector) {\n"
         "\t\tusing SerializerInProtocol = SerializerProtocol<rohit::serializer::SerializeType::In>;\n"
         "\t\tSerializerInProtocol serializerProtocol { stream };\n"
-        "\t\tSerializeIn(serializerProtocol);\n"
-        "\t}\n\t"
+        "\t\tSerializeIn(serializerProtocol, selector);\n"
+        "\t}\n\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+        "\trohit::serializer::DecodeStatus TrySerializeIn(const rohit::Stream &stream) {\n"
+        "\t\treturn TrySerializeIn<SerializerProtocol>(stream, rohit::serializer::AllFields { });\n"
+        "\t}\n\n"
+        "\t// Bad input is reported in returned status, stream is left at failed location\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+        "\trohit::serializer::DecodeStatus TrySerializeIn(const rohit::Stream &stream, const auto &selector) {\n"
+        "\t\tusing SerializerInProtocol = typename SerializerProtocol<rohit::serializer::SerializeType::In>::template with_decode_mode<rohit::serializer::DecodeMode::NoThrow>;\n"
+        "\t\tSerializerInProtocol serializerProtocol { stream };\n"
+        "\t\tSerializeIn(serializerProtocol, selector);\n"
+        "\t\treturn serializerProtocol.GetStatus();\n"
+        "\t}\n\n"
+        "\t// Patch written by Diff is applied to this object, which must be equal to its from object\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+        "\tvoid ApplyPatch(const rohit::Stream &stream) {\n"
+        "\t\tstatic_assert(SerializerProtocol<rohit::serializer::SerializeType::In>::serialize_key_type != rohit::serializer::SerializeKeyType::None, \"Patch needs protocol with keys or bitmap\");\n"
+        "\t\tSerializeIn<SerializerProtocol>(stream, rohit::serializer::PatchFields { });\n"
+        "\t}\n\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+        "\trohit::serializer::DecodeStatus TryApplyPatch(const rohit::Stream &stream) {\n"
+        "\t\tstatic_assert(SerializerProtocol<rohit::serializer::SerializeType::In>::serialize_key_type != rohit::serializer::SerializeKeyType::None, \"Patch needs protocol with keys or bitmap\");\n"
+        "\t\treturn TrySerializeIn<SerializerProtocol>(stream, rohit::serializer::PatchFields { });\n"
+        "\t}\n\n"
     );
+    WriteStreamList(outStream, obj);
+    WriteSerializeInParallel(outStream, obj);
+}
+
+// Validation mirrors SerializeIn switches, member is only walked by its type
+void WriteValidateCall(Stream &outStream, const std::string &indent, const std::string &type) {
+    outStream.Write(indent, "serializerProtocol.template ValidateIn<", type, ">();\n");
+}
+
+void WriteValidateUnionSwitch(Stream &outStream, const Member &member, const std::string &indent) {
+    outStream.Write(indent, "switch(static_cast<e_", member.Name, ">(serializerProtocol.SerializeInVariable())) {\n");
+    for(auto &typeName: member.typeNameList) {
+        outStream.Write(indent, "\tcase e_", member.Name, "::", typeName.EnumName, ":\n");
+        WriteValidateCall(outStream, indent + "\t\t", typeName.Name);
+        outStream.Write(indent, "\t\tbreak;\n");
+    }
+    outStream.Write(
+        indent, "\tdefault:\n",
+        indent, "\t\tserializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"Bad Enum Name\");\n",
+        indent, "}\n");
+}
+
+void WriteValidateMemberFunction(Stream &outStream, const std::string &functionName, const std::string &keyType, const std::string &keyName, const std::string &switchValue) {
+    outStream.Write(
+        "\tstatic void ", functionName, "(auto &serializerProtocol, const ", keyType, " ", keyName, ") {\n"
+        "\t\tswitch(", switchValue, ") {\n");
+}
+
+void WriteValidateMemberFunctionEnd(Stream &outStream, const std::string &message) {
+    outStream.Write(
+        "\t\t\tdefault:\n"
+        "\t\t\t\tserializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"", message, "\");\n"
+        "\t\t}\n"
+        "\t}\n\n");
+}
+
+void WriteValidateBody(Stream &outStream, const Class *obj, const Allocator allocator) {
+    const auto firstPackedMember = GetFirstPackedMember(obj);
+    const auto packedBits = GetPackedBitTotal(obj);
+    const auto packedType = packedBits ? GetPackedBitsType(packedBits) : std::string { };
+
+    WriteValidateMemberFunction(outStream, "ValidateMemberByIdentifier", "uint32_t", "identifier", "identifier");
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\tcase ", parent.id, ":\n\t\t\t\t", parent.Name, "::ValidateIn(serializerProtocol);\n\t\t\t\tbreak;\n");
+    }
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member)) {
+            if (&member != firstPackedMember) continue;
+            outStream.Write("\t\t\tcase ", member.id, ":\n");
+            WriteValidateCall(outStream, "\t\t\t\t", packedType);
+        } else if (member.modifer != Member::Union) {
+            outStream.Write("\t\t\tcase ", member.id, ":\n");
+            WriteValidateCall(outStream, "\t\t\t\t", GetCPPType(member, allocator));
+        } else if (member.typeNameList.size()) {
+            outStream.Write("\t\t\tcase ", member.id, ":\n");
+            WriteValidateUnionSwitch(outStream, member, "\t\t\t\t");
+        } else continue;
+        outStream.Write("\t\t\t\tbreak;\n");
+    }
+    WriteValidateMemberFunctionEnd(outStream, "Bad Member Identifier");
+
+    WriteValidateMemberFunction(outStream, "ValidateMemberByName", "std::string_view &", "name", "rohit::Hash(name)");
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"", parent.displayName, "\"):\n\t\t\t\t", parent.Name, "::ValidateIn(serializerProtocol);\n\t\t\t\tbreak;\n");
+    }
+    if (packedBits) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"#bits\"):\n");
+        WriteValidateCall(outStream, "\t\t\t\t", packedType);
+        outStream.Write("\t\t\t\tbreak;\n");
+    }
+    for(auto &member: obj->MemberList) {
+        if (member.modifer != Member::Union && member.typeNameList[0].type == ObjectType::Enum) {
+            outStream.Write(
+                "\t\t\tcase rohit::Hash(\"", member.displayName, "\"):\n"
+                "\t\t\t\tserializerProtocol.template ValidateEnumName<", GetCPPType(member, allocator), ">();\n"
+                "\t\t\t\tbreak;\n");
+        } else if (member.modifer != Member::Union) {
+            outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, "\"):\n");
+            WriteValidateCall(outStream, "\t\t\t\t", GetCPPType(member, allocator));
+            outStream.Write("\t\t\t\tbreak;\n");
+        } else {
+            for(auto &typeName: member.typeNameList) {
+                outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, ":", typeName.EnumName, "\"):\n");
+                WriteValidateCall(outStream, "\t\t\t\t", typeName.Name);
+                outStream.Write("\t\t\t\tbreak;\n");
+            }
+        }
+    }
+    WriteValidateMemberFunctionEnd(outStream, "Bad Member Name");
+
+    WriteValidateMemberFunction(outStream, "ValidateMemberByIndex", "uint32_t", "index", "index");
+    uint32_t slot { 0 };
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\tcase ", slot++, ":\n\t\t\t\t", parent.Name, "::ValidateIn(serializerProtocol);\n\t\t\t\tbreak;\n");
+    }
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member) && &member != firstPackedMember) continue;
+        outStream.Write("\t\t\tcase ", slot++, ":\n");
+        if (&member == firstPackedMember) WriteValidateCall(outStream, "\t\t\t\t", packedType);
+        else if (member.modifer != Member::Union) WriteValidateCall(outStream, "\t\t\t\t", GetCPPType(member, allocator));
+        else WriteValidateUnionSwitch(outStream, member, "\t\t\t\t");
+        outStream.Write("\t\t\t\tbreak;\n");
+    }
+    WriteValidateMemberFunctionEnd(outStream, "Bad Member Index");
+
+    outStream.Write(
+        "\ttemplate <typename SerializeInProtocol>\n"
+        "\tstatic void ValidateIn(SerializeInProtocol &serializerProtocol) {\n"
+        "\t\tif constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::None) {\n");
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\t", parent.Name, "::ValidateIn(serializerProtocol);\n");
+    }
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member)) {
+            if (&member == firstPackedMember) WriteValidateCall(outStream, "\t\t\t", packedType);
+        } else if (member.modifer != Member::Union) {
+            WriteValidateCall(outStream, "\t\t\t", GetCPPType(member, allocator));
+        } else if (member.typeNameList.size()) {
+            WriteValidateUnionSwitch(outStream, member, "\t\t\t");
+        }
+    }
+    outStream.Write(
+        "\t\t} else serializerProtocol.template StructValidateIn<", obj->Name, ">();\n"
+        "\t}\n\n"
+        "\t// Checks that input is well formed for this class without decoding it, stream is not moved\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class SerializerProtocol>\n"
+        "\tstatic rohit::serializer::DecodeStatus Validate(const rohit::Stream &stream) {\n"
+        "\t\tusing SerializerInProtocol = typename SerializerProtocol<rohit::serializer::SerializeType::In>::template with_decode_mode<rohit::serializer::DecodeMode::NoThrow>;\n"
+        "\t\tconst auto validateStream = stream.GetSimpleConstStream();\n"
+        "\t\tSerializerInProtocol serializerProtocol { validateStream };\n"
+        "\t\tValidateIn(serializerProtocol);\n"
+        "\t\treturn serializerProtocol.GetStatus();\n"
+        "\t}\n\n");
+}
+
+// Transcoding mirrors SerializeIn switches, writer gets key of member followed by its value
+void WriteTranscodeMember(Stream &outStream, const std::string &className, const std::string &indent, const uint32_t identifier, const std::string &name, const uint32_t slot) {
+    outStream.Write(indent, "writer.template Member<", className, ">(frame, ", identifier, ", \"", name, "\", ", slot, ");\n");
+}
+
+void WriteTranscodeCall(Stream &outStream, const std::string &indent, const std::string &type) {
+    outStream.Write(indent, "serializerProtocol.template TranscodeIn<", type, ">(writer);\n");
+}
+
+void WriteTranscodeUnion(Stream &outStream, const Class *obj, const Member &member, const std::string &indent, const std::string &typeIndex, const uint32_t unionType, const uint32_t slot) {
+    outStream.Write(
+        indent, "writer.template UnionMember<", obj->Name, ">(frame, ", member.id, ", \"", member.displayName, ":", member.typeNameList[unionType].EnumName, "\", ", slot, ", ", typeIndex, ");\n");
+    WriteTranscodeCall(outStream, indent, member.typeNameList[unionType].Name);
+}
+
+void WriteTranscodeUnionSwitch(Stream &outStream, const Class *obj, const Member &member, const std::string &indent, const uint32_t slot) {
+    outStream.Write(indent, "switch(static_cast<e_", member.Name, ">(serializerProtocol.SerializeInVariable())) {\n");
+    for(uint32_t unionType { 0 }; unionType < member.typeNameList.size(); ++unionType) {
+        outStream.Write(indent, "\tcase e_", member.Name, "::", member.typeNameList[unionType].EnumName, ":\n");
+        WriteTranscodeUnion(outStream, obj, member, indent + "\t\t", std::to_string(unionType), unionType, slot);
+        outStream.Write(indent, "\t\tbreak;\n");
+    }
+    outStream.Write(
+        indent, "\tdefault:\n",
+        indent, "\t\tserializerProtocol.Fail(rohit::serializer::ErrorKind::UnknownKey, \"Bad Enum Name\");\n",
+        indent, "}\n");
+}
+
+// Packed word is written as it is or as individual members when output does not pack bits
+void WriteTranscodePackedBits(Stream &outStream, const Class *obj, const std::string &packedType, const uint32_t slot) {
+    const auto firstPackedMember = GetFirstPackedMember(obj);
+    outStream.Write(
+        "\t\t\t\t", packedType, " packedBits { };\n"
+        "\t\t\t\tserializerProtocol.template SerializeIn<", packedType, ">(packedBits);\n"
+        "\t\t\t\tif constexpr (writer.pack_bits) {\n");
+    WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t\t", firstPackedMember->id, "#bits", slot);
+    outStream.Write(
+        "\t\t\t\t\twriter.Value(packedBits);\n"
+        "\t\t\t\t} else {\n");
+    uint32_t shift { 0 };
+    for(auto &member: obj->MemberList) {
+        const auto bitCount = GetPackedBitCount(obj, member);
+        if (!bitCount) continue;
+        WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t\t", member.id, member.displayName, slot);
+        outStream.Write("\t\t\t\t\twriter.Value(static_cast<", GetCPPType(member), ">((packedBits >> ", shift, ") & ", GetBitMask(bitCount), "));\n");
+        shift += bitCount;
+    }
+    outStream.Write("\t\t\t\t}\n");
+}
+
+void WriteTranscodeMemberFunction(Stream &outStream, const std::string &functionName, const std::string &keyType, const std::string &keyName, const std::string &switchValue) {
+    outStream.Write(
+        "\tstatic void ", functionName, "(auto &serializerProtocol, auto &writer, auto &frame, const ", keyType, " ", keyName, ") {\n"
+        "\t\tswitch(", switchValue, ") {\n");
+}
+
+void WriteTranscodeBody(Stream &outStream, const Class *obj, const Allocator allocator) {
+    const auto firstPackedMember = GetFirstPackedMember(obj);
+    const auto packedBits = GetPackedBitTotal(obj);
+    const auto packedType = packedBits ? GetPackedBitsType(packedBits) : std::string { };
+
+    // Slot of each member as in bitmap, packed members share slot of first of them
+    std::vector<uint32_t> memberSlot { };
+    uint32_t slot { static_cast<uint32_t>(obj->parentlist.size()) };
+    uint32_t packedSlot { 0 };
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member) && &member != firstPackedMember) {
+            memberSlot.push_back(packedSlot);
+            continue;
+        }
+        if (&member == firstPackedMember) packedSlot = slot;
+        memberSlot.push_back(slot++);
+    }
+
+    outStream.Write(
+        "\t// Writes default value of slot missing in input, used by positional output\n"
+        "\tstatic void TranscodeDefault(auto &writer, const uint32_t index) {\n"
+        "\t\tswitch(index) {\n");
+    slot = 0;
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\tcase ", slot++, ":\n\t\t\t\twriter.Default(static_cast<const ", parent.Name, " &>(GetDefaultObject()));\n\t\t\t\tbreak;\n");
+    }
+    for(auto &member: obj->MemberList) {
+        if (GetPackedBitCount(obj, member) && &member != firstPackedMember) continue;
+        outStream.Write("\t\t\tcase ", slot++, ":\n");
+        if (&member == firstPackedMember) {
+            outStream.Write("\t\t\t\twriter.Default(GetDefaultObject().GetPackedBits());\n");
+        } else if (member.modifer != Member::Union) {
+            outStream.Write("\t\t\t\twriter.Default(GetDefaultObject().", member.Name, ");\n");
+        } else {
+            outStream.Write(
+                "\t\t\t\twriter.SerializeOutVariable(0U);\n"
+                "\t\t\t\twriter.Default(GetDefaultObject().", member.Name, ".", member.typeNameList[0].EnumName, ");\n");
+        }
+        outStream.Write("\t\t\t\tbreak;\n");
+    }
+    outStream.Write(
+        "\t\t}\n"
+        "\t}\n\n");
+
+    WriteTranscodeMemberFunction(outStream, "TranscodeMemberByIdentifier", "uint32_t", "identifier", "identifier");
+    slot = 0;
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\tcase ", parent.id, ":\n");
+        WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t", parent.id, parent.displayName, slot++);
+        outStream.Write("\t\t\t\t", parent.Name, "::TranscodeIn(serializerProtocol, writer);\n\t\t\t\tbreak;\n");
+    }
+    for(size_t index { 0 }; index < obj->MemberList.size(); ++index) {
+        auto &member = obj->MemberList[index];
+        if (GetPackedBitCount(obj, member)) {
+            if (&member != firstPackedMember) continue;
+            outStream.Write("\t\t\tcase ", member.id, ": {\n");
+            WriteTranscodePackedBits(outStream, obj, packedType, memberSlot[index]);
+            outStream.Write("\t\t\t\tbreak;\n\t\t\t}\n");
+            continue;
+        } else if (member.modifer != Member::Union) {
+            outStream.Write("\t\t\tcase ", member.id, ":\n");
+            WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t", member.id, member.displayName, memberSlot[index]);
+            WriteTranscodeCall(outStream, "\t\t\t\t", GetCPPType(member, allocator));
+        } else if (member.typeNameList.size()) {
+            outStream.Write("\t\t\tcase ", member.id, ":\n");
+            WriteTranscodeUnionSwitch(outStream, obj, member, "\t\t\t\t", memberSlot[index]);
+        } else continue;
+        outStream.Write("\t\t\t\tbreak;\n");
+    }
+    WriteValidateMemberFunctionEnd(outStream, "Bad Member Identifier");
+
+    WriteTranscodeMemberFunction(outStream, "TranscodeMemberByName", "std::string_view &", "name", "rohit::Hash(name)");
+    slot = 0;
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"", parent.displayName, "\"):\n");
+        WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t", parent.id, parent.displayName, slot++);
+        outStream.Write("\t\t\t\t", parent.Name, "::TranscodeIn(serializerProtocol, writer);\n\t\t\t\tbreak;\n");
+    }
+    if (packedBits) {
+        outStream.Write("\t\t\tcase rohit::Hash(\"#bits\"): {\n");
+        WriteTranscodePackedBits(outStream, obj, packedType, packedSlot);
+        outStream.Write("\t\t\t\tbreak;\n\t\t\t}\n");
+    }
+    uint32_t shift { 0 };
+    for(size_t index { 0 }; index < obj->MemberList.size(); ++index) {
+        auto &member = obj->MemberList[index];
+        if (const auto bitCount = GetPackedBitCount(obj, member)) {
+            // Protocols which do not pack bits have each packed member by its own name
+            outStream.Write(
+                "\t\t\tcase rohit::Hash(\"", member.displayName, "\"): {\n"
+                "\t\t\t\t", GetCPPType(member), " value { };\n"
+                "\t\t\t\tserializerProtocol.TranscodeRead(value);\n"
+                "\t\t\t\tif constexpr (writer.pack_bits) writer.template PackedMember<", obj->Name, ", ", packedType, ">(frame, ", firstPackedMember->id, ", ", packedSlot,
+                ", GetDefaultObject().GetPackedBits(), static_cast<", packedType, ">(value), ", shift, ", ", GetBitMask(bitCount), ");\n"
+                "\t\t\t\telse {\n");
+            WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t\t", member.id, member.displayName, packedSlot);
+            outStream.Write(
+                "\t\t\t\t\twriter.Value(value);\n"
+                "\t\t\t\t}\n"
+                "\t\t\t\tbreak;\n"
+                "\t\t\t}\n");
+            shift += bitCount;
+        } else if (member.modifer != Member::Union) {
+            outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, "\"):\n");
+            WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t", member.id, member.displayName, memberSlot[index]);
+            WriteTranscodeCall(outStream, "\t\t\t\t", GetCPPType(member, allocator));
+            outStream.Write("\t\t\t\tbreak;\n");
+        } else {
+            for(uint32_t unionType { 0 }; unionType < member.typeNameList.size(); ++unionType) {
+                outStream.Write("\t\t\tcase rohit::Hash(\"", member.displayName, ":", member.typeNameList[unionType].EnumName, "\"):\n");
+                WriteTranscodeUnion(outStream, obj, member, "\t\t\t\t", std::to_string(unionType), unionType, memberSlot[index]);
+                outStream.Write("\t\t\t\tbreak;\n");
+            }
+        }
+    }
+    WriteValidateMemberFunctionEnd(outStream, "Bad Member Name");
+
+    WriteTranscodeMemberFunction(outStream, "TranscodeMemberByIndex", "uint32_t", "index", "index");
+    slot = 0;
+    for(auto &parent: obj->parentlist) {
+        outStream.Write("\t\t\tcase ", slot, ":\n");
+        WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t", parent.id, parent.displayName, slot++);
+        outStream.Write("\t\t\t\t", parent.Name, "::TranscodeIn(serializerProtocol, writer);\n\t\t\t\tbreak;\n");
+    }
+    for(size_t index { 0 }; index < obj->MemberList.size(); ++index) {
+        auto &member = obj->MemberList[index];
+        if (GetPackedBitCount(obj, member) && &member != firstPackedMember) continue;
+        if (&member == firstPackedMember) {
+            outStream.Write("\t\t\tcase ", memberSlot[index], ": {\n");
+            WriteTranscodePackedBits(outStream, obj, packedType, memberSlot[index]);
+            outStream.Write("\t\t\t\tbreak;\n\t\t\t}\n");
+            continue;
+        }
+        outStream.Write("\t\t\tcase ", memberSlot[index], ":\n");
+        if (member.modifer != Member::Union) {
+            WriteTranscodeMember(outStream, obj->Name, "\t\t\t\t", member.id, member.displayName, memberSlot[index]);
+            WriteTranscodeCall(outStream, "\t\t\t\t", GetCPPType(member, allocator));
+        } else WriteTranscodeUnionSwitch(outStream, obj, member, "\t\t\t\t", memberSlot[index]);
+        outStream.Write("\t\t\t\tbreak;\n");
+    }
+    WriteValidateMemberFunctionEnd(outStream, "Bad Member Index");
+
+    outStream.Write(
+        "\ttemplate <typename SerializeInProtocol>\n"
+        "\tstatic void TranscodeIn(SerializeInProtocol &serializerProtocol, auto &writer) {\n"
+        "\t\tif constexpr (serializerProtocol.serialize_key_type == rohit::serializer::SerializeKeyType::None) {\n"
+        "\t\t\tauto frame = writer.template StructStart<", obj->Name, ">();\n"
+        "\t\t\tfor(uint32_t index { 0 }; index < serialize_slot_count; ++index) TranscodeMemberByIndex(serializerProtocol, writer, frame, index);\n"
+        "\t\t\twriter.template StructEnd<", obj->Name, ">(frame);\n"
+        "\t\t} else serializerProtocol.template StructTranscodeIn<", obj->Name, ">(writer);\n"
+        "\t}\n\n"
+        "\t// Converts input in one protocol to output in other without building object, stream is moved past input.\n"
+        "\t// Output is full stream as sizes not known in advance are patched.\n"
+        "\ttemplate <template<rohit::serializer::SerializeType> class FromProtocol, template<rohit::serializer::SerializeType> class ToProtocol>\n"
+        "\tstatic rohit::serializer::DecodeStatus Transcode(const rohit::Stream &stream, rohit::FullStream &out) {\n"
+        "\t\tusing SerializerInProtocol = typename FromProtocol<rohit::serializer::SerializeType::In>::template with_decode_mode<rohit::serializer::DecodeMode::NoThrow>;\n"
+        "\t\tSerializerInProtocol serializerProtocol { stream };\n"
+        "\t\trohit::serializer::TranscodeWriter<ToProtocol<rohit::serializer::SerializeType::Out>, SerializerInProtocol> writer { out, serializerProtocol };\n"
+        "\t\tTranscodeIn(serializerProtocol, writer);\n"
+        "\t\treturn serializerProtocol.GetStatus();\n"
+        "\t}\n\t");
 }
 
-void WriteSerializer(Stream &outStream, const Class *obj) {
+void WriteSerializer(Stream &outStream, const Class *obj, const Allocator allocator) {
     WriteSerializerOutBody(outStream, obj);
-    WriteSerializerInBody(outStream, obj);
+    WriteSerializerInBody(outStream, obj, allocator);
+    WriteValidateBody(outStream, obj, allocator);
+    WriteTranscodeBody(outStream, obj, allocator);
+}
+
+// Member that takes allocator, inline containers, unions and primitives do not
+bool IsAllocatorAware(const Member &member) {
+    switch(member.modifer) {
+    default:
+    case Member::none:
+        if (member.capacity) return false;
+        return member.typeNameList[0].Name == "string" || member.typeNameList[0].type == ObjectType::Class;
+    case Member::array:
+        return !member.capacity;
+    case Member::map:
+    case Member::hashmap:
+    case Member::flatmap:
+        return true;
+    case Member::Union:
+        return false;
+    }
+}
+
+// Allocator aware class, std::pmr containers construct their elements through these
+// constructors so that a single memory resource owns the whole object graph
+void WriteAllocatorConstructor(Stream &outStream, WriterContext &context, const Class *obj) {
+    const bool optimized = context.options.layout == MemberLayout::Optimized;
+    const auto memberOrder = context.layoutEstimator.GetMemberOrder(obj, optimized);
+    struct ConstructorSpec {
+        std::string signature;
+        std::string parentSource;
+        std::string memberPrefix;
+        std::string memberSuffix;
+        bool copyValue;
+    };
+    const std::string &name { obj->Name };
+    const ConstructorSpec constructorList[] {
+        { "explicit " + name + "(const allocator_type &allocator)", "", "GetDefaultObject().", "", false },
+        { name + "(const " + name + " &other, const allocator_type &allocator)", "other, ", "other.", "", true },
+        { name + "(" + name + " &&other, const allocator_type &allocator)", "std::move(other), ", "std::move(other.", ")", true }
+    };
+    outStream.Write(
+        "\tusing allocator_type = std::pmr::polymorphic_allocator<>;\n\n"
+        "\t", name, "() = default;\n"
+        "\t", name, "(const ", name, " &) = default;\n"
+        "\t", name, "(", name, " &&) = default;\n"
+        "\t", name, " &operator=(const ", name, " &) = default;\n"
+        "\t", name, " &operator=(", name, " &&) = default;\n");
+    for(auto &constructor: constructorList) {
+        outStream.Write('\t', constructor.signature);
+        bool first { true };
+        auto writeSeparator = [&outStream, &first]() {
+            outStream.Write(std::string_view { first ? "\n\t\t: " : ",\n\t\t" });
+            first = false;
+        };
+        for(auto &parent: obj->parentlist) {
+            writeSeparator();
+            outStream.Write(parent.Name, '(', constructor.parentSource, "allocator)");
+        }
+        for(auto memberptr: memberOrder) {
+            auto &member = *memberptr;
+            if (IsAllocatorAware(member)) {
+                writeSeparator();
+                outStream.Write(member.Name, '(', constructor.memberPrefix, member.Name, constructor.memberSuffix, ", allocator)");
+            } else if (constructor.copyValue) {
+                writeSeparator();
+                if (member.modifer == Member::Union) outStream.Write(member.Name, "_type(other.", member.Name, "_type),\n\t\t");
+                outStream.Write(member.Name, "(other.", member.Name, ')');
+            }
+        }
+        outStream.Write(" { }\n");
+    }
+    outStream.Write('\n');
 }
 
-void WriteClass(Stream &outStream, const Class *obj) {
+void WriteClass(Stream &outStream, WriterContext &context, const Class *obj) {
     if ((obj->attributes & ClassAtributes::Packed) == ClassAtributes::Packed)
         outStream.Write("class __attribute__ ((__packed__)) ", obj->Name);
     else outStream.Write("class ", obj->Name);
@@ -433,10 +1797,17 @@ void WriteClass(Stream &outStream, const Class *obj) {
     }
 
     outStream.Write(" {\n");
-    WriteMemberList(outStream, obj->MemberList);
+    WriteMemberList(outStream, context, obj);
 
-    outStream.Write('\n');
-    WriteSerializer(outStream, obj);
+    outStream.Write("\npublic:\n");
+    if (context.options.allocator == Allocator::Pmr) WriteAllocatorConstructor(outStream, context, obj);
+    WriteFieldIndex(outStream, context, obj);
+    WriteMemberDescriptor(outStream, obj, context.options.allocator);
+    WriteEqualOperator(outStream, obj);
+    if (GetPackedBitTotal(obj)) {
+        WritePackedBitsAccessor(outStream, obj);
+    }
+    WriteSerializer(outStream, obj, context.options.allocator);
 
     outStream.Write("}; // class ", obj->Name, "\n\n");
 }
@@ -453,7 +1824,7 @@ void WriteEnum(Stream &outStream, const Enum *enumptr) {
     for(auto &enumName: enumptr->enumNameList) {
         outStream.Write("\t\tcase ", enumptr->Name, "::", enumName, ": return {\"", enumName, "\"};\n");
     }
-    outStream.Write("\t\tdefault: throw std::runtime_error(\"Bad Enum Name\");\n");
+    outStream.Write("\t\tdefault: ROHIT_THROW(std::runtime_error(\"Bad Enum Name\"));\n");
     outStream.Write("\t}\n");
     outStream.Write("};\n\n");
 
@@ -462,14 +1833,24 @@ void WriteEnum(Stream &outStream, const Enum *enumptr) {
     for(auto &enumName: enumptr->enumNameList) {
         outStream.Write("\t\tcase rohit::Hash(\"", enumName, "\"): return ", enumptr->Name, "::", enumName, ";\n");
     }
-    outStream.Write("\t\tdefault: throw std::runtime_error(\"Bad Enum Name\");\n");
+    outStream.Write("\t\tdefault: ROHIT_THROW(std::runtime_error(\"Bad Enum Name\"));\n");
+    outStream.Write("\t}\n");
+    outStream.Write("};\n\n");
+
+    // Non throwing conversion, returns false for unknown name
+    outStream.Write("constexpr inline bool from_string(const auto &v, ", enumptr->Name, " &value) {\n");
+    outStream.Write("\tswitch(rohit::Hash(v)) {\n");
+    for(auto &enumName: enumptr->enumNameList) {
+        outStream.Write("\t\tcase rohit::Hash(\"", enumName, "\"): value = ", enumptr->Name, "::", enumName, "; return true;\n");
+    }
+    outStream.Write("\t\tdefault: return false;\n");
     outStream.Write("\t}\n");
     outStream.Write("};\n\n");
 }
 
-void WriteStatementList(Stream &outStream, const std::vector<std::unique_ptr<Base>> &statementlist);
+void WriteStatementList(Stream &outStream, WriterContext &context, const std::vector<std::unique_ptr<Base>> &statementlist);
 
-void WriteNamespace(Stream &outStream, const Namespace *namespaceptr) {
+void WriteNamespace(Stream &outStream, WriterContext &context, const Namespace *namespaceptr) {
     std::string completename = namespaceptr->Name;
     while (namespaceptr->statementlist.size() == 1 && namespaceptr->statementlist.back()->type == ObjectType::Namespace) {
         namespaceptr = dynamic_cast<Namespace *>(namespaceptr->statementlist.back().get());
@@ -477,22 +1858,22 @@ void WriteNamespace(Stream &outStream, const Namespace *namespaceptr) {
         completename += namespaceptr->Name;
     }
     outStream.Write("namespace ", completename, " {\n");
-    WriteStatementList(outStream, namespaceptr->statementlist);
+    WriteStatementList(outStream, context, namespaceptr->statementlist);
     outStream.Write("} // namespace ", completename,"\n\n");
 }
 
-void WriteStatementList(Stream &outStream, const std::vector<std::unique_ptr<Base>> &statementlist) {
+void WriteStatementList(Stream &outStream, WriterContext &context, const std::vector<std::unique_ptr<Base>> &statementlist) {
     if (statementlist.empty()) return;
 
     for(auto &statement: statementlist) {
         switch (statement->type)
         {
         case ObjectType::Namespace:
-            WriteNamespace(outStream, dynamic_cast<const Namespace *>(statement.get()));
+            WriteNamespace(outStream, context, dynamic_cast<const Namespace *>(statement.get()));
             break;
 
         case ObjectType::Class:
-            WriteClass(outStream, dynamic_cast<const Class *>(statement.get()));
+            WriteClass(outStream, context, dynamic_cast<const Class *>(statement.get()));
             break;
 
         case ObjectType::Enum:
@@ -506,6 +1887,11 @@ void WriteStatementList(Stream &outStream, const std::vector<std::unique_ptr<Bas
 }
 
 void Write(Stream &outStream, std::vector<std::unique_ptr<Base>> &statementlist) {
+    Write(outStream, statementlist, Options { });
+}
+
+void Write(Stream &outStream, std::vector<std::unique_ptr<Base>> &statementlist, const Options &options) {
+    WriterContext context { options, LayoutEstimator { statementlist, options.allocator } };
     outStream.Write(
         "/////////////////////////////////////////////////////////\n"
         "// This is auto genarated file using serializer. Must  //\n"
@@ -516,7 +1902,17 @@ void Write(Stream &outStream, std::vector<std::unique_ptr<Base>> &statementlist)
         "#pragma once\n"
         "#include <rohit/serializer.h>\n\n"
     );
-    WriteStatementList(outStream, statementlist);
+    WriteStatementList(outStream, context, statementlist);
+}
+
+std::vector<ClassLayoutReport> GetLayoutReport(const std::vector<std::unique_ptr<Base>> &statementlist) {
+    return GetLayoutReport(statementlist, Options { });
+}
+
+std::vector<ClassLayoutReport> GetLayoutReport(const std::vector<std::unique_ptr<Base>> &statementlist, const Options &options) {
+    std::vector<ClassLayoutReport> reportList { };
+    LayoutEstimator { statementlist, options.allocator }.GetLayoutReport(statementlist, reportList);
+    return reportList;
 }
 
 } // namespace rohit::serializer::Writer::CPP
\ No newline at end of file
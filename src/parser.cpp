@@ -86,7 +86,8 @@ auto GetMemberSpecToken(const Stream &inStream) {
 }
 
 void SkipWhiteSpaceAndComment(const Stream &inStream) {
-    for(;;) {
+    // Buffer read from file is not null terminated
+    while(!inStream.full()) {
         auto ch = *inStream;
         if (IsWhiteSpace(ch)) {
             ++inStream;
@@ -98,13 +99,13 @@ void SkipWhiteSpaceAndComment(const Stream &inStream) {
             if (ch1 == '/') {
                 // Skip till new line
                 ++inStream;
-                while(*inStream && *inStream != '\n') ++inStream;
+                while(!inStream.full() && *inStream && *inStream != '\n') ++inStream;
                 continue;
             }
             if (ch1 == '*') {
                 // Skip till */
                 ++inStream;
-                for(;;) {
+                while(!inStream.full()) {
                     const auto ch2 = *inStream;
                     if (ch2 == '*') {
                         ++inStream;
@@ -225,6 +226,12 @@ auto ParseMemberModifier(const std::string &type) {
     else if (type == "map") {
         return Member::map;
     }
+    else if (type == "hashmap") {
+        return Member::hashmap;
+    }
+    else if (type == "flatmap") {
+        return Member::flatmap;
+    }
     else if (type == "union") {
         return Member::Union;
     }
@@ -267,6 +274,28 @@ void ParseMemberTypeMap(const Stream &inStream, Namespace *declaredNameSpace, st
     typeNameList.emplace_back(std::move(typeName), declaredNameSpace);
 } // ParseMemberTypeMap
 
+void ParseMemberBits(const Stream &inStream, uint32_t &bitCount) {
+    SkipWhiteSpaceAndComment(inStream);
+    if (*inStream != '(') throw exception::BadMemberSpec { inStream, "bits must be followed by number of bits in round bracket" };
+    ++inStream;
+    SkipWhiteSpaceAndComment(inStream);
+    if (!IsNumber(inStream)) throw exception::BadMemberSpec { inStream, "bits must be followed by number of bits in round bracket" };
+    bitCount = ParseNumber<uint32_t>(inStream);
+    if (bitCount == 0 || bitCount > 64) throw exception::BadMemberSpec { inStream, "bits must be between 1 and 64" };
+    SkipWhiteSpaceAndComment(inStream);
+    CheckAndIncrease(inStream, ')');
+} // ParseMemberBits
+
+void ParseMemberCapacity(const Stream &inStream, uint32_t &capacity) {
+    ++inStream;
+    SkipWhiteSpaceAndComment(inStream);
+    if (!IsNumber(inStream)) throw exception::BadMemberSpec { inStream, "Capacity must be a number in square bracket" };
+    capacity = ParseNumber<uint32_t>(inStream);
+    if (capacity == 0 || capacity > UINT16_MAX) throw exception::BadMemberSpec { inStream, "Capacity must be between 1 and 65535" };
+    SkipWhiteSpaceAndComment(inStream);
+    CheckAndIncrease(inStream, ']');
+} // ParseMemberCapacity
+
 void ParseNameSpec(const Stream &inStream, uint32_t &newId, std::string &displayName) {
     CheckAndIncrease(inStream, '(');
     bool stringParsed { false };
@@ -306,17 +335,36 @@ Member ParseMember(const Stream &inStream, const uint32_t id, Namespace *declare
     auto accesstype = ParseAccessType(inStream);
     SkipWhiteSpaceAndComment(inStream);
     auto nextid = ParseHierarchicalIdentifier(inStream);
+    uint32_t bitCount { };
+    if (nextid == "bits") {
+        ParseMemberBits(inStream, bitCount);
+        SkipWhiteSpaceAndComment(inStream);
+        nextid = ParseHierarchicalIdentifier(inStream);
+    }
     std::vector<std::string> enumNameList { };
     std::vector<TypeName> typeNameList { };
     auto membermodifier = ParseMemberModifier(nextid);
+    if (bitCount && membermodifier != Member::none) {
+        throw exception::BadMemberSpec { inStream, "bits is not allowed with array, map or union" };
+    }
     std::string key { };
+    uint32_t capacity { };
     if (membermodifier == Member::none) {
+        if (nextid == "string" && *inStream == '[') {
+            if (bitCount) throw exception::BadMemberSpec { inStream, "bits is not allowed with string[N]" };
+            ParseMemberCapacity(inStream, capacity);
+        }
         typeNameList.emplace_back(std::move(nextid), declaredNameSpace);
     } else if (membermodifier == Member::array) {
         SkipWhiteSpaceAndComment(inStream);
+        if (*inStream == '[') {
+            ParseMemberCapacity(inStream, capacity);
+            SkipWhiteSpaceAndComment(inStream);
+        }
         auto typeName = ParseHierarchicalIdentifier(inStream);
+        if (*inStream == '[') throw exception::BadMemberSpec { inStream, "Capacity is not allowed on array element" };
         typeNameList.emplace_back(std::move(typeName), declaredNameSpace);
-    } else if(membermodifier == Member::map) {
+    } else if(membermodifier == Member::map || membermodifier == Member::hashmap || membermodifier == Member::flatmap) {
         ParseMemberTypeMap(inStream, declaredNameSpace, typeNameList, key);
     } else if (membermodifier == Member::Union) {
         ParseMemberTypeUnion(inStream, declaredNameSpace, typeNameList);
@@ -348,7 +396,7 @@ Member ParseMember(const Stream &inStream, const uint32_t id, Namespace *declare
     }
     SkipWhiteSpaceAndComment(inStream);
     CheckAndIncrease(inStream, ';');
-    return { accesstype, membermodifier, typeNameList, name, displayName, newId, key, defaultValue };
+    return { accesstype, membermodifier, typeNameList, name, displayName, newId, key, defaultValue, bitCount, capacity };
 } // ParseMember
 
 ObjectType ParseObjectType(const Stream &inStream) {
@@ -414,6 +462,8 @@ std::unique_ptr<Class> ParseClassHeader(const Stream &inStream, Namespace *Curre
     auto attributes { ClassAtributes::None };
     SpaceSeparatedIdentifier(inStream, [&attributes](std::string &&value) { 
         if (value == "packed") attributes |= ClassAtributes::Packed;
+        else if (value == "bitpacked") attributes |= ClassAtributes::BitPacked;
+        else if (value == "bitfield") attributes |= ClassAtributes::BitField;
     });
     std::vector<Parent> parentlist;
     // At this point all whitespace is skipped
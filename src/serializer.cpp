@@ -20,7 +20,7 @@
 #include <fstream>
 
 void DisplayHelp(const std::string &err) {
-    std::cout << "Usage: Serializer input <input filename> output <output filename>" << std::endl;
+    std::cout << "Usage: Serializer input <input filename> output <output filename> [layout <declared|optimized>] [allocator <std|pmr>]" << std::endl;
     if (!err.empty()) {
         std::cout << "Error: " << err << std::endl;
     }
@@ -39,6 +39,8 @@ int main(const int argc, const char *argv[]) {
     const std::vector<std::string> args {argv, argv + argc};
     std::filesystem::path input_file { };
     std::filesystem::path output_file { };
+    rohit::serializer::Writer::CPP::Options options { };
+    bool layoutReport { false };
     for(size_t argi { 0 }; argi < args.size(); ++argi) {
         if (args[argi] == "input") {
             ++argi;
@@ -60,6 +62,31 @@ int main(const int argc, const char *argv[]) {
             }
             output_file = std::filesystem::path { args[argi] };
             std::cout << "Output File: " << output_file << std::endl;
+        } else if (args[argi] == "layout") {
+            ++argi;
+            if (argi >= args.size()) {
+                DisplayHelp("Insufficient arguments");
+                return 0;
+            }
+            if (args[argi] == "optimized") options.layout = rohit::serializer::Writer::CPP::MemberLayout::Optimized;
+            else if (args[argi] == "declared") options.layout = rohit::serializer::Writer::CPP::MemberLayout::Declared;
+            else {
+                DisplayHelp("layout must be declared or optimized");
+                return 0;
+            }
+            layoutReport = true;
+        } else if (args[argi] == "allocator") {
+            ++argi;
+            if (argi >= args.size()) {
+                DisplayHelp("Insufficient arguments");
+                return 0;
+            }
+            if (args[argi] == "pmr") options.allocator = rohit::serializer::Writer::CPP::Allocator::Pmr;
+            else if (args[argi] == "std") options.allocator = rohit::serializer::Writer::CPP::Allocator::Standard;
+            else {
+                DisplayHelp("allocator must be std or pmr");
+                return 0;
+            }
         }
     }
 
@@ -79,8 +106,15 @@ int main(const int argc, const char *argv[]) {
 
     try {
         auto statementlist = rohit::serializer::Parser::Parse(inStream);
-        rohit::serializer::Writer::CPP::Write(outStream, statementlist);
+        rohit::serializer::Writer::CPP::Write(outStream, statementlist, options);
         outStream.WriteToFileTillOffset(output_file);
+        if (layoutReport) {
+            std::cout << "Layout report, size and padding in bytes estimated for this host (declared -> optimized):" << std::endl;
+            for(auto &report: rohit::serializer::Writer::CPP::GetLayoutReport(statementlist, options)) {
+                std::cout << "  " << report.name << ": size " << report.sizeDeclared << " -> " << report.sizeOptimized
+                    << ", padding " << report.paddingDeclared << " -> " << report.paddingOptimized << std::endl;
+            }
+        }
     } catch(const std::exception &e) {
         std::cout << "Failed to parse with error:\n" << e.what() << std::endl;
     }
@@ -0,0 +1,303 @@
+//////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2024  Rohit Jairaj Singh (rohit@singh.org.in)          //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program.  If not, see <https://www.gnu.org/licenses/ //
+//////////////////////////////////////////////////////////////////////////
+
+#include <rohit/serializerruntime.h>
+#include <charconv>
+#include <unordered_map>
+#include <algorithm>
+
+namespace rohit::serializer::Runtime {
+
+namespace {
+// Identifiers upto this are looked up in a table, larger ones by binary search
+constexpr uint32_t max_identifier_table { 4096 };
+
+struct Resolver {
+    std::unordered_map<std::string, uint32_t> classMap { };
+    std::unordered_map<std::string, uint32_t> enumMap { };
+    std::vector<const Class *> classList { };
+
+    void Collect(const std::vector<std::unique_ptr<Base>> &statementlist, std::vector<EnumPlan> &enums) {
+        for(auto &statement: statementlist) {
+            if (statement->type == ObjectType::Namespace) {
+                Collect(dynamic_cast<const Namespace *>(statement.get())->statementlist, enums);
+            } else if (statement->type == ObjectType::Class) {
+                classMap.emplace(statement->GetFullName(), static_cast<uint32_t>(classList.size()));
+                classList.push_back(dynamic_cast<const Class *>(statement.get()));
+            } else if (statement->type == ObjectType::Enum) {
+                auto enumptr = dynamic_cast<const Enum *>(statement.get());
+                enumMap.emplace(statement->GetFullName(), static_cast<uint32_t>(enums.size()));
+                enums.push_back({ statement->GetFullName(), enumptr->enumNameList });
+            }
+        }
+    }
+
+    // Parent is searched from namespace of class to the outermost one
+    uint32_t FindParent(const Class *obj, const std::string &name) const {
+        for(auto nameSpace = obj->parentNamespace; nameSpace; nameSpace = nameSpace->parentNamespace) {
+            auto itr = classMap.find(nameSpace->GetFullName() + "::" + name);
+            if (itr != std::end(classMap)) return itr->second;
+        }
+        auto itr = classMap.find(name);
+        if (itr != std::end(classMap)) return itr->second;
+        throw std::invalid_argument { "Parent " + name + " of class " + obj->GetFullName() + " not found" };
+    }
+
+    static OpCode GetPrimitiveCode(const std::string &name) {
+        static const std::unordered_map<std::string, OpCode> primitiveMap {
+            {"bool", OpCode::Bool},
+            {"char", OpCode::Char},
+            {"int8", OpCode::Int8},
+            {"int16", OpCode::Int16},
+            {"int32", OpCode::Int32},
+            {"int64", OpCode::Int64},
+            {"uint8", OpCode::UInt8},
+            {"uint16", OpCode::UInt16},
+            {"uint32", OpCode::UInt32},
+            {"uint64", OpCode::UInt64},
+            {"float", OpCode::Float},
+            {"double", OpCode::Double},
+            {"string", OpCode::String}
+        };
+        auto itr = primitiveMap.find(name);
+        if (itr == std::end(primitiveMap)) throw std::invalid_argument { "Unknown type: " + name };
+        return itr->second;
+    }
+
+    Alternative GetType(const TypeName &typeName) const {
+        switch(typeName.type) {
+        case ObjectType::Primitive:
+            return { GetPrimitiveCode(typeName.Name), 0 };
+        case ObjectType::Enum: {
+            auto itr = enumMap.find(typeName.GetFullName());
+            if (itr != std::end(enumMap)) return { OpCode::Enum, itr->second };
+            break;
+        }
+        case ObjectType::Class: {
+            auto itr = classMap.find(typeName.GetFullName());
+            if (itr != std::end(classMap)) return { OpCode::Object, itr->second };
+            break;
+        }
+        default:
+            break;
+        }
+        throw std::invalid_argument { "Unresolved type: " + typeName.Name };
+    }
+};
+
+std::string_view TrimSuffix(std::string_view text, const std::string_view suffixCharacters) {
+    while(!text.empty() && suffixCharacters.find(text.back()) != std::string_view::npos) text.remove_suffix(1);
+    return text;
+}
+
+// Default value is C++ literal as written in .def
+DynamicValue ParseDefault(const std::vector<EnumPlan> &enums, const Op &op, const std::string &defaultText) {
+    DynamicValue value { };
+    if (defaultText.empty()) return value;
+    std::string_view text { defaultText };
+    bool parsed { false };
+    if (op.code == OpCode::String) {
+        if (text.size() >= 2 && text.front() == '"' && text.back() == '"') text = text.substr(1, text.size() - 2);
+        value.text = text;
+        parsed = op.capacity == 0 || text.size() <= op.capacity;
+    } else if (op.code == OpCode::Bool) {
+        parsed = text == "true" || text == "false";
+        value.Set(text == "true");
+    } else if (op.code == OpCode::Char) {
+        parsed = text.size() == 3 && text.front() == '\'' && text.back() == '\'';
+        if (parsed) value.Set(text[1]);
+    } else if (op.code == OpCode::Enum) {
+        const auto separator = text.rfind("::");
+        if (separator != std::string_view::npos) text = text.substr(separator + 2);
+        const auto index = enums[op.type].Find(text);
+        parsed = index != ClassPlan::none;
+        value.scalar = index;
+    } else if (op.code != OpCode::Object) {
+        VisitPrimitive(op.code, [&text, &value, &parsed](auto type) {
+            using T = typename decltype(type)::type;
+            T primitive { };
+            std::from_chars_result result { };
+            if constexpr (std::floating_point<T>) {
+                text = TrimSuffix(text, "fFlL");
+                result = std::from_chars(text.data(), text.data() + text.size(), primitive);
+            } else if constexpr (!std::is_same_v<T, bool> && !std::is_same_v<T, char>) {
+                text = TrimSuffix(text, "uUlL");
+                int base { 10 };
+                if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+                    text.remove_prefix(2);
+                    base = 16;
+                }
+                result = std::from_chars(text.data(), text.data() + text.size(), primitive, base);
+            }
+            parsed = result.ec == std::errc { } && result.ptr == text.data() + text.size();
+            value.Set(primitive);
+        });
+    }
+    if (!parsed) throw std::invalid_argument { "Default value " + defaultText + " is not supported by runtime schema" };
+    return value;
+}
+
+void CompileClass(const Resolver &resolver, const std::vector<EnumPlan> &enums, const Class *obj, ClassPlan &plan) {
+    plan.name = obj->GetFullName();
+    std::vector<std::string> defaultTexts { };
+    for(auto &parent: obj->parentlist) {
+        Op op { };
+        op.shape = OpShape::Parent;
+        op.code = OpCode::Object;
+        op.id = parent.id;
+        op.type = resolver.FindParent(obj, parent.Name);
+        op.key = static_cast<uint32_t>(plan.keys.size());
+        plan.keys.push_back({ rohit::Hash(parent.displayName), parent.displayName, static_cast<uint32_t>(plan.ops.size()), 0 });
+        plan.ops.push_back(op);
+        plan.memberNames.push_back(parent.Name);
+        defaultTexts.emplace_back();
+    }
+
+    uint32_t packedBits { 0 };
+    for(auto &member: obj->MemberList) {
+        Op op { };
+        op.id = member.id;
+        op.key = static_cast<uint32_t>(plan.keys.size());
+        const auto opIndex = static_cast<uint32_t>(plan.ops.size());
+        if (member.modifer == Member::Union) {
+            op.shape = OpShape::Union;
+            op.type = static_cast<uint32_t>(plan.alternatives.size());
+            op.alternativeCount = static_cast<uint16_t>(member.typeNameList.size());
+            for(uint32_t index { 0 }; index < member.typeNameList.size(); ++index) {
+                auto &typeName = member.typeNameList[index];
+                plan.alternatives.push_back(resolver.GetType(typeName));
+                const auto keyName = member.displayName + ":" + typeName.EnumName;
+                plan.keys.push_back({ rohit::Hash(keyName), keyName, opIndex, index });
+            }
+        } else {
+            const auto type = resolver.GetType(member.typeNameList[0]);
+            op.code = type.code;
+            op.type = type.type;
+            op.capacity = static_cast<uint16_t>(member.capacity);
+            if (member.modifer == Member::array) op.shape = OpShape::List;
+            else if (member.modifer == Member::map || member.modifer == Member::hashmap || member.modifer == Member::flatmap) {
+                op.shape = OpShape::Map;
+                op.keyCode = Resolver::GetPrimitiveCode(member.Key);
+            } else if (const auto bitCount = Writer::CPP::GetPackedBitCount(obj, member)) {
+                op.shape = OpShape::Packed;
+                op.shift = static_cast<uint8_t>(packedBits);
+                op.bitCount = static_cast<uint8_t>(bitCount);
+                packedBits += bitCount;
+                if (packedBits > 64) throw std::invalid_argument { "Packed members of class " + obj->Name + " require more than 64 bits" };
+                if (plan.packedOp == ClassPlan::none) plan.packedOp = opIndex;
+            }
+            plan.keys.push_back({ rohit::Hash(member.displayName), member.displayName, opIndex, 0 });
+        }
+        plan.ops.push_back(op);
+        plan.memberNames.push_back(member.Name);
+        defaultTexts.push_back(member.defaultValue);
+    }
+
+    if (plan.packedOp != ClassPlan::none) {
+        plan.packedSize = packedBits <= 8 ? 1 : packedBits <= 16 ? 2 : packedBits <= 32 ? 4 : 8;
+        plan.keys.push_back({ rohit::Hash("#bits"), "#bits", plan.packedOp, ClassPlan::packed_word });
+    }
+
+    for(uint32_t keyIndex { 0 }; keyIndex < plan.keys.size(); ++keyIndex) plan.keyHashes.emplace_back(plan.keys[keyIndex].hash, keyIndex);
+    std::sort(plan.keyHashes.begin(), plan.keyHashes.end());
+
+    // Packed members after first one share its slot and identifier
+    uint32_t maxIdentifier { 0 };
+    for(uint32_t opIndex { 0 }; opIndex < plan.ops.size(); ++opIndex) {
+        auto &op = plan.ops[opIndex];
+        if (op.shape == OpShape::Packed && opIndex != plan.packedOp) {
+            op.slot = plan.ops[plan.packedOp].slot;
+            continue;
+        }
+        op.slot = static_cast<uint32_t>(plan.slots.size());
+        plan.slots.push_back(opIndex);
+        plan.identifierList.emplace_back(op.id, opIndex);
+        maxIdentifier = std::max(maxIdentifier, op.id);
+    }
+    std::sort(plan.identifierList.begin(), plan.identifierList.end());
+    if (maxIdentifier <= max_identifier_table) {
+        plan.identifiers.assign(maxIdentifier + 1, ClassPlan::none);
+        for(auto [identifier, opIndex]: plan.identifierList) plan.identifiers[identifier] = opIndex;
+        plan.identifierList.clear();
+    }
+
+    // Nested objects are filled in once all classes are compiled
+    plan.defaultObject.items.resize(plan.ops.size());
+    for(uint32_t opIndex { 0 }; opIndex < plan.ops.size(); ++opIndex) {
+        auto &op = plan.ops[opIndex];
+        if (op.shape == OpShape::Value || op.shape == OpShape::Packed) {
+            plan.defaultObject.items[opIndex] = ParseDefault(enums, op, defaultTexts[opIndex]);
+        } else if (!defaultTexts[opIndex].empty()) {
+            throw std::invalid_argument { "Default value of member " + plan.name + "::" + plan.memberNames[opIndex] + " is not supported by runtime schema" };
+        }
+    }
+}
+
+enum class BuildState : uint8_t {
+    None,
+    Building,
+    Built
+};
+
+void BuildDefault(std::vector<ClassPlan> &classes, const uint32_t classIndex, std::vector<BuildState> &state) {
+    if (state[classIndex] == BuildState::Built) return;
+    if (state[classIndex] == BuildState::Building) throw std::invalid_argument { "Class " + classes[classIndex].name + " contains itself" };
+    state[classIndex] = BuildState::Building;
+    auto &plan = classes[classIndex];
+    for(uint32_t opIndex { 0 }; opIndex < plan.ops.size(); ++opIndex) {
+        const auto op = plan.ops[opIndex];
+        Alternative type { op.code, op.type };
+        if (op.shape == OpShape::Union) {
+            type = plan.alternatives[op.type];
+            plan.defaultObject.items[opIndex].items.resize(1);
+        } else if (op.shape == OpShape::List || op.shape == OpShape::Map) continue;
+        if (type.code != OpCode::Object) continue;
+        BuildDefault(classes, type.type, state);
+        auto &value = classes[classIndex].defaultObject.items[opIndex];
+        (op.shape == OpShape::Union ? value.items[0] : value) = classes[type.type].defaultObject;
+    }
+    plan.packedDefault = plan.GetPackedWord(plan.defaultObject);
+    state[classIndex] = BuildState::Built;
+}
+} // namespace
+
+Schema::Schema(const std::vector<std::unique_ptr<Base>> &statementlist) {
+    Resolver resolver { };
+    resolver.Collect(statementlist, enums);
+    classes.resize(resolver.classList.size());
+    for(uint32_t classIndex { 0 }; classIndex < classes.size(); ++classIndex) {
+        CompileClass(resolver, enums, resolver.classList[classIndex], classes[classIndex]);
+    }
+    std::vector<BuildState> state(classes.size(), BuildState::None);
+    for(uint32_t classIndex { 0 }; classIndex < classes.size(); ++classIndex) BuildDefault(classes, classIndex, state);
+}
+
+uint32_t Schema::FindClass(const std::string_view fullName) const {
+    for(uint32_t classIndex { 0 }; classIndex < classes.size(); ++classIndex) {
+        if (classes[classIndex].name == fullName) return classIndex;
+    }
+    throw std::invalid_argument { "Class " + std::string { fullName } + " not found" };
+}
+
+uint32_t Schema::FindMember(const uint32_t classIndex, const std::string_view memberName) const {
+    auto &memberNames = classes[classIndex].memberNames;
+    auto itr = std::find(memberNames.begin(), memberNames.end(), memberName);
+    if (itr == memberNames.end()) throw std::invalid_argument { "Member " + std::string { memberName } + " not found in " + classes[classIndex].name };
+    return static_cast<uint32_t>(itr - memberNames.begin());
+}
+
+} // namespace rohit::serializer::Runtime
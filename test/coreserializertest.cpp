@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 #include <rohit/serializer.h>
+#include <rohit/checksum.h>
+#include <rohit/compression.h>
+#include <random>
 #include <vector>
 
 TEST(JSONSerializer, Char) {
@@ -508,4 +511,93 @@ TEST(BinarySerializer, String) {
 int main(int argc, char *argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
+
+TEST(Checksum, Crc32c) {
+    const std::string_view check { "123456789" };
+    const auto data = reinterpret_cast<const uint8_t *>(check.data());
+    EXPECT_EQ(rohit::Crc32c(data, check.size()), 0xe3069283U);
+    EXPECT_EQ(rohit::Crc32cTable(data, check.size()), 0xe3069283U);
+    EXPECT_EQ(rohit::Crc32c(data, 0), 0U);
+    static constexpr uint8_t constant[] { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    static_assert(rohit::Crc32c(constant, sizeof(constant)) == 0xe3069283U);
+
+    // Instruction and table agree for every length and alignment, crc continues over parts
+    std::vector<uint8_t> buffer(300);
+    for(size_t index { 0 }; index < buffer.size(); ++index) buffer[index] = static_cast<uint8_t>(index * 131 + 7);
+    for(size_t offset { 0 }; offset < 8; ++offset) {
+        for(size_t size { 0 }; size + offset <= buffer.size(); size += 13) {
+            const auto crc = rohit::Crc32c(buffer.data() + offset, size);
+            EXPECT_EQ(crc, rohit::Crc32cTable(buffer.data() + offset, size));
+            const size_t half { size / 2 };
+            EXPECT_EQ(crc, rohit::Crc32c(buffer.data() + offset + half, size - half, rohit::Crc32c(buffer.data() + offset, half)));
+        }
+    }
+}
+
+TEST(Checksum, Stream) {
+    rohit::ChecksumOutStream outStream { 16 };
+    rohit::serializer::binary_integer<rohit::serializer::SerializeType::Out> serializerOut { outStream };
+    std::vector<std::string> messages { "first message", std::string(1000, 'x'), "" };
+    for(auto &message: messages) {
+        const size_t start { outStream.CurrentOffset() };
+        serializerOut.SerializeOut(message);
+        EXPECT_EQ(outStream.Checksum(), rohit::Crc32c(outStream.begin() + start, outStream.CurrentOffset() - start));
+        outStream.AppendChecksum();
+    }
+
+    const rohit::ChecksumInStream inStream { outStream.begin(), outStream.CurrentOffset() };
+    rohit::serializer::binary_integer<rohit::serializer::SerializeType::In> serializerIn { inStream };
+    for(auto &message: messages) {
+        std::string decoded { };
+        serializerIn.SerializeIn(decoded);
+        EXPECT_EQ(decoded, message);
+        EXPECT_TRUE(inStream.VerifyChecksum());
+    }
+    EXPECT_TRUE(inStream.full());
+
+    // Corrupted byte fails checksum
+    std::vector<uint8_t> corrupted(outStream.begin(), outStream.begin() + outStream.CurrentOffset());
+    corrupted[3] ^= 0x20;
+    const rohit::ChecksumInStream corruptedStream { corrupted.data(), corrupted.size() };
+    rohit::serializer::binary_integer<rohit::serializer::SerializeType::In> corruptedIn { corruptedStream };
+    std::string decoded { };
+    corruptedIn.SerializeIn(decoded);
+    EXPECT_FALSE(corruptedStream.VerifyChecksum());
+}
+
+TEST(Compression, Block) {
+    std::mt19937 random { 7 };
+    std::vector<std::vector<uint8_t>> inputs { { }, { 1 }, { 1, 2, 3 }, std::vector<uint8_t>(rohit::lz::block_size, 'a') };
+    std::vector<uint8_t> text { };
+    while(text.size() < rohit::lz::block_size) {
+        const std::string word { "word" + std::to_string(random() % 50) + " " };
+        text.insert(text.end(), word.begin(), word.end());
+    }
+    text.resize(rohit::lz::block_size);
+    inputs.push_back(text);
+    std::vector<uint8_t> noise(rohit::lz::block_size);
+    for(auto &byte: noise) byte = static_cast<uint8_t>(random());
+    inputs.push_back(noise);
+
+    for(auto &input: inputs) {
+        std::vector<uint8_t> compressed(rohit::lz::MaxCompressedSize(input.size()));
+        const size_t size { rohit::lz::Compress(input.data(), input.size(), compressed.data()) };
+        EXPECT_LE(size, compressed.size());
+        std::vector<uint8_t> output(input.size());
+        EXPECT_TRUE(rohit::lz::Decompress(compressed.data(), size, output.data(), output.size()));
+        EXPECT_EQ(output, input);
+        // Wrong size and truncated input fail without writing outside output
+        if (!input.empty()) {
+            EXPECT_FALSE(rohit::lz::Decompress(compressed.data(), size, output.data(), output.size() - 1));
+            EXPECT_FALSE(rohit::lz::Decompress(compressed.data(), size - 1, output.data(), output.size()));
+        }
+    }
+    std::vector<uint8_t> compressed(rohit::lz::MaxCompressedSize(text.size()));
+    EXPECT_LT(rohit::lz::Compress(text.data(), text.size(), compressed.data()), text.size() / 2);
+
+    // Match before begin of output
+    const uint8_t badOffset[] { 0x10, 'a', 0x05, 0x00 };
+    uint8_t output[8];
+    EXPECT_FALSE(rohit::lz::Decompress(badOffset, sizeof(badOffset), output, sizeof(output)));
+}
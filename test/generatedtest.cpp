@@ -23,6 +23,19 @@
 #include <map.h>
 #include <string>
 #include <enum.h>
+#include <bits.h>
+#include <layout.h>
+#include <inline.h>
+#include <pmr.h>
+#include <rohit/serializercreator.h>
+#include <rohit/serializerruntime.h>
+#include <rohit/parallel.h>
+#include <rohit/recordstream.h>
+#include <rohit/recordfile.h>
+#include <rohit/checksum.h>
+#include <rohit/compression.h>
+#include <rohit/delta.h>
+#include <rohit/msgpack.h>
 
 TEST(GeneratedTest, SerializeIn) {
     const std::string personstr {"{\"fullname\":\"Rohit Jairaj Singh\",\"ID\":322}"};
@@ -93,6 +106,161 @@ TEST(GeneratedTest, SerializeOut) {
     EXPECT_TRUE(personex.account == personexBinaryString.account);
 }
 
+TEST(GeneratedTest, SerializeSparse) {
+    test::test1::person person { };
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    person.SerializeOut<rohit::serializer::json_sparse>(fullstream);
+    std::string result_person {reinterpret_cast<char *>(fullstream.begin()), fullstream.CurrentOffset()};
+    EXPECT_EQ(result_person, "{}");
+    auto emptystream = rohit::MakeConstantFullStream(result_person);
+    test::test1::person personEmpty { };
+    personEmpty.SerializeIn<rohit::serializer::json_sparse>(emptystream);
+    EXPECT_EQ(personEmpty.name, "None");
+
+    test::test1::personex personex { "None", 322, 1 };
+    fullstream.Reset();
+    personex.SerializeOut<rohit::serializer::json_sparse>(fullstream);
+    std::string result_personex {reinterpret_cast<char *>(fullstream.begin()), fullstream.CurrentOffset()};
+    EXPECT_EQ(result_personex, "{\"person\":{\"ID\":322}}");
+
+    auto fullstream1 = rohit::MakeConstantFullStream(result_personex);
+    test::test1::personex personexJson { };
+    personexJson.SerializeIn<rohit::serializer::json_sparse>(fullstream1);
+    EXPECT_EQ(personexJson.name, "None");
+    EXPECT_EQ(personexJson.ID, 322);
+    EXPECT_EQ(personexJson.account, 1);
+
+    // parent key, ID key with value, end of parent and end of object
+    fullstream.Reset();
+    personex.SerializeOut<rohit::serializer::binary_integer_sparse>(fullstream);
+    EXPECT_EQ(fullstream.CurrentOffset(), 1 + 1 + sizeof(uint64_t) + 1 + 1);
+    test::test1::personex personexBinaryInteger { };
+    fullstream.Reset();
+    personexBinaryInteger.SerializeIn<rohit::serializer::binary_integer_sparse>(fullstream);
+    EXPECT_EQ(personexBinaryInteger.name, "None");
+    EXPECT_EQ(personexBinaryInteger.ID, 322);
+    EXPECT_EQ(personexBinaryInteger.account, 1);
+
+    personex.account = 122;
+    fullstream.Reset();
+    personex.SerializeOut<rohit::serializer::binary_string_sparse>(fullstream);
+    test::test1::personex personexBinaryString { };
+    fullstream.Reset();
+    personexBinaryString.SerializeIn<rohit::serializer::binary_string_sparse>(fullstream);
+    EXPECT_EQ(personexBinaryString.name, "None");
+    EXPECT_EQ(personexBinaryString.ID, 322);
+    EXPECT_EQ(personexBinaryString.account, 122);
+
+    // bitmap of person and personex with ID value
+    fullstream.Reset();
+    personex.SerializeOut<rohit::serializer::binary_bitmap>(fullstream);
+    EXPECT_EQ(fullstream.CurrentOffset(), 1 + 1 + sizeof(uint64_t) + sizeof(uint64_t));
+    test::test1::personex personexBinaryBitmap { };
+    fullstream.Reset();
+    personexBinaryBitmap.SerializeIn<rohit::serializer::binary_bitmap>(fullstream);
+    EXPECT_EQ(personexBinaryBitmap.name, "None");
+    EXPECT_EQ(personexBinaryBitmap.ID, 322);
+    EXPECT_EQ(personexBinaryBitmap.account, 122);
+
+    // bit for absent member is rejected
+    const uint8_t badbitmap[] { 0x04 };
+    auto badstream = rohit::MakeConstantFullStream(std::begin(badbitmap), std::end(badbitmap));
+    test::test1::person personBad { };
+    EXPECT_THROW(personBad.SerializeIn<rohit::serializer::binary_bitmap>(badstream), rohit::serializer::exception::KeyNotFound);
+
+    bitstest::flags flags1 { };
+    flags1.count = 5;
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_integer_sparse>(fullstream);
+    EXPECT_EQ(fullstream.CurrentOffset(), 1 + sizeof(uint32_t) + 1);
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestProjection(const arraytest::session &session) {
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    session.SerializeOut<SerializerProtocol>(fullstream);
+    fullstream.Reset();
+    arraytest::session sessionId { };
+    sessionId.SerializeIn<SerializerProtocol>(fullstream, rohit::serializer::FieldSet<arraytest::session::f_id> { });
+    EXPECT_TRUE(sessionId.name.empty());
+    EXPECT_EQ(sessionId.id, session.id);
+    EXPECT_TRUE(sessionId.persons.list.empty());
+
+    fullstream.Reset();
+    arraytest::session sessionName { };
+    sessionName.SerializeIn<SerializerProtocol>(fullstream, rohit::serializer::FieldMask<arraytest::session> { arraytest::session::f_name });
+    EXPECT_EQ(sessionName.name, session.name);
+    EXPECT_EQ(sessionName.id, 0);
+    EXPECT_EQ(sessionName.persons.listid, 0);
+
+    // Nested object is decoded completely
+    fullstream.Reset();
+    arraytest::session sessionPersons { };
+    sessionPersons.SerializeIn<SerializerProtocol>(fullstream, rohit::serializer::FieldSet<arraytest::session::f_persons> { });
+    EXPECT_TRUE(sessionPersons.name.empty());
+    EXPECT_EQ(sessionPersons.persons.listid, session.persons.listid);
+    EXPECT_EQ(sessionPersons.persons.list.size(), session.persons.list.size());
+    EXPECT_EQ(sessionPersons.persons.reverseListMap, session.persons.reverseListMap);
+}
+
+// Field of parent is selected through derived class, packed members are selected one by one
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestParentProjection() {
+    const test::test1::personex personex { { "Rohit Jairaj Singh", 322 }, 7 };
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    personex.SerializeOut<SerializerProtocol>(fullstream);
+    fullstream.Reset();
+    test::test1::personex personexName { };
+    personexName.SerializeIn<SerializerProtocol>(fullstream, rohit::serializer::FieldMask<test::test1::personex> { test::test1::personex::f_name });
+    EXPECT_EQ(personexName.name, personex.name);
+    EXPECT_EQ(personexName.ID, 0);
+    EXPECT_EQ(personexName.account, 1);
+
+    fullstream.Reset();
+    test::test1::personex personexAccount { };
+    personexAccount.SerializeIn<SerializerProtocol>(fullstream, rohit::serializer::FieldSet<test::test1::personex::f_account, test::test1::personex::f_ID> { });
+    EXPECT_EQ(personexAccount.name, "None");
+    EXPECT_EQ(personexAccount.ID, 322);
+    EXPECT_EQ(personexAccount.account, 7);
+
+    bitstest::flags flags { "packed", true, bitstest::mode::turbo, 1024, true, 9 };
+    fullstream.Reset();
+    flags.SerializeOut<SerializerProtocol>(fullstream);
+    fullstream.Reset();
+    bitstest::flags flagsSpeed { };
+    flagsSpeed.SerializeIn<SerializerProtocol>(fullstream, rohit::serializer::FieldSet<bitstest::flags::f_speed> { });
+    EXPECT_TRUE(flagsSpeed.speed == bitstest::mode::turbo);
+    EXPECT_FALSE(flagsSpeed.enabled);
+    EXPECT_EQ(flagsSpeed.level, 0);
+    EXPECT_EQ(flagsSpeed.count, 0U);
+}
+
+TEST(GeneratedTest, SerializeProjection) {
+    arraytest::session session {
+        "First Session", 22,
+        { 55, true, { { "Rohit Jairaj Singh", 322 }, { "Ragini Rohit Singh", 323 } }, { { 1, 2 }, { 3, 4 } } }
+    };
+    TestProjection<rohit::serializer::json>(session);
+    TestProjection<rohit::serializer::binary_none>(session);
+    TestProjection<rohit::serializer::binary_integer>(session);
+    TestProjection<rohit::serializer::binary_string>(session);
+    TestProjection<rohit::serializer::binary_bitmap>(session);
+
+    static_assert(rohit::serializer::FieldSet<arraytest::person::f_ID>::Test(arraytest::person::f_ID));
+    static_assert(!rohit::serializer::FieldSet<arraytest::person::f_ID>::Test(arraytest::person::f_name));
+
+    // Fields of derived class are numbered after fields of parent
+    static_assert(test::test1::personex::f_name == test::test1::person::f_name);
+    static_assert(test::test1::personex::f_account == test::test1::person::field_count);
+    static_assert(test::test1::personex::field_count == test::test1::person::field_count + 1);
+    TestParentProjection<rohit::serializer::json>();
+    TestParentProjection<rohit::serializer::binary_none>();
+    TestParentProjection<rohit::serializer::binary_integer>();
+    TestParentProjection<rohit::serializer::binary_string>();
+    TestParentProjection<rohit::serializer::binary_bitmap>();
+    TestParentProjection<rohit::serializer::msgpack>();
+}
+
 TEST(GeneratedTest, SerializeArray) {
     arraytest::personlist personlist { 556, true, {{"Rohit Jairaj Singh", 1}, {"Ragini Rohit Singh", 2}}, {{1, 0}, {2, 1}} };
     rohit::FullStreamAutoAlloc fullstream { 256 };
@@ -179,6 +347,58 @@ TEST(GeneratedTest, SerializeMap) {
     EXPECT_TRUE(personlist.list[1].name == personlistBinaryString.list[1].name);
 }
 
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestPersonIndex(const maptest::personindex &personindex) {
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    personindex.SerializeOut<SerializerProtocol>(fullstream);
+    maptest::personindex personindex1 { };
+    fullstream.Reset();
+    personindex1.SerializeIn<SerializerProtocol>(fullstream);
+    EXPECT_TRUE(personindex1.byName == personindex.byName);
+    EXPECT_TRUE(personindex1.byId.size() == personindex.byId.size());
+    for(auto &[id, person]: personindex.byId) {
+        EXPECT_TRUE(personindex1.byId.at(id).name == person.name);
+        EXPECT_TRUE(personindex1.byId.at(id).ID == person.ID);
+    }
+}
+
+TEST(GeneratedTest, SerializeHashFlatMap) {
+    maptest::personindex personindex { };
+    personindex.byName.emplace("Rohit Jairaj Singh", 1);
+    personindex.byName.emplace("Ragini Rohit Singh", 2);
+    // Inserted out of order, flat_map keeps key order
+    personindex.byId.emplace(2, maptest::person { "Ragini Rohit Singh", 2 });
+    personindex.byId.emplace(1, maptest::person { "Rohit Jairaj Singh", 1 });
+    personindex.byId[3] = maptest::person { "Anand", 3 };
+    EXPECT_TRUE(personindex.byId.begin()->first == 1);
+    EXPECT_TRUE(std::is_sorted(personindex.byId.begin(), personindex.byId.end(),
+        [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; }));
+
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    personindex.SerializeOut<rohit::serializer::json>(fullstream);
+    std::string personindexstr {reinterpret_cast<char *>(fullstream.begin()), fullstream.CurrentOffset()};
+    std::string result_byIdstr { R"("byId":[{"key":1,"value":{"name":"Rohit Jairaj Singh","ID":1}},{"key":2,"value":{"name":"Ragini Rohit Singh","ID":2}},{"key":3,"value":{"name":"Anand","ID":3}}])" };
+    EXPECT_TRUE(personindexstr.find(result_byIdstr) != std::string::npos);
+
+    TestPersonIndex<rohit::serializer::json>(personindex);
+    TestPersonIndex<rohit::serializer::binary_none>(personindex);
+    TestPersonIndex<rohit::serializer::binary_integer>(personindex);
+    TestPersonIndex<rohit::serializer::binary_string>(personindex);
+    TestPersonIndex<rohit::serializer::msgpack>(personindex);
+
+    // Unsorted input still loads through emplace_hint
+    rohit::flat_map<uint64_t, uint64_t> flatmap { };
+    flatmap.emplace_hint(flatmap.end(), 5, 50);
+    flatmap.emplace_hint(flatmap.end(), 7, 70);
+    flatmap.emplace_hint(flatmap.end(), 6, 60);
+    flatmap.emplace_hint(flatmap.end(), 6, 61);
+    EXPECT_TRUE(flatmap.size() == 3);
+    EXPECT_TRUE(flatmap.at(6) == 60);
+    EXPECT_TRUE(std::next(flatmap.begin())->first == 6);
+    EXPECT_TRUE(flatmap.erase(6) == 1);
+    EXPECT_TRUE(!flatmap.contains(6));
+}
+
 TEST(GeneratedTest, SerializeUnion) {
     test::cacheserver cacheserver {10, 10, 10, 10, 2010, 10240};
     test::server1 server {test::server1::e_entry::cache, {.cache = cacheserver}, test::test112::em2 };
@@ -271,6 +491,17 @@ TEST(GeneratedTest, SerializeUnion1) {
     EXPECT_TRUE(server.entry.http.port == serverBinaryString.entry.http.port);
     EXPECT_TRUE(server.entry.http.size == serverBinaryString.entry.http.size);
     EXPECT_TRUE(server.entry.http.mimesize == serverBinaryString.entry.http.mimesize);
+
+    fullstream.Reset();
+    server.SerializeOut<rohit::serializer::binary_bitmap>(fullstream);
+    test::server1 serverBinaryBitmap { };
+    fullstream.Reset();
+    serverBinaryBitmap.SerializeIn<rohit::serializer::binary_bitmap>(fullstream);
+    EXPECT_TRUE(server.entry_type == serverBinaryBitmap.entry_type);
+    EXPECT_TRUE(server.entry.http.port == serverBinaryBitmap.entry.http.port);
+    EXPECT_TRUE(server.entry.http.size == serverBinaryBitmap.entry.http.size);
+    EXPECT_TRUE(server.entry.http.mimesize == serverBinaryBitmap.entry.http.mimesize);
+    EXPECT_TRUE(server.test12 == serverBinaryBitmap.test12);
 }
 
 
@@ -309,6 +540,190 @@ TEST(GeneratedTest, SerializeEnum) {
     EXPECT_TRUE(test1.te == testBinaryString.te);
 }
 
+TEST(GeneratedTest, SerializeBitPacked) {
+    bitstest::flags flags1 { "packed", true, bitstest::mode::turbo, 1024, true, 9 };
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    flags1.SerializeOut<rohit::serializer::json>(fullstream);
+    std::string teststr {reinterpret_cast<char *>(fullstream.begin()), fullstream.CurrentOffset()};
+    std::string result_teststr { "{\"name\":\"packed\",\"enabled\":true,\"speed\":\"turbo\",\"count\":1024,\"visible\":true,\"level\":9}" };
+    EXPECT_EQ(result_teststr, teststr);
+
+    auto fullstream1 = rohit::MakeConstantFullStream(result_teststr);
+    bitstest::flags flagsJson { };
+    flagsJson.SerializeIn<rohit::serializer::json>(fullstream1);
+    EXPECT_EQ(flags1.GetPackedBits(), flagsJson.GetPackedBits());
+    EXPECT_EQ(flags1.count, flagsJson.count);
+
+    bitstest::flags flagsSet { };
+    flagsSet.SetPackedBits(flags1.GetPackedBits());
+    EXPECT_EQ(flags1.GetPackedBits(), flagsSet.GetPackedBits());
+
+    // Four packed members are written as single uint16_t
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_none>(fullstream);
+    EXPECT_EQ(fullstream.CurrentOffset(), 1 + 6 + sizeof(uint16_t) + sizeof(uint32_t));
+    bitstest::flags flagsBinaryNone { };
+    fullstream.Reset();
+    flagsBinaryNone.SerializeIn<rohit::serializer::binary_none>(fullstream);
+    EXPECT_EQ(flagsBinaryNone.name, flags1.name);
+    EXPECT_TRUE(flagsBinaryNone.enabled);
+    EXPECT_EQ(flagsBinaryNone.speed, bitstest::mode::turbo);
+    EXPECT_EQ(flagsBinaryNone.count, 1024);
+    EXPECT_TRUE(flagsBinaryNone.visible);
+    EXPECT_EQ(flagsBinaryNone.level, 9);
+
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_integer>(fullstream);
+    bitstest::flags flagsBinaryInteger { };
+    fullstream.Reset();
+    flagsBinaryInteger.SerializeIn<rohit::serializer::binary_integer>(fullstream);
+    EXPECT_EQ(flags1.GetPackedBits(), flagsBinaryInteger.GetPackedBits());
+    EXPECT_EQ(flagsBinaryInteger.count, 1024);
+
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_string>(fullstream);
+    bitstest::flags flagsBinaryString { };
+    fullstream.Reset();
+    flagsBinaryString.SerializeIn<rohit::serializer::binary_string>(fullstream);
+    EXPECT_EQ(flags1.GetPackedBits(), flagsBinaryString.GetPackedBits());
+    EXPECT_EQ(flagsBinaryString.name, flags1.name);
+
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_bitmap>(fullstream);
+    bitstest::flags flagsBinaryBitmap { };
+    fullstream.Reset();
+    flagsBinaryBitmap.SerializeIn<rohit::serializer::binary_bitmap>(fullstream);
+    EXPECT_EQ(flags1.GetPackedBits(), flagsBinaryBitmap.GetPackedBits());
+    EXPECT_EQ(flagsBinaryBitmap.name, flags1.name);
+    EXPECT_EQ(flagsBinaryBitmap.count, 1024);
+}
+
+TEST(GeneratedTest, SerializeBitField) {
+    bitstest::compactflags flags1 { };
+    flags1.enabled = true;
+    flags1.speed = bitstest::mode::high;
+    flags1.offset = 4000;
+    flags1.visible = true;
+    EXPECT_LE(sizeof(flags1), sizeof(uint32_t));
+
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    flags1.SerializeOut<rohit::serializer::json>(fullstream);
+    std::string teststr {reinterpret_cast<char *>(fullstream.begin()), fullstream.CurrentOffset()};
+    std::string result_teststr { "{\"enabled\":true,\"speed\":\"high\",\"offset\":4000,\"visible\":true}" };
+    EXPECT_EQ(result_teststr, teststr);
+
+    auto fullstream1 = rohit::MakeConstantFullStream(result_teststr);
+    bitstest::compactflags flagsJson { };
+    flagsJson.SerializeIn<rohit::serializer::json>(fullstream1);
+    EXPECT_EQ(flags1.GetPackedBits(), flagsJson.GetPackedBits());
+
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_none>(fullstream);
+    EXPECT_EQ(fullstream.CurrentOffset(), sizeof(uint32_t));
+    bitstest::compactflags flagsBinaryNone { };
+    fullstream.Reset();
+    flagsBinaryNone.SerializeIn<rohit::serializer::binary_none>(fullstream);
+    EXPECT_EQ(flagsBinaryNone.offset, 4000);
+    EXPECT_EQ(flagsBinaryNone.speed, bitstest::mode::high);
+
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_integer>(fullstream);
+    bitstest::compactflags flagsBinaryInteger { };
+    fullstream.Reset();
+    flagsBinaryInteger.SerializeIn<rohit::serializer::binary_integer>(fullstream);
+    EXPECT_EQ(flags1.GetPackedBits(), flagsBinaryInteger.GetPackedBits());
+
+    fullstream.Reset();
+    flags1.SerializeOut<rohit::serializer::binary_string>(fullstream);
+    bitstest::compactflags flagsBinaryString { };
+    fullstream.Reset();
+    flagsBinaryString.SerializeIn<rohit::serializer::binary_string>(fullstream);
+    EXPECT_EQ(flags1.GetPackedBits(), flagsBinaryString.GetPackedBits());
+}
+
+TEST(GeneratedTest, MemberDescriptor) {
+    constexpr auto descriptors = test::test1::person::GetMemberDescriptors();
+    static_assert(std::tuple_size_v<decltype(descriptors)> == 2);
+    static_assert(std::get<0>(descriptors).name == "name");
+    static_assert(std::get<0>(descriptors).key == "fullname");
+    static_assert(std::get<0>(descriptors).id == 3);
+    static_assert(std::get<1>(descriptors).field == test::test1::person::f_ID);
+    static_assert(std::get<1>(descriptors).tag == rohit::serializer::MemberTypeTag::Primitive);
+    static_assert(std::get<0>(arraytest::session::GetMemberDescriptors()).tag == rohit::serializer::MemberTypeTag::Primitive);
+    static_assert(std::get<2>(arraytest::session::GetMemberDescriptors()).tag == rohit::serializer::MemberTypeTag::Class);
+    static_assert(std::get<2>(arraytest::personlist::GetMemberDescriptors()).tag == rohit::serializer::MemberTypeTag::Array);
+    static_assert(std::get<0>(test::server1::GetMemberDescriptors()).tag == rohit::serializer::MemberTypeTag::Union);
+
+    test::test1::personex personex { "Rohit Jairaj Singh", 322, 122 };
+    std::string names { };
+    uint64_t total { 0 };
+    personex.ForEachMember([&names, &total](const auto &descriptor, const auto &value) {
+        names += descriptor.key;
+        names += ';';
+        if constexpr (std::integral<std::remove_cvref_t<decltype(value)>>) total += value;
+    });
+    EXPECT_EQ(names, "fullname;ID;account;");
+    EXPECT_EQ(total, 444);
+
+    // Setting through descriptor
+    std::get<1>(descriptors).Set(personex, 10);
+    EXPECT_EQ(personex.ID, 10);
+    EXPECT_EQ(std::get<0>(descriptors).Default(), "None");
+
+    bitstest::compactflags flags { };
+    constexpr auto bitDescriptors = bitstest::compactflags::GetMemberDescriptors();
+    std::get<2>(bitDescriptors).Set(flags, 4000);
+    EXPECT_EQ(flags.offset, 4000);
+    EXPECT_EQ(std::get<2>(bitDescriptors).Get(flags), 4000);
+    EXPECT_EQ(std::get<2>(bitDescriptors).Default(), 0);
+    uint32_t count { 0 };
+    flags.ForEachMember([&count](const auto &, const auto &) { ++count; });
+    EXPECT_EQ(count, 4);
+}
+
+TEST(GeneratedTest, OptimizedLayout) {
+    std::string input {
+        "namespace layouttest {"
+        "class mixed { public bool active; public uint64 id; public uint8 level; public string name; public bool visible; public uint32 count; }"
+        "class holder { public uint8 tag; public mixed value; public uint16 port; }"
+        "}"
+        "namespace test::test1 {"
+        "class person { public string name; public uint64 ID; }"
+        "}"
+    };
+    rohit::FullStream inStream { input.data(), input.size() };
+    auto statementlist = rohit::serializer::Parser::Parse(inStream);
+    auto reportList = rohit::serializer::Writer::CPP::GetLayoutReport(statementlist);
+    ASSERT_EQ(reportList.size(), 3);
+    EXPECT_EQ(reportList[0].name, "layouttest::mixed");
+    EXPECT_EQ(reportList[0].sizeOptimized, sizeof(layouttest::mixed));
+    EXPECT_LT(reportList[0].sizeOptimized, reportList[0].sizeDeclared);
+    EXPECT_LT(reportList[0].paddingOptimized, reportList[0].paddingDeclared);
+    EXPECT_EQ(reportList[1].sizeOptimized, sizeof(layouttest::holder));
+    EXPECT_EQ(reportList[2].sizeDeclared, sizeof(test::test1::person));
+
+    // Wire order is same as declaration order
+    layouttest::mixed mixed { };
+    mixed.active = true;
+    mixed.id = 0x0102030405060708;
+    mixed.level = 9;
+    mixed.name = "abc";
+    mixed.visible = false;
+    mixed.count = 7;
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    mixed.SerializeOut<rohit::serializer::binary_none>(fullstream);
+    const std::vector<uint8_t> expected { 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 3, 'a', 'b', 'c', 0, 0, 0, 0, 7 };
+    const std::vector<uint8_t> output { fullstream.begin(), fullstream.begin() + fullstream.CurrentOffset() };
+    EXPECT_EQ(output, expected);
+
+    layouttest::mixed mixedBinaryNone { };
+    fullstream.Reset();
+    mixedBinaryNone.SerializeIn<rohit::serializer::binary_none>(fullstream);
+    EXPECT_EQ(mixedBinaryNone.id, mixed.id);
+    EXPECT_EQ(mixedBinaryNone.name, mixed.name);
+    EXPECT_EQ(mixedBinaryNone.count, mixed.count);
+}
+
 static constexpr const char teststr[] = 
 // Redundant spaces are added in below string for testing purposes only.
 R"(
@@ -559,4 +974,1206 @@ R"({
 })"
     };
     EXPECT_TRUE(resultVertical == expectedBeautifyVerticalOutput);
-}
\ No newline at end of file
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestInlineHost(const inlinetest::host &host) {
+    rohit::FullStreamAutoAlloc fullstream { 1024 };
+    host.SerializeOut<SerializerProtocol>(fullstream);
+    inlinetest::host host1 { };
+    fullstream.Reset();
+    host1.SerializeIn<SerializerProtocol>(fullstream);
+    EXPECT_TRUE(host1.country == host.country);
+    EXPECT_TRUE(host1.ipv6 == host.ipv6);
+    EXPECT_TRUE(host1.tags == host.tags);
+    EXPECT_TRUE(host1.path.size() == host.path.size());
+    EXPECT_TRUE(host1.path.back().y == host.path.back().y);
+    EXPECT_TRUE(host1.description == host.description);
+}
+
+TEST(GeneratedTest, SerializeInline) {
+    inlinetest::host host { };
+    EXPECT_TRUE(host.country == "IN");
+    host.country = "US";
+    for(uint8_t index = 0; index < 16; ++index) host.ipv6.push_back(index * 7);
+    host.tags = { "edge", "cache", "db", "x" };
+    host.path.emplace_back(inlinetest::point { 1, 2 });
+    host.path.emplace_back(inlinetest::point { 3, 4 });
+    host.description = "Primary edge host";
+    EXPECT_THROW(host.tags.push_back("a"), std::length_error);
+    host.tags.pop_back();
+    host.tags.pop_back();
+
+    rohit::FullStreamAutoAlloc fullstream { 1024 };
+    host.SerializeOut<rohit::serializer::json>(fullstream);
+    std::string hoststr {reinterpret_cast<char *>(fullstream.begin()), fullstream.CurrentOffset()};
+    EXPECT_TRUE(hoststr.find(R"("country":"US")") != std::string::npos);
+    EXPECT_TRUE(hoststr.find(R"("tags":["edge","cache"])") != std::string::npos);
+
+    TestInlineHost<rohit::serializer::json>(host);
+    TestInlineHost<rohit::serializer::binary_none>(host);
+    TestInlineHost<rohit::serializer::binary_integer>(host);
+    TestInlineHost<rohit::serializer::binary_string>(host);
+    TestInlineHost<rohit::serializer::binary_bitmap>(host);
+    TestInlineHost<rohit::serializer::msgpack>(host);
+
+    // binary_none is fixed width, only std::string elements of tags vary with content
+    inlinetest::host emptyhost { };
+    rohit::FullStreamAutoAlloc emptystream { 1024 };
+    emptyhost.SerializeOut<rohit::serializer::binary_none>(emptystream);
+    fullstream.Reset();
+    host.SerializeOut<rohit::serializer::binary_none>(fullstream);
+    EXPECT_TRUE(fullstream.CurrentOffset() - emptystream.CurrentOffset() == host.tags[0].size() + host.tags[1].size());
+
+    // Input larger than capacity is rejected
+    std::string badcountry { R"({"country":"IND"})" };
+    auto badstream = rohit::MakeConstantFullStream(badcountry);
+    inlinetest::host badhost { };
+    EXPECT_THROW(badhost.SerializeIn<rohit::serializer::json>(badstream), rohit::serializer::exception::BadInputData);
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void EncodeTo(rohit::FullStreamAutoAlloc &fullstream, const auto &obj) {
+    fullstream.Reset();
+    obj.template SerializeOut<SerializerProtocol>(fullstream);
+    fullstream.Reset();
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerOutProtocol, template<rohit::serializer::SerializeType> class SerializerInProtocol>
+void TestReuse() {
+    arraytest::personlist large { 10, true, { { "Rohit Jairaj Singh", 1 }, { "Ragini Rohit Singh", 2 }, { "Anand", 3 } }, { { 1, 2 }, { 3, 4 } } };
+    arraytest::personlist small { 20, false, { { "Ram", 4 } }, { { 5, 6 } } };
+    rohit::FullStreamAutoAlloc fullstream { 1024 };
+
+    arraytest::personlist scratch { };
+    EncodeTo<SerializerOutProtocol>(fullstream, large);
+    scratch.SerializeIn<SerializerInProtocol>(fullstream);
+    EXPECT_TRUE(scratch.list.size() == 3);
+    const auto listData = scratch.list.data();
+    const auto listCapacity = scratch.list.capacity();
+    const auto nameData = scratch.list[0].name.data();
+
+    // Decoding again replaces content, storage of list and its strings is kept
+    EncodeTo<SerializerOutProtocol>(fullstream, small);
+    scratch.SerializeIn<SerializerInProtocol>(fullstream);
+    EXPECT_TRUE(scratch.listid == 20);
+    EXPECT_TRUE(!scratch.check);
+    EXPECT_TRUE(scratch.list.size() == 1);
+    EXPECT_TRUE(scratch.list[0].name == "Ram");
+    EXPECT_TRUE(scratch.list[0].ID == 4);
+    EXPECT_TRUE(scratch.list.data() == listData);
+    EXPECT_TRUE(scratch.list.capacity() == listCapacity);
+    EXPECT_TRUE(scratch.list[0].name.data() == nameData);
+    EXPECT_TRUE(scratch.reverseListMap.size() == 1);
+    EXPECT_TRUE(scratch.reverseListMap.at(5) == 6);
+
+    EncodeTo<SerializerOutProtocol>(fullstream, large);
+    scratch.SerializeIn<SerializerInProtocol>(fullstream);
+    EXPECT_TRUE(scratch.list.size() == 3);
+    EXPECT_TRUE(scratch.list[2].name == "Anand");
+    EXPECT_TRUE(scratch.reverseListMap == large.reverseListMap);
+
+    maptest::personindex index { };
+    index.byName = { { "Rohit", 1 }, { "Ragini", 2 } };
+    index.byId.emplace(1, maptest::person { "Rohit", 1 });
+    index.byId.emplace(2, maptest::person { "Ragini", 2 });
+    maptest::personindex indexScratch { };
+    indexScratch.byName = { { "Stale", 9 } };
+    indexScratch.byId.emplace(9, maptest::person { "Stale", 9 });
+    EncodeTo<SerializerOutProtocol>(fullstream, index);
+    indexScratch.SerializeIn<SerializerInProtocol>(fullstream);
+    EXPECT_TRUE(indexScratch.byName == index.byName);
+    EXPECT_TRUE(indexScratch.byId.size() == 2);
+    EXPECT_TRUE(indexScratch.byId.at(2).name == "Ragini");
+    EXPECT_TRUE(!indexScratch.byId.contains(9));
+}
+
+TEST(GeneratedTest, SerializeReuse) {
+    TestReuse<rohit::serializer::json, rohit::serializer::json_reuse>();
+    TestReuse<rohit::serializer::binary_none, rohit::serializer::binary_none_reuse>();
+    TestReuse<rohit::serializer::binary_integer, rohit::serializer::binary_integer_reuse>();
+    TestReuse<rohit::serializer::binary_string, rohit::serializer::binary_string_reuse>();
+    TestReuse<rohit::serializer::binary_bitmap, rohit::serializer::binary_bitmap_reuse>();
+    TestReuse<rohit::serializer::msgpack, rohit::serializer::msgpack_reuse>();
+
+    // Members absent from sparse input are reset to default
+    test::test1::personex sparse { };
+    sparse.name = "Rohit Jairaj Singh";
+    test::test1::personex scratch { };
+    scratch.name = "Stale";
+    scratch.ID = 10;
+    scratch.account = 20;
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    EncodeTo<rohit::serializer::binary_integer_sparse>(fullstream, sparse);
+    scratch.SerializeIn<rohit::serializer::binary_integer_reuse>(fullstream);
+    EXPECT_TRUE(scratch.name == "Rohit Jairaj Singh");
+    EXPECT_TRUE(scratch.ID == 0);
+    EXPECT_TRUE(scratch.account == 1);
+
+    sparse.name = "None";
+    EncodeTo<rohit::serializer::json_sparse>(fullstream, sparse);
+    scratch.SerializeIn<rohit::serializer::json_reuse>(fullstream);
+    EXPECT_TRUE(scratch.name == "None");
+
+    // Packed members are reset and decoded from packed word
+    bitstest::flags flags { };
+    flags.enabled = true;
+    flags.level = 3;
+    bitstest::flags flagsScratch { };
+    flagsScratch.visible = true;
+    EncodeTo<rohit::serializer::binary_integer_sparse>(fullstream, flags);
+    flagsScratch.SerializeIn<rohit::serializer::binary_integer_reuse>(fullstream);
+    EXPECT_TRUE(flagsScratch.enabled);
+    EXPECT_TRUE(flagsScratch.level == 3);
+    EXPECT_TRUE(!flagsScratch.visible);
+}
+
+// Default resource is restored even when decode throws
+class DefaultResourceGuard {
+    std::pmr::memory_resource * const previous;
+
+public:
+    DefaultResourceGuard(std::pmr::memory_resource *resource) : previous { std::pmr::set_default_resource(resource) } { }
+    DefaultResourceGuard(const DefaultResourceGuard &) = delete;
+    DefaultResourceGuard &operator=(const DefaultResourceGuard &) = delete;
+    ~DefaultResourceGuard() { std::pmr::set_default_resource(previous); }
+};
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestPmrDirectory(const pmrtest::directory &directory) {
+    rohit::FullStreamAutoAlloc fullstream { 1024 };
+    EncodeTo<SerializerProtocol>(fullstream, directory);
+
+    // Every allocation must come from arena, default resource fails any stray allocation
+    std::array<std::byte, 16384> buffer { };
+    std::pmr::monotonic_buffer_resource arena { buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+    pmrtest::directory decoded { &arena };
+    {
+        DefaultResourceGuard guard { std::pmr::null_memory_resource() };
+        decoded.SerializeIn<SerializerProtocol>(fullstream);
+    }
+
+    EXPECT_TRUE(decoded.directoryId == directory.directoryId);
+    EXPECT_TRUE(decoded.people.size() == 2);
+    EXPECT_TRUE(decoded.people[1].name == directory.people[1].name);
+    EXPECT_TRUE(decoded.people[1].scores == directory.people[1].scores);
+    EXPECT_TRUE(decoded.people[1].name.get_allocator().resource() == &arena);
+    EXPECT_TRUE(decoded.byId.size() == 1);
+    EXPECT_TRUE(decoded.byId.at(7).name == directory.people[0].name);
+    EXPECT_TRUE(decoded.byId.at(7).name.get_allocator().resource() == &arena);
+    EXPECT_TRUE(decoded.byName == directory.byName);
+    EXPECT_TRUE(decoded.labels == directory.labels);
+    EXPECT_TRUE(decoded.labels.at(1).get_allocator().resource() == &arena);
+    EXPECT_TRUE(decoded.code == directory.code);
+}
+
+TEST(GeneratedTest, SerializePmr) {
+    pmrtest::person defaultPerson { std::pmr::new_delete_resource() };
+    EXPECT_TRUE(defaultPerson.name == "unknown");
+
+    pmrtest::directory directory { };
+    directory.directoryId = 42;
+    directory.people.push_back(pmrtest::person { });
+    directory.people.back().name = "Rohit Jairaj Singh, Bengaluru, India";
+    directory.people.back().scores = { 1, 2, 3 };
+    directory.people.push_back(pmrtest::person { });
+    directory.people.back().name = "Ragini Rohit Singh, Bengaluru, India";
+    directory.people.back().ID = 2;
+    directory.people.back().scores = { 4, 5, 6, 7 };
+    directory.byId.emplace(7, directory.people[0]);
+    directory.byName.emplace("Rohit Jairaj Singh, Bengaluru, India", 1);
+    directory.labels.emplace(1, "Label with more characters than inline storage");
+    directory.labels.emplace(2, "short");
+    directory.code.assign("IN");
+
+    TestPmrDirectory<rohit::serializer::json>(directory);
+    TestPmrDirectory<rohit::serializer::binary_none>(directory);
+    TestPmrDirectory<rohit::serializer::binary_integer>(directory);
+    TestPmrDirectory<rohit::serializer::binary_string>(directory);
+    TestPmrDirectory<rohit::serializer::binary_bitmap>(directory);
+    TestPmrDirectory<rohit::serializer::msgpack>(directory);
+
+    // Copy into an arena keeps the arena for every nested container
+    std::pmr::monotonic_buffer_resource arena { };
+    pmrtest::directory copy { directory, &arena };
+    EXPECT_TRUE(copy.people[0].name == directory.people[0].name);
+    EXPECT_TRUE(copy.people[0].name.get_allocator().resource() == &arena);
+    EXPECT_TRUE(copy.byId.at(7).scores.get_allocator().resource() == &arena);
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestTryTruncated(const arraytest::sessionstore &sessionstore) {
+    rohit::FullStreamAutoAlloc fullstream { 1024 };
+    sessionstore.SerializeOut<SerializerProtocol>(fullstream);
+    const std::string encoded { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+    size_t size { 0 };
+    {
+        auto stream = rohit::MakeConstantFullStream(encoded);
+        arraytest::sessionstore decoded { };
+        auto status = decoded.TrySerializeIn<SerializerProtocol>(stream);
+        EXPECT_TRUE(status);
+        EXPECT_TRUE(decoded.sessionlist.size() == 2);
+        EXPECT_TRUE(decoded.sessionlist[1].persons.list[0].name == "Ragini Rohit Singh");
+        size = stream.CurrentOffset();
+        EXPECT_EQ(size, encoded.size());
+    }
+
+    // Every truncated input fails without exception, failure is within input
+    for(size_t length { 0 }; length < size; ++length) {
+        const std::string truncated { encoded.substr(0, length) };
+        auto stream = rohit::MakeConstantFullStream(truncated);
+        arraytest::sessionstore decoded { };
+        auto status = decoded.TrySerializeIn<SerializerProtocol>(stream);
+        EXPECT_FALSE(status);
+        EXPECT_TRUE(status.Offset() <= length);
+    }
+}
+
+TEST(GeneratedTest, TrySerializeIn) {
+    arraytest::sessionstore sessionstore { "store", {
+        { "first", 1, { 1, true, { { "Rohit Jairaj Singh", 1 } }, { { 1, 2 } } } },
+        { "second", 2, { 2, false, { { "Ragini Rohit Singh", 2 } }, { } } } } };
+    TestTryTruncated<rohit::serializer::json>(sessionstore);
+    TestTryTruncated<rohit::serializer::binary_none>(sessionstore);
+    TestTryTruncated<rohit::serializer::binary_integer>(sessionstore);
+    TestTryTruncated<rohit::serializer::binary_string>(sessionstore);
+    TestTryTruncated<rohit::serializer::binary_bitmap>(sessionstore);
+    TestTryTruncated<rohit::serializer::msgpack>(sessionstore);
+
+    // Lookahead for end of object stops at end of input, buffer is exactly of input size
+    for(const std::string_view truncated: { "{", "{ ", R"({"fullname":"A")", R"({"fullname":"A",)", R"({"fullname":"A", )" }) {
+        const std::vector<uint8_t> exact { std::begin(truncated), std::end(truncated) };
+        test::test1::person personTruncated { };
+        const auto status = personTruncated.TrySerializeIn<rohit::serializer::json>(rohit::MakeConstantFullStream(exact.data(), exact.data() + exact.size()));
+        EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::UnexpectedEnd);
+    }
+
+    // Diagnostic is built only on request from stream left at failed location
+    const std::string badjson { R"({"listid":556,"check":true,"list":[{"name":"Rohit","ID":1}x]})" };
+    auto badstream = rohit::MakeConstantFullStream(badjson);
+    arraytest::personlist personlist { };
+    auto status = personlist.TrySerializeIn<rohit::serializer::json>(badstream);
+    EXPECT_FALSE(status);
+    EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::UnexpectedCharacter);
+    EXPECT_TRUE(status.Offset() == badjson.find('x'));
+    EXPECT_TRUE(status.Diagnostic(badstream).find("failed here") != std::string::npos);
+    EXPECT_TRUE(personlist.listid == 556);
+
+    const uint8_t badbitmap[] { 0x04 };
+    auto badbitmapstream = rohit::MakeConstantFullStream(std::begin(badbitmap), std::end(badbitmap));
+    test::test1::person personBad { };
+    status = personBad.TrySerializeIn<rohit::serializer::binary_bitmap>(badbitmapstream);
+    EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::UnknownKey);
+
+    const std::string badenum { R"({"te":"test9"})" };
+    auto badenumstream = rohit::MakeConstantFullStream(badenum);
+    enumtest::test testBad { };
+    status = testBad.TrySerializeIn<rohit::serializer::json>(badenumstream);
+    EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::BadValue);
+    EXPECT_THROW(testBad.SerializeIn<rohit::serializer::json>(rohit::MakeConstantFullStream(badenum)), rohit::serializer::exception::BadInputData);
+
+    enumtest::testenum value { };
+    EXPECT_TRUE(enumtest::from_string("test3", value));
+    EXPECT_TRUE(value == enumtest::testenum::test3);
+    EXPECT_FALSE(enumtest::from_string("test9", value));
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol, typename T>
+void TestValidate(const T &obj) {
+    rohit::FullStreamAutoAlloc fullstream { 1024 };
+    obj.template SerializeOut<SerializerProtocol>(fullstream);
+    const std::string encoded { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+
+    auto stream = rohit::MakeConstantFullStream(encoded);
+    EXPECT_TRUE(T::template Validate<SerializerProtocol>(stream));
+    EXPECT_TRUE(stream.CurrentOffset() == 0);
+
+    for(size_t length { 0 }; length < encoded.size(); ++length) {
+        const std::string truncated { encoded.substr(0, length) };
+        EXPECT_FALSE(T::template Validate<SerializerProtocol>(rohit::MakeConstantFullStream(truncated)));
+    }
+}
+
+// Calls test with sample of each kind of schema, arrays, maps, union with parent, packed bits and inline containers
+void ForEachSample(auto &&test) {
+    arraytest::sessionstore sessionstore { "store", {
+        { "first", 1, { 1, true, { { "Rohit Jairaj Singh", 1 } }, { { 1, 2 } } } },
+        { "second", 2, { 2, false, { { "Ragini Rohit Singh", 2 } }, { } } } } };
+    test(sessionstore);
+
+    maptest::personindex personindex { };
+    // Order of hash map is not kept by decoding, hence single entry
+    personindex.byName = { { "Rohit", 1 } };
+    personindex.byId.emplace(1, maptest::person { "Rohit", 1 });
+    personindex.byId.emplace(2, maptest::person { "Ragini", 2 });
+    test(personindex);
+
+    test::cacheserver cacheserver { 10, 10, 10, 10, 2010, 10240 };
+    test::server1 server { test::server1::e_entry::cache, { .cache = cacheserver }, test::test112::em2 };
+    test(server);
+
+    bitstest::flags flags { };
+    flags.name = "flags";
+    flags.speed = bitstest::mode::high;
+    flags.level = 3;
+    test(flags);
+
+    bitstest::compactflags compactflags { };
+    compactflags.enabled = true;
+    compactflags.offset = 1000;
+    test(compactflags);
+
+    inlinetest::host host { };
+    host.country.assign("GB");
+    host.tags.push_back("edge");
+    host.path.push_back({ 1, 2 });
+    host.description.assign("Caf\xc3\xa9 \xe2\x82\xac");
+    test(host);
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestValidateAll() {
+    ForEachSample([](const auto &obj) { TestValidate<SerializerProtocol>(obj); });
+}
+
+TEST(GeneratedTest, Validate) {
+    TestValidateAll<rohit::serializer::json>();
+    TestValidateAll<rohit::serializer::binary_none>();
+    TestValidateAll<rohit::serializer::binary_integer>();
+    TestValidateAll<rohit::serializer::binary_string>();
+    TestValidateAll<rohit::serializer::binary_bitmap>();
+    TestValidateAll<rohit::serializer::msgpack>();
+
+    using rohit::serializer::ErrorKind;
+    const auto validateJson = [](const std::string &json) {
+        return arraytest::personlist::Validate<rohit::serializer::json>(rohit::MakeConstantFullStream(json));
+    };
+    EXPECT_TRUE(validateJson(R"({"listid":1,"check":false,"list":[{"name":"Ab","ID":1}],"reverseListMap":[{"key":1,"value":2}]})"));
+    EXPECT_TRUE(validateJson("{\"list\":[{\"name\":\"A\xc3\",\"ID\":1}]}").error() == ErrorKind::BadValue);
+    EXPECT_TRUE(validateJson("{\"list\":[{\"name\":\"Long name with overlong \xc0\xaf\",\"ID\":1}]}").error() == ErrorKind::BadValue);
+    EXPECT_TRUE(validateJson(R"({"list":[{"name":"Ab","ID":1},]})").error() == ErrorKind::UnexpectedCharacter);
+    EXPECT_TRUE(validateJson(R"({"listid":1,"unknown":2})").error() == ErrorKind::UnknownKey);
+    EXPECT_TRUE(validateJson(R"({"check":yes})").error() == ErrorKind::UnexpectedCharacter);
+    // Backslash does not escape quote, validation agrees with decoding
+    const std::string escaped { R"({"list":[{"name":"a\"b","ID":1}]})" };
+    arraytest::personlist escapedList { };
+    EXPECT_FALSE(validateJson(escaped));
+    EXPECT_FALSE(escapedList.TrySerializeIn<rohit::serializer::json>(rohit::MakeConstantFullStream(escaped)));
+
+    const auto validateInline = [](const std::string &json) {
+        return inlinetest::host::Validate<rohit::serializer::json>(rohit::MakeConstantFullStream(json));
+    };
+    EXPECT_TRUE(validateInline(R"({"country":"IN","tags":["a","b","c","d"]})"));
+    EXPECT_TRUE(validateInline(R"({"country":"IND"})").error() == ErrorKind::CapacityExceeded);
+    EXPECT_TRUE(validateInline(R"({"tags":["a","b","c","d","e"]})").error() == ErrorKind::CapacityExceeded);
+
+    const std::string badenum { R"({"te":"test9"})" };
+    EXPECT_TRUE(enumtest::test::Validate<rohit::serializer::json>(rohit::MakeConstantFullStream(badenum)).error() == ErrorKind::BadValue);
+
+    // Binary string with invalid UTF-8 and bool other than 0 or 1
+    arraytest::person person { "Rohit", 1 };
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    person.SerializeOut<rohit::serializer::binary_none>(fullstream);
+    std::string encoded { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+    EXPECT_TRUE(arraytest::person::Validate<rohit::serializer::binary_none>(rohit::MakeConstantFullStream(encoded)));
+    encoded[2] = '\xff';
+    auto status = arraytest::person::Validate<rohit::serializer::binary_none>(rohit::MakeConstantFullStream(encoded));
+    EXPECT_TRUE(status.error() == ErrorKind::BadValue);
+    EXPECT_TRUE(status.Offset() == 1);
+
+    arraytest::personlist personlist { 1, true, { }, { } };
+    fullstream.Reset();
+    personlist.SerializeOut<rohit::serializer::binary_none>(fullstream);
+    encoded.assign(reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset());
+    encoded[sizeof(uint64_t)] = 2;
+    EXPECT_TRUE(arraytest::personlist::Validate<rohit::serializer::binary_none>(rohit::MakeConstantFullStream(encoded)).error() == ErrorKind::BadValue);
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+std::string EncodeString(const auto &obj) {
+    rohit::FullStreamAutoAlloc fullstream { 64 };
+    obj.template SerializeOut<SerializerProtocol>(fullstream);
+    return { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+}
+
+template <template<rohit::serializer::SerializeType> class FromProtocol, template<rohit::serializer::SerializeType> class ToProtocol, typename T>
+void TestTranscode(const T &obj) {
+    const auto encoded = EncodeString<FromProtocol>(obj);
+    const auto input = rohit::MakeConstantFullStream(encoded);
+    // Small output makes it grow while sizes are waiting to be patched
+    rohit::FullStreamAutoAlloc output { 8 };
+    EXPECT_TRUE((T::template Transcode<FromProtocol, ToProtocol>(input, output)));
+    EXPECT_TRUE(input.CurrentOffset() == encoded.size());
+    const std::string transcoded { reinterpret_cast<const char *>(output.begin()), output.CurrentOffset() };
+
+    // Sizes read from JSON are written in widest encoding, else output is same as encoding the object.
+    constexpr bool fromJson { std::is_same_v<FromProtocol<rohit::serializer::SerializeType::In>, rohit::serializer::json<rohit::serializer::SerializeType::In>> };
+    constexpr bool toJson { std::is_same_v<ToProtocol<rohit::serializer::SerializeType::Out>, rohit::serializer::json<rohit::serializer::SerializeType::Out>> };
+    // Packed members read as one word are written together, flags has a member in between them.
+    // Bitmap input does not have default members hence neither has output.
+    constexpr bool sameOrder { !std::is_same_v<T, bitstest::flags> };
+    constexpr bool fromBitmap { std::is_same_v<FromProtocol<rohit::serializer::SerializeType::In>, rohit::serializer::binary_bitmap<rohit::serializer::SerializeType::In>> };
+    if constexpr ((toJson && sameOrder && !fromBitmap) || (std::is_same_v<FromProtocol<rohit::serializer::SerializeType::In>, ToProtocol<rohit::serializer::SerializeType::In>> && !fromJson)) {
+        EXPECT_EQ(transcoded, EncodeString<ToProtocol>(obj));
+    }
+
+    T decoded { };
+    decoded.template SerializeIn<ToProtocol>(rohit::MakeConstantFullStream(transcoded));
+    EXPECT_EQ(EncodeString<rohit::serializer::json>(decoded), EncodeString<rohit::serializer::json>(obj));
+}
+
+template <template<rohit::serializer::SerializeType> class FromProtocol>
+void TestTranscodeFrom() {
+    ForEachSample([](const auto &obj) {
+        TestTranscode<FromProtocol, rohit::serializer::json>(obj);
+        TestTranscode<FromProtocol, rohit::serializer::binary_none>(obj);
+        TestTranscode<FromProtocol, rohit::serializer::binary_integer>(obj);
+        TestTranscode<FromProtocol, rohit::serializer::binary_string>(obj);
+        TestTranscode<FromProtocol, rohit::serializer::binary_bitmap>(obj);
+    });
+}
+
+TEST(GeneratedTest, Transcode) {
+    TestTranscodeFrom<rohit::serializer::json>();
+    TestTranscodeFrom<rohit::serializer::binary_none>();
+    TestTranscodeFrom<rohit::serializer::binary_integer>();
+    TestTranscodeFrom<rohit::serializer::binary_string>();
+    TestTranscodeFrom<rohit::serializer::binary_bitmap>();
+
+    // Positional output fills members missing in JSON with default
+    const std::string json { R"({"listid":5,"list":[{"name":"Ab","ID":1}]})" };
+    rohit::FullStreamAutoAlloc output { 64 };
+    EXPECT_TRUE((arraytest::personlist::Transcode<rohit::serializer::json, rohit::serializer::binary_none>(rohit::MakeConstantFullStream(json), output)));
+    arraytest::personlist personlist { };
+    personlist.SerializeIn<rohit::serializer::binary_none>(rohit::MakeConstantFullStream(output.begin(), output.CurrentOffset()));
+    EXPECT_TRUE(personlist.listid == 5);
+    EXPECT_FALSE(personlist.check);
+    EXPECT_TRUE(personlist.list.size() == 1 && personlist.list[0].name == "Ab");
+    EXPECT_TRUE(personlist.reverseListMap.empty());
+
+    // Bitmap and positional output need members in schema order
+    const std::string reordered { R"({"check":true,"listid":5})" };
+    output.Reset();
+    auto status = arraytest::personlist::Transcode<rohit::serializer::json, rohit::serializer::binary_bitmap>(rohit::MakeConstantFullStream(reordered), output);
+    EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::BadValue);
+    output.Reset();
+    EXPECT_TRUE((arraytest::personlist::Transcode<rohit::serializer::json, rohit::serializer::binary_integer>(rohit::MakeConstantFullStream(reordered), output)));
+
+    // Bad input is reported as in TrySerializeIn
+    const std::string bad { R"({"listid":5,"list":[{"name":"Ab","ID":1},]})" };
+    output.Reset();
+    status = arraytest::personlist::Transcode<rohit::serializer::json, rohit::serializer::binary_integer>(rohit::MakeConstantFullStream(bad), output);
+    EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::UnexpectedCharacter);
+}
+
+std::pair<std::string, std::string_view> RuntimeSchemaOf(const arraytest::sessionstore &) { return { "array.def", "arraytest::sessionstore" }; }
+std::pair<std::string, std::string_view> RuntimeSchemaOf(const maptest::personindex &) { return { "map.def", "maptest::personindex" }; }
+std::pair<std::string, std::string_view> RuntimeSchemaOf(const test::server1 &) { return { "variable.def", "test::server1" }; }
+std::pair<std::string, std::string_view> RuntimeSchemaOf(const bitstest::flags &) { return { "bits.def", "bitstest::flags" }; }
+std::pair<std::string, std::string_view> RuntimeSchemaOf(const bitstest::compactflags &) { return { "bits.def", "bitstest::compactflags" }; }
+std::pair<std::string, std::string_view> RuntimeSchemaOf(const inlinetest::host &) { return { "inline.def", "inlinetest::host" }; }
+
+const rohit::serializer::Runtime::Schema &GetRuntimeSchema(const std::string &file) {
+    static std::map<std::string, rohit::serializer::Runtime::Schema> schemaMap { };
+    auto itr = schemaMap.find(file);
+    if (itr == schemaMap.end()) {
+        auto inStream = rohit::MakeStreamFromFile(std::filesystem::path { TEST_RESOURCE_DIR } / file);
+        itr = schemaMap.emplace(file, rohit::serializer::Runtime::Schema { rohit::serializer::Parser::Parse(inStream) }).first;
+    }
+    return itr->second;
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol, typename T>
+void TestRuntime(const T &obj) {
+    const auto [file, className] = RuntimeSchemaOf(obj);
+    const rohit::serializer::Runtime::Schema &schema = GetRuntimeSchema(file);
+    const uint32_t classIndex = schema.FindClass(className);
+    const auto encoded = EncodeString<SerializerProtocol>(obj);
+    const auto input = rohit::MakeConstantFullStream(encoded);
+    const auto value = schema.SerializeIn<SerializerProtocol>(classIndex, input);
+    EXPECT_TRUE(input.CurrentOffset() == encoded.size());
+
+    // Value does not depend on protocol it is read from
+    const auto writeRuntime = [&schema, classIndex, &value]<template<rohit::serializer::SerializeType> class OutProtocol>() {
+        rohit::FullStreamAutoAlloc fullstream { 64 };
+        schema.SerializeOut<OutProtocol>(classIndex, value, fullstream);
+        return std::string { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+    };
+    EXPECT_EQ(writeRuntime.template operator()<SerializerProtocol>(), encoded);
+    EXPECT_EQ(writeRuntime.template operator()<rohit::serializer::json>(), EncodeString<rohit::serializer::json>(obj));
+    EXPECT_EQ(writeRuntime.template operator()<rohit::serializer::binary_integer>(), EncodeString<rohit::serializer::binary_integer>(obj));
+    EXPECT_EQ(writeRuntime.template operator()<rohit::serializer::binary_integer_sparse>(), EncodeString<rohit::serializer::binary_integer_sparse>(obj));
+    EXPECT_EQ(writeRuntime.template operator()<rohit::serializer::binary_bitmap>(), EncodeString<rohit::serializer::binary_bitmap>(obj));
+
+    rohit::serializer::Runtime::DynamicValue tryValue { };
+    EXPECT_TRUE(schema.TrySerializeIn<SerializerProtocol>(classIndex, rohit::MakeConstantFullStream(encoded), tryValue));
+    EXPECT_TRUE(tryValue == value);
+    if (!encoded.empty()) {
+        const std::string truncated { encoded.substr(0, encoded.size() - 1) };
+        EXPECT_FALSE(schema.TrySerializeIn<SerializerProtocol>(classIndex, rohit::MakeConstantFullStream(truncated), tryValue));
+    }
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestRuntimeAll() {
+    ForEachSample([](const auto &obj) { TestRuntime<SerializerProtocol>(obj); });
+}
+
+TEST(GeneratedTest, RuntimeSchema) {
+    TestRuntimeAll<rohit::serializer::json>();
+    TestRuntimeAll<rohit::serializer::binary_none>();
+    TestRuntimeAll<rohit::serializer::binary_integer>();
+    TestRuntimeAll<rohit::serializer::binary_string>();
+    TestRuntimeAll<rohit::serializer::binary_bitmap>();
+
+    // Value built at runtime is read by generated class
+    auto &schema = GetRuntimeSchema("array.def");
+    const auto personIndex = schema.FindClass("arraytest::person");
+    auto person = schema.NewObject(personIndex);
+    person.items[schema.FindMember(personIndex, "name")].text = "Rohit";
+    person.items[schema.FindMember(personIndex, "ID")].Set<uint64_t>(7);
+    rohit::FullStreamAutoAlloc fullstream { 64 };
+    schema.SerializeOut<rohit::serializer::json>(personIndex, person, fullstream);
+    const std::string json { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+    EXPECT_EQ(json, R"({"name":"Rohit","ID":7})");
+    arraytest::person decoded { };
+    decoded.SerializeIn<rohit::serializer::json>(rohit::MakeConstantFullStream(json));
+    EXPECT_TRUE(decoded.name == "Rohit" && decoded.ID == 7);
+
+    // Default value of .def is in new object
+    auto &inlineSchema = GetRuntimeSchema("inline.def");
+    const auto hostIndex = inlineSchema.FindClass("inlinetest::host");
+    EXPECT_EQ(inlineSchema.NewObject(hostIndex).items[inlineSchema.FindMember(hostIndex, "country")].text, "IN");
+
+    using rohit::serializer::ErrorKind;
+    rohit::serializer::Runtime::DynamicValue value { };
+    const std::string unknown { R"({"name":"Rohit","age":7})" };
+    EXPECT_TRUE(schema.TrySerializeIn<rohit::serializer::json>(personIndex, rohit::MakeConstantFullStream(unknown), value).error() == ErrorKind::UnknownKey);
+    EXPECT_THROW(schema.SerializeIn<rohit::serializer::json>(personIndex, rohit::MakeConstantFullStream(unknown)), rohit::serializer::exception::KeyNotFound);
+    const std::string longCountry { R"({"country":"IND"})" };
+    EXPECT_TRUE(inlineSchema.TrySerializeIn<rohit::serializer::json>(hostIndex, rohit::MakeConstantFullStream(longCountry), value).error() == ErrorKind::CapacityExceeded);
+    auto &enumSchema = GetRuntimeSchema("enum.def");
+    const std::string badenum { R"({"te":"test9"})" };
+    EXPECT_TRUE(enumSchema.TrySerializeIn<rohit::serializer::json>(enumSchema.FindClass("enumtest::test"), rohit::MakeConstantFullStream(badenum), value).error() == ErrorKind::BadValue);
+    EXPECT_THROW(schema.FindClass("arraytest::unknown"), std::invalid_argument);
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestStreamList(const arraytest::personlist &personlist) {
+    const auto encoded = EncodeString<SerializerProtocol>(personlist);
+
+    arraytest::personlist streamed { };
+    std::vector<arraytest::person> persons { };
+    auto status = streamed.StreamList<SerializerProtocol>(rohit::MakeConstantFullStream(encoded), [&persons](arraytest::person &&person) {
+        persons.push_back(std::move(person));
+    });
+    EXPECT_TRUE(status);
+    EXPECT_TRUE(streamed.list.empty());
+    EXPECT_TRUE(streamed.listid == personlist.listid);
+    EXPECT_TRUE(streamed.reverseListMap == personlist.reverseListMap);
+    ASSERT_EQ(persons.size(), personlist.list.size());
+    for(size_t index { 0 }; index < persons.size(); ++index) {
+        EXPECT_EQ(persons[index].name, personlist.list[index].name);
+        EXPECT_EQ(persons[index].ID, personlist.list[index].ID);
+    }
+
+    // Function returning false stops after that element
+    size_t count { 0 };
+    status = streamed.StreamList<SerializerProtocol>(rohit::MakeConstantFullStream(encoded), [&count](arraytest::person &&) { return ++count < 3; });
+    EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::Stopped);
+    EXPECT_EQ(count, 3U);
+
+    const std::string truncated { encoded.substr(0, encoded.size() / 2) };
+    EXPECT_FALSE(streamed.StreamList<SerializerProtocol>(rohit::MakeConstantFullStream(truncated), [](arraytest::person &&) { }));
+}
+
+TEST(GeneratedTest, StreamList) {
+    arraytest::personlist personlist { 7, true, { }, { { 1, 2 } } };
+    for(uint64_t index { 0 }; index < 100; ++index) personlist.list.push_back({ "Person " + std::to_string(index), index });
+    TestStreamList<rohit::serializer::json>(personlist);
+    TestStreamList<rohit::serializer::binary_none>(personlist);
+    TestStreamList<rohit::serializer::binary_integer>(personlist);
+    TestStreamList<rohit::serializer::binary_string>(personlist);
+    TestStreamList<rohit::serializer::binary_bitmap>(personlist);
+    TestStreamList<rohit::serializer::binary_integer_sparse>(personlist);
+
+    // Elements are decoded one at a time, nested list of session is streamed as a whole element
+    arraytest::sessionstore sessionstore { "store", {
+        { "first", 1, { 1, true, { { "Rohit Jairaj Singh", 1 } }, { { 1, 2 } } } },
+        { "second", 2, { 2, false, { { "Ragini Rohit Singh", 2 } }, { } } } } };
+    const auto encoded = EncodeString<rohit::serializer::binary_integer>(sessionstore);
+    arraytest::sessionstore streamed { };
+    std::vector<std::string> names { };
+    EXPECT_TRUE(streamed.StreamSessionlist<rohit::serializer::binary_integer>(rohit::MakeConstantFullStream(encoded), [&names](arraytest::session &&session) {
+        names.push_back(session.persons.list[0].name);
+    }));
+    EXPECT_EQ(streamed.name, "store");
+    EXPECT_EQ(names, (std::vector<std::string> { "Rohit Jairaj Singh", "Ragini Rohit Singh" }));
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestSerializeOutWithList(const arraytest::personlist &personlist) {
+    const auto encoded = EncodeString<SerializerProtocol>(personlist);
+    arraytest::personlist header { personlist.listid, personlist.check, { }, personlist.reverseListMap };
+    const auto writeWith = [&header](auto &&range) {
+        rohit::FullStreamAutoAlloc fullstream { 64 };
+        header.SerializeOutWithList<SerializerProtocol>(fullstream, range);
+        return std::string { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+    };
+
+    // Sized range writes same bytes as list member
+    EXPECT_EQ(writeWith(personlist.list), encoded);
+    EXPECT_EQ(writeWith(std::views::iota(0U, personlist.list.size())
+        | std::views::transform([&personlist](const size_t index) { return personlist.list[index]; })), encoded);
+
+    // Count of unsized range is patched at end, output decodes to same object
+    const auto unsized = writeWith(personlist.list | std::views::filter([](const arraytest::person &) { return true; }));
+    arraytest::personlist decoded { };
+    decoded.SerializeIn<SerializerProtocol>(rohit::MakeConstantFullStream(unsized));
+    EXPECT_EQ(EncodeString<SerializerProtocol>(decoded), encoded);
+
+    // Checksum stream covers count patched after it grew
+    rohit::ChecksumOutStream checksumStream { 16 };
+    header.SerializeOutWithList<SerializerProtocol>(checksumStream, personlist.list | std::views::filter([](const arraytest::person &) { return true; }));
+    EXPECT_EQ(checksumStream.Checksum(), rohit::Crc32c(checksumStream.begin(), checksumStream.CurrentOffset()));
+}
+
+TEST(GeneratedTest, SerializeOutWithList) {
+    arraytest::personlist personlist { 7, true, { }, { { 1, 2 } } };
+    for(uint64_t index { 0 }; index < 100; ++index) personlist.list.push_back({ "Person " + std::to_string(index), index });
+    TestSerializeOutWithList<rohit::serializer::json>(personlist);
+    TestSerializeOutWithList<rohit::serializer::binary_none>(personlist);
+    TestSerializeOutWithList<rohit::serializer::binary_integer>(personlist);
+    TestSerializeOutWithList<rohit::serializer::binary_string>(personlist);
+    TestSerializeOutWithList<rohit::serializer::binary_bitmap>(personlist);
+    TestSerializeOutWithList<rohit::serializer::binary_integer_sparse>(personlist);
+    TestSerializeOutWithList<rohit::serializer::msgpack>(personlist);
+
+    // Range is read once, empty range is written as empty list
+    arraytest::sessionstore sessionstore { "store", { } };
+    rohit::FullStreamAutoAlloc fullstream { 64 };
+    sessionstore.SerializeOutWithSessionlist<rohit::serializer::json>(fullstream, std::vector<arraytest::session> { });
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset()), R"({"name":"store","sessionlist":[]})");
+}
+
+template <rohit::serializer::SerializeType type>
+using json_beautify = std::conditional_t<type == rohit::serializer::SerializeType::In,
+    rohit::serializer::json<type>, rohit::serializer::JsonOut<true>>;
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestSerializeOutParallel(const arraytest::personlist &personlist, rohit::ThreadPool &pool) {
+    const auto encoded = EncodeString<SerializerProtocol>(personlist);
+    for(const size_t chunkSize: { size_t { 1 }, size_t { 7 }, size_t { 1000 }, personlist.list.size() + 1 }) {
+        rohit::FullStreamAutoAlloc fullstream { 64 };
+        personlist.SerializeOutParallelList<SerializerProtocol>(fullstream, pool, chunkSize);
+        EXPECT_EQ(std::string_view(reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset()), encoded);
+    }
+}
+
+TEST(GeneratedTest, SerializeOutParallel) {
+    rohit::ThreadPool pool { 4 };
+    arraytest::personlist personlist { 7, true, { }, { { 1, 2 } } };
+    for(uint64_t index { 0 }; index < 10000; ++index) personlist.list.push_back({ "Person " + std::to_string(index), index });
+    personlist.list[5].ID = 0;
+    TestSerializeOutParallel<rohit::serializer::json>(personlist, pool);
+    TestSerializeOutParallel<json_beautify>(personlist, pool);
+    TestSerializeOutParallel<rohit::serializer::json_sparse>(personlist, pool);
+    TestSerializeOutParallel<rohit::serializer::binary_none>(personlist, pool);
+    TestSerializeOutParallel<rohit::serializer::binary_integer>(personlist, pool);
+    TestSerializeOutParallel<rohit::serializer::binary_string>(personlist, pool);
+    TestSerializeOutParallel<rohit::serializer::binary_bitmap>(personlist, pool);
+    TestSerializeOutParallel<rohit::serializer::binary_integer_sparse>(personlist, pool);
+    TestSerializeOutParallel<rohit::serializer::msgpack>(personlist, pool);
+
+    // Empty list
+    TestSerializeOutParallel<rohit::serializer::json>(arraytest::personlist { }, pool);
+    TestSerializeOutParallel<rohit::serializer::binary_integer>(arraytest::personlist { }, pool);
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestSerializeInParallel(const arraytest::personlist &personlist, rohit::ThreadPool &pool) {
+    const auto encoded = EncodeString<SerializerProtocol>(personlist);
+    for(const uint32_t interval: { 1U, 7U, 1000U }) {
+        // Offsets are relative to start of object
+        rohit::FullStreamAutoAlloc fullstream { 64 };
+        fullstream.Append("prefix");
+        rohit::serializer::ListIndex index { interval };
+        personlist.SerializeOutIndexedList<SerializerProtocol>(fullstream, index);
+        const std::string_view output { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+        EXPECT_EQ(output.substr(6), encoded);
+
+        arraytest::personlist decoded { };
+        decoded.SerializeInParallelList<SerializerProtocol>(rohit::MakeConstantFullStream(encoded), index, pool);
+        EXPECT_EQ(EncodeString<SerializerProtocol>(decoded), encoded);
+    }
+}
+
+TEST(GeneratedTest, SerializeInParallel) {
+    rohit::ThreadPool pool { 4 };
+    arraytest::personlist personlist { 7, true, { }, { { 1, 2 } } };
+    for(uint64_t index { 0 }; index < 5000; ++index) personlist.list.push_back({ "Person " + std::to_string(index), index });
+    TestSerializeInParallel<rohit::serializer::binary_none>(personlist, pool);
+    TestSerializeInParallel<rohit::serializer::binary_integer>(personlist, pool);
+    TestSerializeInParallel<rohit::serializer::binary_string>(personlist, pool);
+    TestSerializeInParallel<rohit::serializer::binary_bitmap>(personlist, pool);
+    TestSerializeInParallel<rohit::serializer::binary_integer_sparse>(personlist, pool);
+    TestSerializeInParallel<rohit::serializer::binary_integer>(arraytest::personlist { }, pool);
+
+    // Index not matching input fails
+    rohit::FullStreamAutoAlloc fullstream { 64 };
+    rohit::serializer::ListIndex index { 100 };
+    personlist.SerializeOutIndexedList<rohit::serializer::binary_integer>(fullstream, index);
+    const std::string encoded { reinterpret_cast<const char *>(fullstream.begin()), fullstream.CurrentOffset() };
+    arraytest::personlist decoded { };
+    auto shifted = index;
+    ++shifted.offsets[3];
+    EXPECT_THROW(decoded.SerializeInParallelList<rohit::serializer::binary_integer>(rohit::MakeConstantFullStream(encoded), shifted, pool), rohit::serializer::exception::BadInputData);
+    auto other = index;
+    other.interval = 50;
+    EXPECT_THROW(decoded.SerializeInParallelList<rohit::serializer::binary_integer>(rohit::MakeConstantFullStream(encoded), other, pool), rohit::serializer::exception::BadInputData);
+}
+
+// Generated classes have no equality, records are compared by their json
+std::string EncodePersons(const std::vector<arraytest::person> &persons) {
+    std::string encoded { };
+    for(auto &person: persons) encoded += EncodeString<rohit::serializer::json>(person) + "\n";
+    return encoded;
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestRecordStream(const std::vector<arraytest::person> &persons, const rohit::serializer::RecordFormat format, rohit::ThreadPool &pool) {
+    rohit::FullStreamAutoAlloc fullstream { 64 };
+    rohit::serializer::RecordWriter<SerializerProtocol> writer { fullstream, format };
+    for(auto &person: persons) writer.Write(person);
+    const auto inStream = rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset());
+    const auto expected = EncodePersons(persons);
+
+    for(const size_t chunkSize: { size_t { 1 }, size_t { 100 }, size_t { 1 << 20 } }) {
+        const rohit::serializer::RecordReader reader { inStream, format, chunkSize };
+        EXPECT_EQ(EncodePersons(reader.Read<arraytest::person, SerializerProtocol>(pool)), expected);
+
+        std::vector<arraytest::person> ordered { };
+        reader.ForEach<arraytest::person, SerializerProtocol>(pool, [&ordered](arraytest::person &&person) {
+            ordered.push_back(std::move(person));
+        }, rohit::serializer::RecordOrder::Input, 3);
+        EXPECT_EQ(EncodePersons(ordered), expected);
+
+        std::mutex mutex { };
+        std::vector<arraytest::person> unordered { };
+        reader.ForEach<arraytest::person, SerializerProtocol>(pool, [&mutex, &unordered](arraytest::person &&person) {
+            std::lock_guard lock { mutex };
+            unordered.push_back(std::move(person));
+        });
+        std::sort(unordered.begin(), unordered.end(), [](const auto &first, const auto &second) { return first.ID < second.ID; });
+        EXPECT_EQ(EncodePersons(unordered), expected);
+    }
+}
+
+TEST(GeneratedTest, RecordStream) {
+    rohit::ThreadPool pool { 4 };
+    std::vector<arraytest::person> persons { };
+    for(uint64_t index { 0 }; index < 1000; ++index) persons.push_back({ "Person " + std::to_string(index), index });
+    TestRecordStream<rohit::serializer::json>(persons, rohit::serializer::RecordFormat::Lines, pool);
+    TestRecordStream<rohit::serializer::binary_integer>(persons, rohit::serializer::RecordFormat::LengthPrefixed, pool);
+    TestRecordStream<rohit::serializer::json>(persons, rohit::serializer::RecordFormat::LengthPrefixed, pool);
+
+    // Blank lines and CRLF are accepted, mapped file is read in place
+    const auto path = std::filesystem::temp_directory_path() / "recordstreamtest.ndjson";
+    {
+        std::ofstream file { path, std::ios::binary };
+        file << R"({"name":"a","ID":1})" "\r\n\n" R"({"name":"b","ID":2})";
+    }
+    {
+        const auto mapped = rohit::MakeMappedStreamFromFile(path);
+        const rohit::serializer::RecordReader reader { mapped, rohit::serializer::RecordFormat::Lines, 4 };
+        EXPECT_EQ(EncodePersons(reader.Read<arraytest::person, rohit::serializer::json>(pool)), EncodePersons({ { "a", 1 }, { "b", 2 } }));
+    }
+    std::filesystem::remove(path);
+
+    // Line must not have newline, size must not be beyond end of buffer
+    rohit::FullStreamAutoAlloc fullstream { 64 };
+    rohit::serializer::RecordWriter<rohit::serializer::json> writer { fullstream, rohit::serializer::RecordFormat::Lines };
+    EXPECT_THROW(writer.Write(arraytest::person { "a\nb", 1 }), rohit::serializer::exception::BadType);
+    const uint8_t truncated[] { 0x05, 0x01 };
+    EXPECT_THROW((rohit::serializer::RecordReader { truncated, truncated + sizeof(truncated), rohit::serializer::RecordFormat::LengthPrefixed }), rohit::serializer::exception::BadInputData);
+}
+
+TEST(GeneratedTest, RecordFile) {
+    using rohit::serializer::recordfile::Flags;
+    std::vector<arraytest::person> persons { };
+    for(uint64_t index { 0 }; index < 300; ++index) persons.push_back({ "Person " + std::to_string(index), index });
+
+    for(const auto flags: { Flags::None, Flags::Checksum, Flags::Keys, Flags::Checksum | Flags::Keys }) {
+        rohit::FullStreamAutoAlloc fullstream { 64 };
+        rohit::serializer::RecordFileWriter<rohit::serializer::binary_integer> writer { fullstream, flags };
+        for(auto &person: persons) {
+            if (rohit::serializer::recordfile::HasFlag(flags, Flags::Keys)) writer.Write(person, "key" + std::to_string(person.ID % 100));
+            else writer.Write(person);
+        }
+        writer.Finish();
+
+        const rohit::serializer::RecordFile file { rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset()) };
+        EXPECT_EQ(file.Count(), persons.size());
+        for(const uint64_t index: { 0U, 1U, 150U, 299U }) {
+            EXPECT_EQ(EncodeString<rohit::serializer::json>(file.Get<arraytest::person, rohit::serializer::binary_integer>(index)),
+                EncodeString<rohit::serializer::json>(persons[index]));
+        }
+        EXPECT_THROW(file.Record(persons.size()), std::out_of_range);
+        if (rohit::serializer::recordfile::HasFlag(flags, Flags::Keys)) {
+            // First record written with key
+            EXPECT_EQ(file.Find("key42"), 42U);
+            EXPECT_EQ(file.Find("key0"), 0U);
+            EXPECT_FALSE(file.Find("key100"));
+            EXPECT_FALSE(file.Find(""));
+        } else EXPECT_FALSE(file.Find("key42"));
+    }
+
+    // File stream writer, mapped reader, corrupted record fails checksum
+    const auto path = std::filesystem::temp_directory_path() / "recordfiletest.rsrf";
+    {
+        std::ofstream stream { path, std::ios::binary };
+        rohit::serializer::RecordFileWriter<rohit::serializer::json> writer { stream, Flags::Checksum };
+        for(auto &person: persons) writer.Write(person);
+        writer.Finish();
+    }
+    {
+        const auto mapped = rohit::MakeMappedStreamFromFile(path);
+        const rohit::serializer::RecordFile file { mapped };
+        EXPECT_EQ((file.Get<arraytest::person, rohit::serializer::json>(7).name), "Person 7");
+
+        std::string corrupted { reinterpret_cast<const char *>(mapped.begin()), mapped.Capacity() };
+        corrupted[20] ^= 1;
+        const rohit::serializer::RecordFile corruptedFile { rohit::MakeConstantFullStream(corrupted) };
+        EXPECT_THROW(corruptedFile.Record(0), rohit::serializer::exception::BadInputData);
+        EXPECT_THROW((rohit::serializer::RecordFile { rohit::MakeConstantFullStream(corrupted.substr(0, corrupted.size() - 1)) }), rohit::serializer::exception::BadInputData);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(GeneratedTest, CompressStream) {
+    arraytest::personlist personlist { 7, true, { }, { { 1, 2 } } };
+    for(uint64_t index { 0 }; index < 20000; ++index) personlist.list.push_back({ "Person " + std::to_string(index % 100), index });
+    const auto encoded = EncodeString<rohit::serializer::binary_integer>(personlist);
+
+    // Blocks are written to sink as encoder writes
+    rohit::FullStreamAutoAlloc sink { 64 };
+    rohit::CompressOutStream compressStream { sink };
+    personlist.SerializeOut<rohit::serializer::binary_integer>(compressStream);
+    EXPECT_GT(sink.CurrentOffset(), 4U);
+    compressStream.Finish();
+    EXPECT_LT(sink.CurrentOffset(), encoded.size() / 2);
+
+    const auto source = rohit::MakeConstantFullStream(sink.begin(), sink.CurrentOffset());
+    rohit::DecompressInStream decompressStream { source };
+    EXPECT_TRUE(decompressStream.ReadBlock());
+    EXPECT_GT(decompressStream.Capacity(), 0U);
+    EXPECT_LE(decompressStream.Capacity(), rohit::lz::block_size);
+    decompressStream.ReadAll();
+    EXPECT_TRUE(decompressStream.Ended());
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char *>(decompressStream.begin()), decompressStream.Capacity()), encoded);
+    arraytest::personlist decoded { };
+    decoded.SerializeIn<rohit::serializer::binary_integer>(decompressStream);
+    EXPECT_EQ(EncodeString<rohit::serializer::binary_integer>(decoded), encoded);
+
+    // File stream, string longer than a block
+    const arraytest::person longPerson { std::string(200000, 'n'), 3 };
+    std::stringstream file { };
+    {
+        rohit::CompressOutStream fileStream { file };
+        longPerson.SerializeOut<rohit::serializer::json>(fileStream);
+        fileStream.Finish();
+    }
+    rohit::DecompressInStream fileInStream { file };
+    fileInStream.ReadAll();
+    arraytest::person decodedPerson { };
+    decodedPerson.SerializeIn<rohit::serializer::json>(fileInStream);
+    EXPECT_EQ(decodedPerson.name, longPerson.name);
+
+    // Stream without Finish is finished by destructor
+    std::stringstream unfinished { };
+    {
+        rohit::CompressOutStream unfinishedStream { unfinished };
+        longPerson.SerializeOut<rohit::serializer::json>(unfinishedStream);
+    }
+    rohit::DecompressInStream unfinishedInStream { unfinished };
+    unfinishedInStream.ReadAll();
+    EXPECT_TRUE(unfinishedInStream.Ended());
+    arraytest::person unfinishedPerson { };
+    unfinishedPerson.SerializeIn<rohit::serializer::json>(unfinishedInStream);
+    EXPECT_EQ(unfinishedPerson.name, longPerson.name);
+
+    // Truncated stream
+    const auto truncated = rohit::MakeConstantFullStream(sink.begin(), sink.CurrentOffset() - 1);
+    rohit::DecompressInStream truncatedStream { truncated };
+    EXPECT_THROW(truncatedStream.ReadAll(), rohit::serializer::exception::BadInputData);
+}
+
+TEST(GeneratedTest, Equality) {
+    arraytest::personlist personlist { 7, true, { { "Rohit", 1 }, { "Singh", 2 } }, { { 1, 2 } } };
+    auto other = personlist;
+    EXPECT_TRUE(personlist == other);
+    other.list[1].ID = 3;
+    EXPECT_TRUE(personlist != other);
+
+    test::cacheserver cacheserver { 10, 10, 10, 10, 2010, 10240 };
+    test::server1 server { test::server1::e_entry::cache, { .cache = cacheserver }, test::test112::em2 };
+    auto otherServer = server;
+    EXPECT_TRUE(server == otherServer);
+    otherServer.entry.cache.name.d = 11;
+    EXPECT_TRUE(server != otherServer);
+    otherServer.entry_type = test::server1::e_entry::http;
+    EXPECT_TRUE(server != otherServer);
+
+    bitstest::flags flags { "packed", true, bitstest::mode::turbo, 1024, true, 9 };
+    auto otherFlags = flags;
+    EXPECT_TRUE(flags == otherFlags);
+    otherFlags.count = 8;
+    EXPECT_TRUE(flags != otherFlags);
+
+    // Object equal to default object is still written in bitmap, as its own bitmap
+    rohit::FullStreamAutoAlloc fullstream { 64 };
+    arraytest::session session { };
+    session.SerializeOut<rohit::serializer::binary_bitmap>(fullstream);
+    EXPECT_EQ(fullstream.CurrentOffset(), 2U);
+}
+
+TEST(GeneratedTest, Delta) {
+    arraytest::session session { "Session", 1, { 7, true, { }, { { 1, 2 } } } };
+    for(uint64_t index { 0 }; index < 100; ++index) session.persons.list.push_back({ "Person " + std::to_string(index), index });
+    rohit::serializer::DeltaWriter<arraytest::session> writer { };
+    rohit::serializer::DeltaReader<arraytest::session> reader { };
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+
+    // First record is delta from default object
+    writer.Write(fullstream, session);
+    const auto firstSize = fullstream.CurrentOffset();
+    EXPECT_GT(firstSize, 1000U);
+    EXPECT_TRUE(reader.Read(rohit::MakeConstantFullStream(fullstream.begin(), firstSize)) == session);
+
+    // Unchanged object is only bitmap
+    fullstream.Reset();
+    writer.Write(fullstream, session);
+    EXPECT_EQ(fullstream.CurrentOffset(), 1U);
+    EXPECT_TRUE(reader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == session);
+
+    session.id = 2;
+    fullstream.Reset();
+    writer.Write(fullstream, session);
+    EXPECT_EQ(fullstream.CurrentOffset(), 1 + sizeof(uint64_t));
+    EXPECT_TRUE(reader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == session);
+
+    // Changed nested object and shorter list replace old ones
+    session.persons.list.resize(10);
+    session.persons.reverseListMap.clear();
+    fullstream.Reset();
+    writer.Write(fullstream, session);
+    EXPECT_LT(fullstream.CurrentOffset(), firstSize);
+    EXPECT_TRUE(reader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == session);
+
+    // Member changed back to default is written
+    session.name.clear();
+    fullstream.Reset();
+    writer.Write(fullstream, session);
+    EXPECT_TRUE(reader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == session);
+
+    // Parent, union and packed members
+    rohit::serializer::DeltaWriter<test::server1> serverWriter { };
+    rohit::serializer::DeltaReader<test::server1> serverReader { };
+    test::server1 server { test::server1::e_entry::cache, { .cache = { 10, 10, 10, 10, 2010, 10240 } }, test::test112::em2 };
+    fullstream.Reset();
+    serverWriter.Write(fullstream, server);
+    EXPECT_TRUE(serverReader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == server);
+    server.entry.cache.size = 1;
+    fullstream.Reset();
+    serverWriter.Write(fullstream, server);
+    EXPECT_TRUE(serverReader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == server);
+
+    rohit::serializer::DeltaWriter<bitstest::flags> flagsWriter { };
+    rohit::serializer::DeltaReader<bitstest::flags> flagsReader { };
+    bitstest::flags flags { "packed", true, bitstest::mode::turbo, 1024, true, 9 };
+    fullstream.Reset();
+    flagsWriter.Write(fullstream, flags);
+    flagsReader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset()));
+    flags.count = 3;
+    fullstream.Reset();
+    flagsWriter.Write(fullstream, flags);
+    EXPECT_TRUE(flagsReader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == flags);
+
+    // Reset starts again from default object on both sides
+    writer.Reset();
+    reader.Reset();
+    fullstream.Reset();
+    writer.Write(fullstream, session);
+    EXPECT_TRUE(reader.Read(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset())) == session);
+}
+
+// Applies patch from from to to on copy of from, returns size of patch
+template <template<rohit::serializer::SerializeType> class SerializerProtocol, typename T>
+size_t TestPatch(const T &from, const T &to) {
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    T::template Diff<SerializerProtocol>(fullstream, from, to);
+    const auto size = fullstream.CurrentOffset();
+    T patched { from };
+    patched.template ApplyPatch<SerializerProtocol>(rohit::MakeConstantFullStream(fullstream.begin(), size));
+    EXPECT_TRUE(patched == to);
+    return size;
+}
+
+template <template<rohit::serializer::SerializeType> class SerializerProtocol>
+void TestPatchProtocol() {
+    arraytest::sessionstore from { "Store", { } };
+    for(uint64_t index { 0 }; index < 10; ++index) {
+        auto &session = from.sessionlist.emplace_back(arraytest::session { "Session " + std::to_string(index), index, { } });
+        for(uint64_t person { 0 }; person < 20; ++person) {
+            session.persons.list.push_back({ "Person " + std::to_string(person), person });
+            session.persons.reverseListMap[static_cast<uint32_t>(person)] = static_cast<uint32_t>(person * 2);
+        }
+    }
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    from.SerializeOut<SerializerProtocol>(fullstream);
+    const auto fullSize = fullstream.CurrentOffset();
+
+    // Equal objects, element edit deep inside list, append, shrink and map insert and erase
+    EXPECT_LT(TestPatch<SerializerProtocol>(from, from), 16U);
+    auto to = from;
+    to.sessionlist[3].persons.list[7].ID = 100;
+    EXPECT_LT(TestPatch<SerializerProtocol>(from, to) * 20, fullSize);
+    to.sessionlist[5].persons.list.push_back({ "Added", 21 });
+    to.sessionlist[6].persons.list.resize(2);
+    to.sessionlist[7].persons.reverseListMap.erase(3);
+    to.sessionlist[7].persons.reverseListMap[100] = 7;
+    to.sessionlist[8].persons.reverseListMap[4] = 9;
+    EXPECT_LT(TestPatch<SerializerProtocol>(from, to) * 4, fullSize);
+    to.sessionlist.push_back(from.sessionlist[0]);
+    to.sessionlist.erase(to.sessionlist.begin());
+    TestPatch<SerializerProtocol>(from, to);
+    TestPatch<SerializerProtocol>(to, arraytest::sessionstore { });
+
+    // Map of objects is patched by key
+    maptest::personlist mapFrom { 1, { { 1, { "One", 1 } }, { 2, { "Two", 2 } } } };
+    auto mapTo = mapFrom;
+    mapTo.list[2].name = "Second";
+    mapTo.list.erase(1);
+    mapTo.list[3] = { "Three", 3 };
+    TestPatch<SerializerProtocol>(mapFrom, mapTo);
+
+    // Parent, union and packed members
+    test::test1::personex personex { };
+    auto personexTo = personex;
+    personexTo.name = "Changed";
+    TestPatch<SerializerProtocol>(personex, personexTo);
+    test::server1 server { test::server1::e_entry::cache, { .cache = { 10, 10, 10, 10, 2010, 10240 } }, test::test112::em2 };
+    auto serverTo = server;
+    serverTo.entry.cache.size = 1;
+    TestPatch<SerializerProtocol>(server, serverTo);
+    bitstest::flags flags { "packed", true, bitstest::mode::turbo, 1024, true, 9 };
+    auto flagsTo = flags;
+    flagsTo.speed = bitstest::mode::off;
+    flagsTo.level = 3;
+    TestPatch<SerializerProtocol>(flags, flagsTo);
+}
+
+TEST(GeneratedTest, Patch) {
+    TestPatchProtocol<rohit::serializer::json>();
+    TestPatchProtocol<rohit::serializer::binary_integer>();
+    TestPatchProtocol<rohit::serializer::binary_string>();
+    TestPatchProtocol<rohit::serializer::binary_bitmap>();
+    TestPatchProtocol<rohit::serializer::msgpack>();
+
+    // Patch for other object fails on bad list index
+    arraytest::personlist from { 1, true, { { "One", 1 }, { "Two", 2 } }, { } };
+    auto to = from;
+    to.list[1].ID = 3;
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    arraytest::personlist::Diff<rohit::serializer::binary_integer>(fullstream, from, to);
+    arraytest::personlist other { };
+    const auto status = other.TryApplyPatch<rohit::serializer::binary_integer>(rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset()));
+    EXPECT_FALSE(status);
+    EXPECT_TRUE(status.error() == rohit::serializer::ErrorKind::BadValue);
+}
+
+TEST(GeneratedTest, Msgpack) {
+    // Object is map keyed by member name, integer is written in smallest format
+    test::test1::person person { "Rohit", 322 };
+    const std::string encoded { EncodeString<rohit::serializer::msgpack>(person) };
+    const std::string expected { "\x82\xa8" "fullname" "\xa5" "Rohit" "\xa2" "ID" "\xcd\x01\x42" };
+    EXPECT_EQ(encoded, expected);
+
+    // Enum member is written as its name
+    enumtest::test enumTest { enumtest::testenum::test3 };
+    EXPECT_EQ(EncodeString<rohit::serializer::msgpack>(enumTest), std::string { "\x81\xa2" "te" "\xa5" "test3" });
+
+    test::values values { 'a', 3.14f, 3.884563, true };
+    test::values valuesDecoded { };
+    valuesDecoded.SerializeIn<rohit::serializer::msgpack>(rohit::MakeConstantFullStream(EncodeString<rohit::serializer::msgpack>(values)));
+    EXPECT_EQ(valuesDecoded.ch, 'a');
+    EXPECT_EQ(valuesDecoded.pi, 3.14f);
+    EXPECT_EQ(valuesDecoded.t1, 3.884563);
+    EXPECT_TRUE(valuesDecoded.t2);
+
+    ForEachSample([](const auto &obj) {
+        std::remove_cvref_t<decltype(obj)> decoded { };
+        decoded.template SerializeIn<rohit::serializer::msgpack>(rohit::MakeConstantFullStream(EncodeString<rohit::serializer::msgpack>(obj)));
+        EXPECT_TRUE(decoded == obj);
+        EXPECT_LT(EncodeString<rohit::serializer::msgpack>(obj).size(), EncodeString<rohit::serializer::json>(obj).size());
+    });
+
+    // Integer formats, each value is read back from its width
+    const std::vector<int64_t> integers { 0, 127, 128, 255, 256, 65535, 65536, 4294967296, -1, -32, -33, -128, -129, -32768, -32769, -2147483649 };
+    rohit::FullStreamAutoAlloc fullstream { 256 };
+    rohit::serializer::msgpack<rohit::serializer::SerializeType::Out> { fullstream }.SerializeOut(integers);
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char *>(fullstream.begin()), 7), std::string_view("\xdc\x00\x10\x00\x7f\xcc\x80", 7));
+    std::vector<int64_t> integersDecoded { };
+    rohit::serializer::msgpack<rohit::serializer::SerializeType::In> { rohit::MakeConstantFullStream(fullstream.begin(), fullstream.CurrentOffset()) }.SerializeIn(integersDecoded);
+    EXPECT_TRUE(integersDecoded == integers);
+
+    // Value not fitting in member type is rejected
+    const uint8_t large[] { 0xcd, 0x01, 0x00 };
+    rohit::serializer::MsgpackIn<rohit::serializer::DecodeMode::NoThrow> largeIn { rohit::MakeConstantFullStream(std::begin(large), std::end(large)) };
+    uint8_t small { };
+    largeIn.SerializeIn(small);
+    EXPECT_TRUE(largeIn.GetStatus().error() == rohit::serializer::ErrorKind::BadValue);
+
+    // Nil member is absent, default is kept
+    const std::string nilName { "\x82\xa8" "fullname" "\xc0\xa2" "ID" "\x05" };
+    test::test1::person personNil { };
+    EXPECT_TRUE(personNil.TrySerializeIn<rohit::serializer::msgpack>(rohit::MakeConstantFullStream(nilName)));
+    EXPECT_EQ(personNil.name, "None");
+    EXPECT_EQ(personNil.ID, 5U);
+
+    // Header of unsized range is widened to array16 and array32, output is same as of sized list
+    for(const auto &[count, type]: { std::make_pair(15U, '\x9f'), std::make_pair(16U, '\xdc'), std::make_pair(65535U, '\xdc'), std::make_pair(65536U, '\xdd') }) {
+        arraytest::personlist personlist { 7, true, { }, { { 1, 2 } } };
+        for(uint64_t index { 0 }; index < count; ++index) personlist.list.push_back({ "P", index });
+        const auto sized = EncodeString<rohit::serializer::msgpack>(personlist);
+        arraytest::personlist header { personlist.listid, personlist.check, { }, personlist.reverseListMap };
+        rohit::FullStreamAutoAlloc widened { 16 };
+        header.SerializeOutWithList<rohit::serializer::msgpack>(widened, personlist.list | std::views::filter([](const arraytest::person &) { return true; }));
+        const std::string unsized { reinterpret_cast<const char *>(widened.begin()), widened.CurrentOffset() };
+        EXPECT_EQ(unsized, sized);
+        const auto listOffset = unsized.find("\xa4list");
+        ASSERT_NE(listOffset, std::string::npos);
+        EXPECT_EQ(unsized[listOffset + 5], type);
+        arraytest::personlist decoded { };
+        decoded.SerializeIn<rohit::serializer::msgpack>(rohit::MakeConstantFullStream(unsized));
+        EXPECT_EQ(decoded.list.size(), count);
+        EXPECT_EQ(decoded.list.back().ID, count - 1);
+    }
+}
+
+TEST(GeneratedTest, ThreadPool) {
+    rohit::ThreadPool pool { 3 };
+    std::vector<std::atomic<uint32_t>> calls(1000);
+    pool.ParallelFor(calls.size(), [&calls](const size_t index) { ++calls[index]; });
+    EXPECT_TRUE(std::all_of(calls.begin(), calls.end(), [](const auto &count) { return count == 1; }));
+
+    // First exception is rethrown after all tasks are done, pool is usable afterwards
+    std::atomic<size_t> completed { 0 };
+    EXPECT_THROW(pool.ParallelFor(100, [&completed](const size_t index) {
+        ++completed;
+        if (index == 50) throw std::runtime_error { "task failed" };
+    }), std::runtime_error);
+    EXPECT_EQ(completed, 100U);
+    pool.ParallelFor(10, [&completed](const size_t) { ++completed; });
+    EXPECT_EQ(completed, 110U);
+}
@@ -135,6 +135,53 @@ TEST(SerializeParser, Member) {
     }
 }
 
+TEST(SerializeParser, BitsMember) {
+    // tuple list are: source, Member, is negative test
+    std::vector<std::tuple<std::string, rohit::serializer::Member, bool>> test_list {
+        {"public bits(4) uint8 level;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"uint8", nullptr} }, "level", "level", 1, {}, {}, 4}, false},
+        {"public bits ( 12 ) uint16\toffset;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"uint16", nullptr} }, "offset", "offset", 2, {}, {}, 12}, false},
+        {"public bits(0) uint8 level;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"uint8", nullptr} }, "level", "level", 3, {}, {}, 0}, true},
+        {"public bits(65) uint64 level;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"uint64", nullptr} }, "level", "level", 4, {}, {}, 0}, true},
+        {"public bits uint8 level;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"uint8", nullptr} }, "level", "level", 5, {}, {}, 0}, true},
+        {"public bits(2) array uint8 level;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::array, { {"uint8", nullptr} }, "level", "level", 6, {}, {}, 0}, true},
+    };
+
+    for(auto &test: test_list) {
+        auto &[input, output, negativetest ] = test;
+        rohit::FullStream inStream { input.data(), input.size() };
+        if (!negativetest) {
+            auto parsedmember = rohit::serializer::Parser::ParseMember(inStream, output.id, nullptr);
+            EXPECT_EQ(parsedmember, output);
+        } else {
+            EXPECT_THROW(rohit::serializer::Parser::ParseMember(inStream, output.id, nullptr), rohit::serializer::exception::BadMemberSpec);
+        }
+    }
+}
+
+TEST(SerializeParser, CapacityMember) {
+    // tuple list are: source, Member, is negative test
+    std::vector<std::tuple<std::string, rohit::serializer::Member, bool>> test_list {
+        {"public string[2] country;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"string", nullptr} }, "country", "country", 1, {}, {}, 0, 2}, false},
+        {"public array[ 16 ] uint8 ipv6;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::array, { {"uint8", nullptr} }, "ipv6", "ipv6", 2, {}, {}, 0, 16}, false},
+        {"public array [4] string tags;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::array, { {"string", nullptr} }, "tags", "tags", 3, {}, {}, 0, 4}, false},
+        {"public string[0] country;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"string", nullptr} }, "country", "country", 4, {}, {}, 0, 0}, true},
+        {"public array[65536] uint8 data;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::array, { {"uint8", nullptr} }, "data", "data", 5, {}, {}, 0, 0}, true},
+        {"public array[4] string[2] codes;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::array, { {"string", nullptr} }, "codes", "codes", 6, {}, {}, 0, 0}, true},
+        {"public string[x] country;", {rohit::serializer::AccessType::Public, rohit::serializer::Member::none, { {"string", nullptr} }, "country", "country", 7, {}, {}, 0, 0}, true},
+    };
+
+    for(auto &test: test_list) {
+        auto &[input, output, negativetest ] = test;
+        rohit::FullStream inStream { input.data(), input.size() };
+        if (!negativetest) {
+            auto parsedmember = rohit::serializer::Parser::ParseMember(inStream, output.id, nullptr);
+            EXPECT_EQ(parsedmember, output);
+        } else {
+            EXPECT_THROW(rohit::serializer::Parser::ParseMember(inStream, output.id, nullptr), rohit::serializer::exception::BadMemberSpec);
+        }
+    }
+}
+
 TEST(SerializeParser, ClassBody) {
     std::string input {
         "{\n"